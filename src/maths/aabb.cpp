@@ -0,0 +1,241 @@
+#include "maths/aabb.h"
+
+namespace mkr {
+    aabb::aabb(const vector3& _min, const vector3& _max)
+            : min_(_min), max_(_max) {}
+
+    aabb aabb::from_points(std::span<const vector3> _points) {
+        aabb result = empty();
+        for (const auto& point: _points) {
+            result.expand(point);
+        }
+        return result;
+    }
+
+    bool aabb::is_empty() const {
+        return min_.x_ > max_.x_ || min_.y_ > max_.y_ || min_.z_ > max_.z_;
+    }
+
+    vector3 aabb::centre() const {
+        return (min_ + max_) * 0.5f;
+    }
+
+    vector3 aabb::extents() const {
+        return (max_ - min_) * 0.5f;
+    }
+
+    float aabb::surface_area() const {
+        const float x = max_.x_ - min_.x_, y = max_.y_ - min_.y_, z = max_.z_ - min_.z_;
+        return 2.0f * (x * y + y * z + z * x);
+    }
+
+    void aabb::expand(const vector3& _point) {
+        min_.x_ = maths_util::min(min_.x_, _point.x_);
+        min_.y_ = maths_util::min(min_.y_, _point.y_);
+        min_.z_ = maths_util::min(min_.z_, _point.z_);
+        max_.x_ = maths_util::max(max_.x_, _point.x_);
+        max_.y_ = maths_util::max(max_.y_, _point.y_);
+        max_.z_ = maths_util::max(max_.z_, _point.z_);
+    }
+
+    void aabb::expand(const aabb& _box) {
+        min_.x_ = maths_util::min(min_.x_, _box.min_.x_);
+        min_.y_ = maths_util::min(min_.y_, _box.min_.y_);
+        min_.z_ = maths_util::min(min_.z_, _box.min_.z_);
+        max_.x_ = maths_util::max(max_.x_, _box.max_.x_);
+        max_.y_ = maths_util::max(max_.y_, _box.max_.y_);
+        max_.z_ = maths_util::max(max_.z_, _box.max_.z_);
+    }
+
+    aabb aabb::merged(const aabb& _box) const {
+        aabb result = *this;
+        result.expand(_box);
+        return result;
+    }
+
+    vector3 aabb::support(const vector3& _direction) const {
+        return vector3{_direction.x_ >= 0.0f ? max_.x_ : min_.x_,
+                       _direction.y_ >= 0.0f ? max_.y_ : min_.y_,
+                       _direction.z_ >= 0.0f ? max_.z_ : min_.z_};
+    }
+
+    bool aabb::contains(const vector3& _point) const {
+        return _point.x_ >= min_.x_ && _point.x_ <= max_.x_ &&
+               _point.y_ >= min_.y_ && _point.y_ <= max_.y_ &&
+               _point.z_ >= min_.z_ && _point.z_ <= max_.z_;
+    }
+
+    bool aabb::overlaps(const aabb& _box) const {
+        return min_.x_ <= _box.max_.x_ && max_.x_ >= _box.min_.x_ &&
+               min_.y_ <= _box.max_.y_ && max_.y_ >= _box.min_.y_ &&
+               min_.z_ <= _box.max_.z_ && max_.z_ >= _box.min_.z_;
+    }
+
+    void aabb::overlaps(std::span<const aabb> _boxes, std::span<std::uint64_t> _result) const {
+        // Test the boxes 8 at a time, one packet per byte of the bitmask.
+        for (size_t word = 0; word < _result.size(); ++word) {
+            _result[word] = 0;
+        }
+        for (size_t first = 0; first < _boxes.size(); first += 8) {
+            const aabb_packet<8> packet{_boxes.subspan(first, maths_util::min<size_t>(8, _boxes.size() - first))};
+            _result[first / 64] |= static_cast<std::uint64_t>(packet.overlaps(*this)) << (first % 64);
+        }
+    }
+
+    bool aabb::is_behind(const plane& _plane) const {
+        // The corner furthest along the normal is the last part of the box to go behind the plane.
+        const vector3 corner{_plane.normal_.x_ >= 0.0f ? max_.x_ : min_.x_,
+                             _plane.normal_.y_ >= 0.0f ? max_.y_ : min_.y_,
+                             _plane.normal_.z_ >= 0.0f ? max_.z_ : min_.z_};
+        return _plane.normal_.dot(corner) + _plane.d_ < 0.0f;
+    }
+
+    aabb aabb::transformed(const matrix4x4& _matrix) const {
+        aabb result;
+        transform(std::span<const aabb>{this, 1}, _matrix, std::span<aabb>{&result, 1});
+        return result;
+    }
+
+    void aabb::transform(std::span<const aabb> _boxes, const matrix4x4& _matrix, std::span<aabb> _result) {
+        /**
+         * Arvo's method.
+         * [Graphics Gems, "Transforming Axis-Aligned Bounding Boxes", James Arvo 1990]
+         *
+         * Let the box have the centre C and the extents E, and the matrix be the linear part M and the translation T.
+         * A point of the box is C + D, where |D_i| <= E_i on each axis i.
+         *
+         * The transformed point is M(C + D) + T = (MC + T) + MD.
+         * So the centre of the transformed box is MC + T.
+         *
+         * On row r, (MD)_r = Σ M_rc * D_c, which is largest when every D_c has the same sign as M_rc and |D_c| = E_c.
+         * So the extent of the transformed box on row r is Σ |M_rc| * E_c.
+         *
+         * This is 18 multiplies per box, instead of 8 corner transforms with 16 multiplies and a perspective divide each.
+         */
+        const float* m = _matrix[0];
+        // m[c * 4 + r] is the element in column c and row r.
+        const float m00 = m[0], m10 = m[1], m20 = m[2];
+        const float m01 = m[4], m11 = m[5], m21 = m[6];
+        const float m02 = m[8], m12 = m[9], m22 = m[10];
+        const float t0 = m[12], t1 = m[13], t2 = m[14];
+        const float a00 = std::fabs(m00), a10 = std::fabs(m10), a20 = std::fabs(m20);
+        const float a01 = std::fabs(m01), a11 = std::fabs(m11), a21 = std::fabs(m21);
+        const float a02 = std::fabs(m02), a12 = std::fabs(m12), a22 = std::fabs(m22);
+
+        for (size_t i = 0; i < _boxes.size(); ++i) {
+            const aabb& box = _boxes[i];
+            const float cx = (box.min_.x_ + box.max_.x_) * 0.5f, ex = (box.max_.x_ - box.min_.x_) * 0.5f;
+            const float cy = (box.min_.y_ + box.max_.y_) * 0.5f, ey = (box.max_.y_ - box.min_.y_) * 0.5f;
+            const float cz = (box.min_.z_ + box.max_.z_) * 0.5f, ez = (box.max_.z_ - box.min_.z_) * 0.5f;
+
+            const float centre_x = m00 * cx + m01 * cy + m02 * cz + t0;
+            const float centre_y = m10 * cx + m11 * cy + m12 * cz + t1;
+            const float centre_z = m20 * cx + m21 * cy + m22 * cz + t2;
+            const float extent_x = a00 * ex + a01 * ey + a02 * ez;
+            const float extent_y = a10 * ex + a11 * ey + a12 * ez;
+            const float extent_z = a20 * ex + a21 * ey + a22 * ez;
+
+            aabb& result = _result[i];
+            result.min_.x_ = centre_x - extent_x, result.max_.x_ = centre_x + extent_x;
+            result.min_.y_ = centre_y - extent_y, result.max_.y_ = centre_y + extent_y;
+            result.min_.z_ = centre_z - extent_z, result.max_.z_ = centre_z + extent_z;
+        }
+    }
+
+    std::optional<std::pair<float, float>> aabb::intersect(const line& _line) const {
+        /**
+         * Slab test.
+         * The box is the intersection of 3 slabs, one per axis, each between 2 parallel planes.
+         * On each axis, the line p + λd crosses the planes of the slab at λ = (min - p) / d and λ = (max - p) / d.
+         * The line is inside the box where it is inside all 3 slabs, between the largest entry and the smallest exit.
+         *
+         * If d is 0 on an axis, the line is parallel to the slab, so it is either always or never inside that slab.
+         */
+        float entry = std::numeric_limits<float>::lowest();
+        float exit = std::numeric_limits<float>::max();
+        const float points[3] = {_line.point_.x_, _line.point_.y_, _line.point_.z_};
+        const float directions[3] = {_line.direction_.x_, _line.direction_.y_, _line.direction_.z_};
+        const float mins[3] = {min_.x_, min_.y_, min_.z_};
+        const float maxs[3] = {max_.x_, max_.y_, max_.z_};
+        for (size_t axis = 0; axis < 3; ++axis) {
+            if (directions[axis] == 0.0f) {
+                if (points[axis] < mins[axis] || points[axis] > maxs[axis]) { return std::nullopt; }
+                continue;
+            }
+            const float inv_direction = 1.0f / directions[axis];
+            const float near = (mins[axis] - points[axis]) * inv_direction;
+            const float far = (maxs[axis] - points[axis]) * inv_direction;
+            entry = maths_util::max(entry, maths_util::min(near, far));
+            exit = maths_util::min(exit, maths_util::max(near, far));
+        }
+
+        if (entry > exit) {
+            return std::nullopt;
+        }
+        return std::make_pair(entry, exit);
+    }
+
+    template<size_t N>
+    aabb_packet<N>::aabb_packet() {
+        min_x_.fill(std::numeric_limits<float>::max());
+        min_y_.fill(std::numeric_limits<float>::max());
+        min_z_.fill(std::numeric_limits<float>::max());
+        max_x_.fill(std::numeric_limits<float>::lowest());
+        max_y_.fill(std::numeric_limits<float>::lowest());
+        max_z_.fill(std::numeric_limits<float>::lowest());
+    }
+
+    template<size_t N>
+    aabb_packet<N>::aabb_packet(std::span<const aabb> _boxes)
+            : aabb_packet() {
+        for (size_t i = 0; i < _boxes.size(); ++i) {
+            set(i, _boxes[i]);
+        }
+    }
+
+    template<size_t N>
+    void aabb_packet<N>::set(size_t _index, const aabb& _box) {
+        min_x_[_index] = _box.min_.x_;
+        min_y_[_index] = _box.min_.y_;
+        min_z_[_index] = _box.min_.z_;
+        max_x_[_index] = _box.max_.x_;
+        max_y_[_index] = _box.max_.y_;
+        max_z_[_index] = _box.max_.z_;
+    }
+
+    template<size_t N>
+    std::uint32_t aabb_packet<N>::overlaps(const aabb& _box) const {
+        // Branch free, so that the loop can be vectorised.
+        std::array<std::uint32_t, N> overlap{};
+        for (size_t i = 0; i < N; ++i) {
+            overlap[i] = static_cast<std::uint32_t>(min_x_[i] <= _box.max_.x_) & static_cast<std::uint32_t>(max_x_[i] >= _box.min_.x_) &
+                         static_cast<std::uint32_t>(min_y_[i] <= _box.max_.y_) & static_cast<std::uint32_t>(max_y_[i] >= _box.min_.y_) &
+                         static_cast<std::uint32_t>(min_z_[i] <= _box.max_.z_) & static_cast<std::uint32_t>(max_z_[i] >= _box.min_.z_);
+        }
+
+        std::uint32_t mask = 0;
+        for (size_t i = 0; i < N; ++i) {
+            mask |= overlap[i] << i;
+        }
+        return mask;
+    }
+
+    template<size_t N>
+    std::uint32_t aabb_packet<N>::contains(const vector3& _point) const {
+        std::array<std::uint32_t, N> inside{};
+        for (size_t i = 0; i < N; ++i) {
+            inside[i] = static_cast<std::uint32_t>(min_x_[i] <= _point.x_) & static_cast<std::uint32_t>(max_x_[i] >= _point.x_) &
+                        static_cast<std::uint32_t>(min_y_[i] <= _point.y_) & static_cast<std::uint32_t>(max_y_[i] >= _point.y_) &
+                        static_cast<std::uint32_t>(min_z_[i] <= _point.z_) & static_cast<std::uint32_t>(max_z_[i] >= _point.z_);
+        }
+
+        std::uint32_t mask = 0;
+        for (size_t i = 0; i < N; ++i) {
+            mask |= inside[i] << i;
+        }
+        return mask;
+    }
+
+    template class aabb_packet<4>;
+    template class aabb_packet<8>;
+}
\ No newline at end of file
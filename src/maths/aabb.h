@@ -0,0 +1,208 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+#include "maths/line.h"
+#include "maths/matrix.h"
+#include "maths/plane.h"
+
+namespace mkr {
+    /**
+     * An axis aligned bounding box.
+     */
+    class aabb {
+    public:
+        /**
+         * Returns an empty box, which contains nothing. Expanding an empty box by a point gives a box around that point.
+         * @return An empty box.
+         */
+        static aabb empty() {
+            constexpr float max = std::numeric_limits<float>::max();
+            return aabb{vector3{max, max, max}, vector3{-max, -max, -max}};
+        }
+
+        /// The corner with the smallest x, y and z.
+        vector3 min_;
+        /// The corner with the largest x, y and z.
+        vector3 max_;
+
+        /**
+         * Constructs the box.
+         * @param _min The corner with the smallest x, y and z.
+         * @param _max The corner with the largest x, y and z.
+         */
+        aabb(const vector3& _min = vector3::zero(), const vector3& _max = vector3::zero());
+
+        /**
+         * Returns the smallest box containing all the points.
+         * @param _points The points.
+         * @return The smallest box containing all the points. Returns an empty box if there are no points.
+         */
+        [[nodiscard]] static aabb from_points(std::span<const vector3> _points);
+
+        /**
+         * Checks if the box is empty.
+         * @return Returns true if min_ is greater than max_ on any axis, else returns false.
+         */
+        [[nodiscard]] bool is_empty() const;
+
+        /**
+         * Returns the centre of the box.
+         * @return The centre of the box.
+         */
+        [[nodiscard]] vector3 centre() const;
+
+        /**
+         * Returns the half size of the box on each axis.
+         * @return The half size of the box on each axis.
+         */
+        [[nodiscard]] vector3 extents() const;
+
+        /**
+         * Returns the surface area of the box.
+         * @return The surface area of the box.
+         */
+        [[nodiscard]] float surface_area() const;
+
+        /**
+         * Expands the box to contain a point.
+         * @param _point The point.
+         */
+        void expand(const vector3& _point);
+
+        /**
+         * Expands the box to contain another box.
+         * @param _box The other box.
+         */
+        void expand(const aabb& _box);
+
+        /**
+         * Returns the smallest box containing this box and another box.
+         * @param _box The other box.
+         * @return The smallest box containing this box and another box.
+         */
+        [[nodiscard]] aabb merged(const aabb& _box) const;
+
+        /**
+         * Returns the corner of the box furthest along a direction, for use with gjk.
+         * @param _direction The direction.
+         * @return The corner of the box furthest along the direction.
+         */
+        [[nodiscard]] vector3 support(const vector3& _direction) const;
+
+        /**
+         * Checks if a point lies in the box.
+         * @param _point The point.
+         * @return Returns true if the point lies in or on the box, else returns false.
+         */
+        [[nodiscard]] bool contains(const vector3& _point) const;
+
+        /**
+         * Checks if 2 boxes overlap.
+         * @param _box The other box.
+         * @return Returns true if the boxes overlap or touch, else returns false.
+         */
+        [[nodiscard]] bool overlaps(const aabb& _box) const;
+
+        /**
+         * Checks a box against many boxes.
+         * Box i is represented by bit (i % 64) of word (i / 64) of the bitmask.
+         * @param _boxes The boxes to check against.
+         * @param _result The bitmask of the boxes which overlap or touch this box.
+         * @warning _result must have a size of (_boxes.size() + 63) / 64.
+         */
+        void overlaps(std::span<const aabb> _boxes, std::span<std::uint64_t> _result) const;
+
+        /**
+         * Returns the bounds of this box after it has been transformed by an affine matrix, using Arvo's method.
+         * The result is the same as the bounds of the 8 transformed corners, but is found from the centre and extents of
+         * the box, without transforming each corner.
+         * @param _matrix The affine transformation matrix.
+         * @return The bounds of the transformed box.
+         * @warning The bottom row of _matrix must be (0, 0, 0, 1), it must not be a perspective projection.
+         */
+        [[nodiscard]] aabb transformed(const matrix4x4& _matrix) const;
+
+        /**
+         * Transforms many boxes by the same affine matrix, using Arvo's method.
+         * @param _boxes The boxes.
+         * @param _matrix The affine transformation matrix.
+         * @param _result The bounds of each transformed box. It may be the same array as _boxes.
+         * @warning _boxes and _result must be the same size.
+         * @warning The bottom row of _matrix must be (0, 0, 0, 1), it must not be a perspective projection.
+         */
+        static void transform(std::span<const aabb> _boxes, const matrix4x4& _matrix, std::span<aabb> _result);
+
+        /**
+         * Checks if the box is completely behind a plane (on the opposite side to the normal).
+         * @param _plane The plane.
+         * @return Returns true if the box is completely behind the plane, else returns false.
+         */
+        [[nodiscard]] bool is_behind(const plane& _plane) const;
+
+        /**
+         * Returns the range of λ in the line formula p + λd for which the line is inside the box.
+         * @param _line The line.
+         * @return The values of λ at which the line enters and leaves the box.
+         * @attention Returns std::nullopt if the line does not intersect the box.
+         */
+        [[nodiscard]] std::optional<std::pair<float, float>> intersect(const line& _line) const;
+    };
+
+    /**
+     * A packet of N boxes stored as a structure of arrays, so that a box or point can be tested against all of them together.
+     * @warning N must be 4 or 8.
+     */
+    template<size_t N>
+    class aabb_packet {
+    public:
+        /// The number of boxes in a packet.
+        static constexpr size_t width = N;
+
+        std::array<float, N> min_x_;
+        std::array<float, N> min_y_;
+        std::array<float, N> min_z_;
+        std::array<float, N> max_x_;
+        std::array<float, N> max_y_;
+        std::array<float, N> max_z_;
+
+        /**
+         * Constructs a packet of empty boxes, which never overlap anything.
+         */
+        aabb_packet();
+
+        /**
+         * Constructs a packet of boxes. If there are fewer than N boxes, the remaining boxes are empty.
+         * @param _boxes The boxes.
+         * @warning _boxes must not have more than N boxes.
+         */
+        explicit aabb_packet(std::span<const aabb> _boxes);
+
+        /**
+         * Set a box of the packet.
+         * @param _index The index of the box.
+         * @param _box The box.
+         */
+        void set(size_t _index, const aabb& _box);
+
+        /**
+         * Checks a box against every box in the packet.
+         * @param _box The box.
+         * @return A bitmask where bit i is set if box i overlaps or touches _box.
+         */
+        [[nodiscard]] std::uint32_t overlaps(const aabb& _box) const;
+
+        /**
+         * Checks which boxes in the packet contain a point.
+         * @param _point The point.
+         * @return A bitmask where bit i is set if the point lies in or on box i.
+         */
+        [[nodiscard]] std::uint32_t contains(const vector3& _point) const;
+    };
+
+    extern template class aabb_packet<4>;
+    extern template class aabb_packet<8>;
+}
\ No newline at end of file
@@ -0,0 +1,361 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <future>
+#include <thread>
+#include "maths/bvh.h"
+
+namespace mkr {
+    namespace {
+        /// Subtrees with fewer primitives than this are built on the calling thread.
+        constexpr size_t parallel_threshold = 16384;
+        /// The maximum depth of the tree, which bounds the size of the traversal stacks.
+        constexpr size_t max_depth = 64;
+        /// The cost of visiting a node, relative to the cost of intersecting a primitive.
+        constexpr float traversal_cost = 1.0f;
+
+        /**
+         * The bounds used while building the tree. The components are stored in arrays so that they can be indexed by
+         * axis, and every operation is inlined into the binning loops.
+         */
+        struct build_bounds {
+            std::array<float, 3> min_{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+            std::array<float, 3> max_{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+
+            void expand(const std::array<float, 3>& _point) {
+                for (size_t axis = 0; axis < 3; ++axis) {
+                    min_[axis] = maths_util::min(min_[axis], _point[axis]);
+                    max_[axis] = maths_util::max(max_[axis], _point[axis]);
+                }
+            }
+
+            void expand(const build_bounds& _bounds) {
+                for (size_t axis = 0; axis < 3; ++axis) {
+                    min_[axis] = maths_util::min(min_[axis], _bounds.min_[axis]);
+                    max_[axis] = maths_util::max(max_[axis], _bounds.max_[axis]);
+                }
+            }
+
+            [[nodiscard]] float surface_area() const {
+                const float x = max_[0] - min_[0], y = max_[1] - min_[1], z = max_[2] - min_[2];
+                return 2.0f * (x * y + y * z + z * x);
+            }
+
+            [[nodiscard]] aabb to_aabb() const {
+                return aabb{vector3{min_[0], min_[1], min_[2]}, vector3{max_[0], max_[1], max_[2]}};
+            }
+        };
+
+        struct build_context {
+            std::vector<build_bounds> bounds_;
+            std::vector<std::array<float, 3>> centroids_;
+            std::span<std::uint32_t> indices_;
+        };
+
+        inline size_t get_bin(float _centroid, float _centroid_min, float _scale) {
+            return maths_util::min(bvh::num_bins - 1, static_cast<size_t>((_centroid - _centroid_min) * _scale));
+        }
+
+        /**
+         * Creates the node for a range of primitives. If the node should be split, the range is partitioned and the
+         * index of the first primitive of the right child is returned.
+         */
+        std::optional<size_t> make_node(build_context& _context, size_t _begin, size_t _end, size_t _depth, bvh::node& _node) {
+            build_bounds node_bounds, centroid_bounds;
+            for (size_t i = _begin; i < _end; ++i) {
+                node_bounds.expand(_context.bounds_[_context.indices_[i]]);
+                centroid_bounds.expand(_context.centroids_[_context.indices_[i]]);
+            }
+            _node.bounds_ = node_bounds.to_aabb();
+            _node.offset_ = static_cast<std::uint32_t>(_begin);
+            _node.count_ = static_cast<std::uint32_t>(_end - _begin);
+
+            const size_t count = _end - _begin;
+            if (count <= 1 || _depth + 1 >= max_depth) {
+                return std::nullopt;
+            }
+
+            /**
+             * Binned SAH.
+             * The centroids are sorted into bins along each axis, and the cost of splitting between every pair of
+             * neighbouring bins is estimated as
+             * cost = traversal_cost + (area(left) * count(left) + area(right) * count(right)) / area(node)
+             * which is the expected number of primitives a random ray through the node has to be intersected with.
+             */
+            std::array<float, 3> scale{};
+            for (size_t axis = 0; axis < 3; ++axis) {
+                const float extent = centroid_bounds.max_[axis] - centroid_bounds.min_[axis];
+                scale[axis] = (extent > 0.0f) ? static_cast<float>(bvh::num_bins) / extent : 0.0f;
+            }
+
+            // Bin the primitives along all 3 axes in a single pass.
+            std::array<std::array<build_bounds, bvh::num_bins>, 3> bin_bounds{};
+            std::array<std::array<size_t, bvh::num_bins>, 3> bin_counts{};
+            for (size_t i = _begin; i < _end; ++i) {
+                const std::uint32_t index = _context.indices_[i];
+                for (size_t axis = 0; axis < 3; ++axis) {
+                    const size_t bin = get_bin(_context.centroids_[index][axis], centroid_bounds.min_[axis], scale[axis]);
+                    bin_bounds[axis][bin].expand(_context.bounds_[index]);
+                    ++bin_counts[axis][bin];
+                }
+            }
+
+            float best_cost = std::numeric_limits<float>::max();
+            size_t best_axis = 0, best_bin = 0;
+            for (size_t axis = 0; axis < 3; ++axis) {
+                if (scale[axis] == 0.0f) { continue; }
+
+                // Sweep from the right to get the area and count of every right side, then from the left.
+                std::array<float, bvh::num_bins> right_costs{};
+                build_bounds right_bounds;
+                size_t right_count = 0;
+                for (size_t bin = bvh::num_bins - 1; bin > 0; --bin) {
+                    right_bounds.expand(bin_bounds[axis][bin]);
+                    right_count += bin_counts[axis][bin];
+                    right_costs[bin] = right_count ? right_bounds.surface_area() * static_cast<float>(right_count) : 0.0f;
+                }
+
+                build_bounds left_bounds;
+                size_t left_count = 0;
+                for (size_t bin = 0; bin + 1 < bvh::num_bins; ++bin) {
+                    left_bounds.expand(bin_bounds[axis][bin]);
+                    left_count += bin_counts[axis][bin];
+                    if (left_count == 0 || left_count == count) { continue; }
+
+                    const float cost = left_bounds.surface_area() * static_cast<float>(left_count) + right_costs[bin + 1];
+                    if (cost < best_cost) {
+                        best_cost = cost;
+                        best_axis = axis;
+                        best_bin = bin;
+                    }
+                }
+            }
+
+            // All the centroids are at the same point, so split the range in half if there are too many primitives for a leaf.
+            if (best_cost == std::numeric_limits<float>::max()) {
+                return (count > bvh::max_leaf_size) ? std::optional<size_t>{_begin + count / 2} : std::nullopt;
+            }
+
+            const float node_area = node_bounds.surface_area();
+            const float split_cost = traversal_cost + ((node_area > 0.0f) ? best_cost / node_area : 0.0f);
+            if (count <= bvh::max_leaf_size && static_cast<float>(count) <= split_cost) {
+                return std::nullopt;
+            }
+
+            const auto middle = std::partition(_context.indices_.begin() + _begin, _context.indices_.begin() + _end,
+                                               [&](std::uint32_t _index) {
+                                                   return get_bin(_context.centroids_[_index][best_axis], centroid_bounds.min_[best_axis], scale[best_axis]) <= best_bin;
+                                               });
+            return static_cast<size_t>(middle - _context.indices_.begin());
+        }
+
+        void build_serial(build_context& _context, size_t _begin, size_t _end, size_t _depth, std::vector<bvh::node>& _nodes) {
+            const size_t index = _nodes.size();
+            _nodes.emplace_back();
+            const std::optional<size_t> middle = make_node(_context, _begin, _end, _depth, _nodes[index]);
+            if (!middle) { return; }
+
+            _nodes[index].count_ = 0;
+            build_serial(_context, _begin, *middle, _depth + 1, _nodes);
+            _nodes[index].offset_ = static_cast<std::uint32_t>(_nodes.size());
+            build_serial(_context, *middle, _end, _depth + 1, _nodes);
+        }
+
+        /// Appends the nodes of a subtree, moving the right child indices by the position the subtree is appended at.
+        void append_subtree(std::vector<bvh::node>& _nodes, const std::vector<bvh::node>& _subtree) {
+            const auto base = static_cast<std::uint32_t>(_nodes.size());
+            for (bvh::node node: _subtree) {
+                if (!node.is_leaf()) { node.offset_ += base; }
+                _nodes.push_back(node);
+            }
+        }
+
+        /**
+         * Builds the 2 children of large nodes on separate threads, until _parallel_depth levels have been split.
+         * Each subtree is built into its own array, and the arrays are joined in depth first order.
+         */
+        std::vector<bvh::node> build_parallel(build_context& _context, size_t _begin, size_t _end, size_t _depth, size_t _parallel_depth) {
+            std::vector<bvh::node> nodes;
+            if (_end - _begin < parallel_threshold || _parallel_depth == 0) {
+                build_serial(_context, _begin, _end, _depth, nodes);
+                return nodes;
+            }
+
+            bvh::node root;
+            const std::optional<size_t> middle = make_node(_context, _begin, _end, _depth, root);
+            if (!middle) { return {root}; }
+
+            // The 2 children partition disjoint ranges of the indices, so they can be built at the same time.
+            auto left_future = std::async(std::launch::async, build_parallel, std::ref(_context), _begin, *middle, _depth + 1, _parallel_depth - 1);
+            const std::vector<bvh::node> right = build_parallel(_context, *middle, _end, _depth + 1, _parallel_depth - 1);
+            const std::vector<bvh::node> left = left_future.get();
+
+            root.count_ = 0;
+            nodes.reserve(1 + left.size() + right.size());
+            nodes.push_back(root);
+            append_subtree(nodes, left);
+            nodes[0].offset_ = static_cast<std::uint32_t>(nodes.size());
+            append_subtree(nodes, right);
+            return nodes;
+        }
+
+        /// A line prepared for slab tests, with the reciprocal of its direction precalculated.
+        struct ray {
+            vector3 point_;
+            vector3 inv_direction_;
+            /// For each axis, whether the line enters the slab through the max face instead of the min face.
+            bool negative_[3];
+
+            explicit ray(const line& _line)
+                    : point_(_line.point_),
+                      inv_direction_(1.0f / _line.direction_.x_, 1.0f / _line.direction_.y_, 1.0f / _line.direction_.z_),
+                      negative_{inv_direction_.x_ < 0.0f, inv_direction_.y_ < 0.0f, inv_direction_.z_ < 0.0f} {}
+
+            /**
+             * Returns the value of λ at which the ray enters the box, or infinity if it misses the box or enters it after _max_distance.
+             *
+             * If the direction is 0 on an axis, its reciprocal is infinity. If the line lies on a face of that slab, the
+             * face gives 0 * infinity = NaN. The comparisons below are false for NaN, so those faces are ignored and the
+             * line counts as inside the slab.
+             */
+            [[nodiscard]] float entry(const aabb& _box, float _max_distance) const {
+                float entry = 0.0f, exit = _max_distance;
+                const float slabs[3][3] = {{_box.min_.x_, _box.max_.x_, point_.x_},
+                                           {_box.min_.y_, _box.max_.y_, point_.y_},
+                                           {_box.min_.z_, _box.max_.z_, point_.z_}};
+                const float inv_direction[3] = {inv_direction_.x_, inv_direction_.y_, inv_direction_.z_};
+                for (size_t axis = 0; axis < 3; ++axis) {
+                    const float near = (slabs[axis][negative_[axis] ? 1 : 0] - slabs[axis][2]) * inv_direction[axis];
+                    const float far = (slabs[axis][negative_[axis] ? 0 : 1] - slabs[axis][2]) * inv_direction[axis];
+                    entry = (near > entry) ? near : entry;
+                    exit = (far < exit) ? far : exit;
+                }
+                return (entry <= exit) ? entry : std::numeric_limits<float>::infinity();
+            }
+        };
+    }
+
+    bvh::bvh(std::span<const aabb> _bounds) {
+        if (_bounds.empty()) { return; }
+
+        primitive_indices_.resize(_bounds.size());
+        for (size_t i = 0; i < _bounds.size(); ++i) {
+            primitive_indices_[i] = static_cast<std::uint32_t>(i);
+        }
+
+        build_context context{{}, {}, primitive_indices_};
+        context.bounds_.reserve(_bounds.size());
+        context.centroids_.reserve(_bounds.size());
+        for (const auto& bounds: _bounds) {
+            const build_bounds& b = context.bounds_.emplace_back(build_bounds{{bounds.min_.x_, bounds.min_.y_, bounds.min_.z_},
+                                                                              {bounds.max_.x_, bounds.max_.y_, bounds.max_.z_}});
+            context.centroids_.push_back({(b.min_[0] + b.max_[0]) * 0.5f, (b.min_[1] + b.max_[1]) * 0.5f, (b.min_[2] + b.max_[2]) * 0.5f});
+        }
+
+        // Split enough levels in parallel to give every hardware thread a subtree.
+        const size_t parallel_depth = std::bit_width(maths_util::max(1u, std::thread::hardware_concurrency()));
+        nodes_ = build_parallel(context, 0, _bounds.size(), 0, parallel_depth);
+
+        primitive_bounds_.reserve(_bounds.size());
+        for (const std::uint32_t index: primitive_indices_) {
+            primitive_bounds_.push_back(_bounds[index]);
+        }
+    }
+
+    bvh::bvh(std::span<const triangle> _triangles)
+            : bvh([&]() {
+        std::vector<aabb> bounds;
+        bounds.reserve(_triangles.size());
+        for (const auto& t: _triangles) {
+            bounds.push_back(aabb::from_points(std::array<vector3, 3>{t.vertex_a_, t.vertex_b_, t.vertex_c_}));
+        }
+        return bvh{bounds};
+    }()) {}
+
+    void bvh::query(const aabb& _box, std::vector<std::uint32_t>& _result) const {
+        if (nodes_.empty()) { return; }
+
+        std::array<std::uint32_t, max_depth> stack;
+        size_t stack_size = 0;
+        stack[stack_size++] = 0;
+        while (stack_size) {
+            const node& current = nodes_[stack[--stack_size]];
+            if (!current.bounds_.overlaps(_box)) { continue; }
+
+            if (current.is_leaf()) {
+                for (std::uint32_t i = current.offset_; i < current.offset_ + current.count_; ++i) {
+                    if (primitive_bounds_[i].overlaps(_box)) { _result.push_back(primitive_indices_[i]); }
+                }
+            } else {
+                stack[stack_size++] = current.offset_;
+                stack[stack_size++] = static_cast<std::uint32_t>(&current - nodes_.data()) + 1;
+            }
+        }
+    }
+
+    void bvh::query(const line& _line, std::vector<std::uint32_t>& _result) const {
+        if (nodes_.empty()) { return; }
+
+        const ray r{_line};
+        constexpr float max_distance = std::numeric_limits<float>::max();
+        std::array<std::uint32_t, max_depth> stack;
+        size_t stack_size = 0;
+        stack[stack_size++] = 0;
+        while (stack_size) {
+            const node& current = nodes_[stack[--stack_size]];
+            if (r.entry(current.bounds_, max_distance) > max_distance) { continue; }
+
+            if (current.is_leaf()) {
+                for (std::uint32_t i = current.offset_; i < current.offset_ + current.count_; ++i) {
+                    if (r.entry(primitive_bounds_[i], max_distance) <= max_distance) { _result.push_back(primitive_indices_[i]); }
+                }
+            } else {
+                stack[stack_size++] = current.offset_;
+                stack[stack_size++] = static_cast<std::uint32_t>(&current - nodes_.data()) + 1;
+            }
+        }
+    }
+
+    std::optional<bvh_hit> bvh::intersect(const line& _line, std::span<const triangle> _triangles) const {
+        if (nodes_.empty()) { return std::nullopt; }
+
+        const ray r{_line};
+        std::optional<bvh_hit> closest;
+        float closest_distance = std::numeric_limits<float>::max();
+        if (r.entry(nodes_[0].bounds_, closest_distance) > closest_distance) { return std::nullopt; }
+
+        // Each entry is a node whose bounds have already been hit, and the distance at which they were hit.
+        std::array<std::pair<std::uint32_t, float>, max_depth> stack;
+        size_t stack_size = 0;
+        stack[stack_size++] = {0, 0.0f};
+        while (stack_size) {
+            const auto [index, entry] = stack[--stack_size];
+            if (entry > closest_distance) { continue; }
+
+            const node& current = nodes_[index];
+            if (current.is_leaf()) {
+                for (std::uint32_t i = current.offset_; i < current.offset_ + current.count_; ++i) {
+                    const std::uint32_t primitive = primitive_indices_[i];
+                    const std::optional<triangle_hit> hit = _triangles[primitive].intersect(_line);
+                    if (hit && hit->distance_ < closest_distance) {
+                        closest_distance = hit->distance_;
+                        closest = bvh_hit{primitive, *hit};
+                    }
+                }
+                continue;
+            }
+
+            // Push the further child first, so that the closer child is visited first.
+            std::uint32_t near_child = index + 1, far_child = current.offset_;
+            float near_entry = r.entry(nodes_[near_child].bounds_, closest_distance);
+            float far_entry = r.entry(nodes_[far_child].bounds_, closest_distance);
+            if (far_entry < near_entry) {
+                std::swap(near_child, far_child);
+                std::swap(near_entry, far_entry);
+            }
+            if (far_entry <= closest_distance) { stack[stack_size++] = {far_child, far_entry}; }
+            if (near_entry <= closest_distance) { stack[stack_size++] = {near_child, near_entry}; }
+        }
+        return closest;
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "maths/aabb.h"
+#include "maths/triangle.h"
+
+namespace mkr {
+    /**
+     * The closest intersection of a line with the triangles of a bvh.
+     */
+    struct bvh_hit {
+        /// The index of the triangle that was hit.
+        std::uint32_t primitive_;
+        /// The intersection with the triangle.
+        triangle_hit hit_;
+    };
+
+    /**
+     * A bounding volume hierarchy over a set of primitives (such as triangles or boxes), for ray and overlap queries.
+     *
+     * The tree is built top down with the surface area heuristic (SAH), choosing each split from a fixed number of bins
+     * along each axis. The upper levels of the tree are built in parallel.
+     *
+     * The nodes are stored in a single array in depth first order, so the left child of a node is always the next node,
+     * and only the index of the right child is stored. Each node is 32 bytes, 2 nodes per cache line.
+     */
+    class bvh {
+    public:
+        /**
+         * A node of the tree.
+         */
+        struct node {
+            /// The bounds of every primitive under this node.
+            aabb bounds_;
+            /// For a leaf, the index of its first primitive in primitive_indices(). Else, the index of the right child.
+            std::uint32_t offset_;
+            /// For a leaf, the number of primitives. Else, 0.
+            std::uint32_t count_;
+
+            [[nodiscard]] bool is_leaf() const { return count_ != 0; }
+        };
+
+    private:
+        std::vector<node> nodes_;
+        /// The indices of the primitives, ordered so that the primitives of each leaf are contiguous.
+        std::vector<std::uint32_t> primitive_indices_;
+        /// The bounds of the primitives, in the same order as primitive_indices_.
+        std::vector<aabb> primitive_bounds_;
+
+    public:
+        /// The number of bins the SAH split is chosen from along each axis.
+        static constexpr size_t num_bins = 16;
+        /// The maximum number of primitives in a leaf.
+        static constexpr size_t max_leaf_size = 4;
+
+        /**
+         * Constructs an empty tree.
+         */
+        bvh() = default;
+
+        /**
+         * Builds a tree over a set of primitives.
+         * @param _bounds The bounds of each primitive.
+         */
+        explicit bvh(std::span<const aabb> _bounds);
+
+        /**
+         * Builds a tree over a set of triangles.
+         * @param _triangles The triangles.
+         */
+        explicit bvh(std::span<const triangle> _triangles);
+
+        /**
+         * Returns the nodes of the tree. The first node is the root.
+         * @return The nodes of the tree.
+         */
+        [[nodiscard]] std::span<const node> nodes() const { return nodes_; }
+
+        /**
+         * Returns the indices of the primitives, ordered so that the primitives of each leaf are contiguous.
+         * @return The indices of the primitives.
+         */
+        [[nodiscard]] std::span<const std::uint32_t> primitive_indices() const { return primitive_indices_; }
+
+        /**
+         * Finds every primitive whose bounds overlap a box.
+         * @param _box The box.
+         * @param _result The indices of the primitives are appended to _result.
+         */
+        void query(const aabb& _box, std::vector<std::uint32_t>& _result) const;
+
+        /**
+         * Finds every primitive whose bounds are intersected by a line, where λ >= 0.
+         * @param _line The line.
+         * @param _result The indices of the primitives are appended to _result.
+         */
+        void query(const line& _line, std::vector<std::uint32_t>& _result) const;
+
+        /**
+         * Finds the closest intersection of a line with the triangles the tree was built with, where λ >= 0.
+         * Nodes are visited closest first, and nodes further than the closest hit so far are skipped.
+         * @param _line The line.
+         * @param _triangles The triangles the tree was built with.
+         * @return The closest intersection.
+         * @attention Returns std::nullopt if the line does not intersect any triangle.
+         */
+        [[nodiscard]] std::optional<bvh_hit> intersect(const line& _line, std::span<const triangle> _triangles) const;
+    };
+}
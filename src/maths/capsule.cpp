@@ -0,0 +1,17 @@
+#include "maths/capsule.h"
+
+namespace mkr {
+    capsule::capsule(const segment& _segment, float _radius)
+            : segment_(_segment), radius_(_radius) {}
+
+    vector3 capsule::support(const vector3& _direction) const {
+        // The end of the segment furthest along the direction, pushed out by the radius.
+        const vector3 end = core_support(_direction);
+        const float length = _direction.length();
+        return (length > std::numeric_limits<float>::epsilon()) ? end + _direction * (radius_ / length) : end;
+    }
+
+    vector3 capsule::core_support(const vector3& _direction) const {
+        return (_direction.dot(segment_.direction()) >= 0.0f) ? segment_.end_ : segment_.start_;
+    }
+}
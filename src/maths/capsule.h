@@ -0,0 +1,38 @@
+#pragma once
+
+#include "maths/segment.h"
+
+namespace mkr {
+    /**
+     * A capsule, which is every point within a radius of a line segment.
+     */
+    class capsule {
+    public:
+        /// The segment at the centre of the capsule.
+        segment segment_;
+        /// The radius of the capsule.
+        float radius_;
+
+        /**
+         * Constructs the capsule.
+         * @param _segment The segment at the centre of the capsule.
+         * @param _radius The radius of the capsule.
+         */
+        capsule(const segment& _segment = segment{}, float _radius = 0.0f);
+
+        /**
+         * Returns the point of the capsule furthest along a direction.
+         * @param _direction The direction.
+         * @return The point of the capsule furthest along the direction.
+         */
+        [[nodiscard]] vector3 support(const vector3& _direction) const;
+
+        /**
+         * Returns the point of the core of the capsule furthest along a direction, for use with gjk.
+         * The core of a capsule is its segment.
+         * @param _direction The direction.
+         * @return The end of the segment furthest along the direction.
+         */
+        [[nodiscard]] vector3 core_support(const vector3& _direction) const;
+    };
+}
@@ -1,7 +1,98 @@
+#include <bit>
+#include <cmath>
+#include <cstdint>
 #include "maths/maths_util.h"
 #include "maths/colour.h"
 
 namespace mkr {
+    namespace {
+        /**
+         * The sRGB transfer function is linear below a threshold, and a power curve above it.
+         * linear = srgb / 12.92, if srgb <= 0.04045
+         * linear = ((srgb + 0.055) / 1.055)^2.4, otherwise
+         * srgb = linear * 12.92, if linear <= 0.0031308
+         * srgb = 1.055 * linear^(1/2.4) - 0.055, otherwise
+         */
+        constexpr float srgb_threshold = 0.04045f;
+        constexpr float linear_threshold = 0.0031308f;
+        constexpr float gamma = 2.4f;
+
+        /**
+         * Returns _a if _condition is true, else returns _b.
+         * Unlike the conditional operator, both values are always used, so the compiler cannot move the calculation of
+         * one of them into a branch. The conversions between float and int in fast_log2 and fast_exp2 could trap, so a
+         * branch containing them would not be turned back into a vector select.
+         */
+        inline float select(bool _condition, float _a, float _b) {
+            const std::uint32_t mask = 0u - static_cast<std::uint32_t>(_condition);
+            return std::bit_cast<float>((std::bit_cast<std::uint32_t>(_a) & mask) | (std::bit_cast<std::uint32_t>(_b) & ~mask));
+        }
+
+        /**
+         * Approximates log2(x) for a positive, normal x.
+         * Let x = 2^e * m, where 1 <= m < 2. Then log2(x) = e + log2(m), and log2(m) = u * p(u), where u = m - 1 and
+         * p is a polynomial of degree 6 which interpolates log2(1 + u) / u at the Chebyshev nodes of [0, 1].
+         * The absolute error is less than 1.2e-6.
+         */
+        inline float fast_log2(float _x) {
+            const auto bits = std::bit_cast<std::uint32_t>(_x);
+            const auto exponent = static_cast<float>(static_cast<std::int32_t>(bits >> 23) - 127);
+            const float u = std::bit_cast<float>((bits & 0x007FFFFFu) | 0x3F800000u) - 1.0f;
+            float p = 0.02001665f;
+            p = p * u - 0.0946268097f;
+            p = p * u + 0.213943212f;
+            p = p * u - 0.338377198f;
+            p = p * u + 0.477496364f;
+            p = p * u - 0.721144092f;
+            p = p * u + 1.44269298f;
+            return exponent + u * p;
+        }
+
+        /**
+         * Approximates 2^x for -126 <= x <= 127.
+         * Let x = i + f, where i is an integer and 0 <= f < 1. Then 2^x = 2^i * 2^f, where 2^i is added to the exponent
+         * bits, and 2^f is a polynomial of degree 5 which interpolates 2^f at the Chebyshev nodes of [0, 1].
+         * The relative error is less than 1.1e-7.
+         */
+        inline float fast_exp2(float _x) {
+            // Rounds towards negative infinity without std::floor, which is a library call without SSE4.1.
+            auto i = static_cast<std::int32_t>(_x);
+            i -= static_cast<std::int32_t>(_x < static_cast<float>(i));
+            const float f = _x - static_cast<float>(i);
+            float p = 0.00189375406f;
+            p = p * f + 0.00894959042f;
+            p = p * f + 0.0558603371f;
+            p = p * f + 0.240141818f;
+            p = p * f + 0.69315449f;
+            p = p * f + 0.999999898f;
+            return std::bit_cast<float>(std::bit_cast<std::uint32_t>(p) + (static_cast<std::uint32_t>(i) << 23));
+        }
+
+        /// Approximates _x^_power for a positive, normal _x, where the result is a normal float.
+        inline float fast_pow(float _x, float _power) {
+            const float exponent = fast_log2(_x) * _power;
+            return fast_exp2(select(exponent < -126.0f, -126.0f, select(exponent > 127.0f, 127.0f, exponent)));
+        }
+
+        /**
+         * Applies _function to every component of the colours except alpha.
+         * The colours are treated as one array of floats, so that the loop can be vectorised, and alpha is selected
+         * back rather than skipped.
+         */
+        template<typename Function>
+        void convert(std::span<const colour> _src, std::span<colour> _dst, Function _function) {
+            const float* src = &_src.data()->r_;
+            float* dst = &_dst.data()->r_;
+            const size_t count = _src.size() * 4;
+            for (size_t i = 0; i < count; ++i) {
+                const float value = src[i];
+                const float converted = _function(value);
+                // The component is found from 32 bits of the index, since SSE2 cannot compare 64 bit integers.
+                dst[i] = select((static_cast<std::uint32_t>(i) & 3u) == 3u, value, converted);
+            }
+        }
+    }
+
     bool colour::operator==(const colour& _rhs) const {
         return maths_util::approx_equal(r_, _rhs.r_) &&
                maths_util::approx_equal(g_, _rhs.g_) &&
@@ -64,4 +155,33 @@ namespace mkr {
     colour operator*(float _scalar, const colour& _colour) {
         return _colour * _scalar;
     }
-}
\ No newline at end of file
+
+    colour colour::to_linear() const {
+        const auto convert = [](float _value) {
+            return (_value <= srgb_threshold) ? _value / 12.92f : std::pow((_value + 0.055f) / 1.055f, gamma);
+        };
+        return colour{convert(r_), convert(g_), convert(b_), a_};
+    }
+
+    colour colour::to_srgb() const {
+        const auto convert = [](float _value) {
+            return (_value <= linear_threshold) ? _value * 12.92f : 1.055f * std::pow(_value, 1.0f / gamma) - 0.055f;
+        };
+        return colour{convert(r_), convert(g_), convert(b_), a_};
+    }
+
+    void colour::srgb_to_linear(std::span<const colour> _src, std::span<colour> _dst) {
+        convert(_src, _dst, [](float _value) {
+            // Both sides are found and one is selected, so the input of the power is clamped to where it is used.
+            const float curve = fast_pow((select(_value > srgb_threshold, _value, srgb_threshold) + 0.055f) * (1.0f / 1.055f), gamma);
+            return select(_value <= srgb_threshold, _value * (1.0f / 12.92f), curve);
+        });
+    }
+
+    void colour::linear_to_srgb(std::span<const colour> _src, std::span<colour> _dst) {
+        convert(_src, _dst, [](float _value) {
+            const float curve = 1.055f * fast_pow(select(_value > linear_threshold, _value, linear_threshold), 1.0f / gamma) - 0.055f;
+            return select(_value <= linear_threshold, _value * 12.92f, curve);
+        });
+    }
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <span>
+
 namespace mkr {
     /**
      * Represents a colour with the components RGBA.
@@ -57,5 +59,40 @@ namespace mkr {
         colour& operator*=(float _scalar);
 
         friend colour operator*(float _scalar, const colour& _colour);
+
+        /**
+         * Converts this colour from sRGB to linear, with the exact sRGB transfer function. Alpha is unchanged.
+         * [IEC 61966-2-1:1999]
+         * @return The colour in linear space.
+         */
+        [[nodiscard]] colour to_linear() const;
+
+        /**
+         * Converts this colour from linear to sRGB, with the exact sRGB transfer function. Alpha is unchanged.
+         * [IEC 61966-2-1:1999]
+         * @return The colour in sRGB space.
+         */
+        [[nodiscard]] colour to_srgb() const;
+
+        /**
+         * Converts many colours from sRGB to linear. Alpha is unchanged.
+         * Instead of calling std::pow, the power is found with polynomial approximations of log2 and exp2, in a loop
+         * that the compiler can vectorise. For components in [0, 1], the relative error is less than 4e-6, which is
+         * below the precision of 16 bit (half precision or unorm) outputs.
+         * @param _src The colours in sRGB space.
+         * @param _dst The colours in linear space. May be the same span as _src.
+         * @warning _src and _dst must be the same size.
+         */
+        static void srgb_to_linear(std::span<const colour> _src, std::span<colour> _dst);
+
+        /**
+         * Converts many colours from linear to sRGB. Alpha is unchanged.
+         * Uses the same approximations as srgb_to_linear. For components in [0, 1], the relative error is less than
+         * 2e-6.
+         * @param _src The colours in linear space.
+         * @param _dst The colours in sRGB space. May be the same span as _src.
+         * @warning _src and _dst must be the same size.
+         */
+        static void linear_to_srgb(std::span<const colour> _src, std::span<colour> _dst);
     };
 }
@@ -0,0 +1,375 @@
+#include <algorithm>
+#include "maths/convex_hull.h"
+
+namespace mkr {
+    namespace {
+        constexpr std::uint32_t invalid_index = std::numeric_limits<std::uint32_t>::max();
+
+        /**
+         * A plane of the hull being built. The planes are calculated in double precision (as in the 3 point constructor of
+         * plane, then normalised), since the faces of a hull of many points are often long and thin, and the normals of
+         * such faces are too inaccurate in single precision to tell which side of a face a nearby point is on. Without
+         * this, points coplanar with a face up to float precision can be added in the wrong order, leaving the hull
+         * slightly concave, and later points can then be discarded even though they are outside it.
+         */
+        struct hull_plane {
+            double normal_x_ = 0.0, normal_y_ = 0.0, normal_z_ = 0.0, d_ = 0.0;
+        };
+
+        /**
+         * A triangular face of the hull being built. The half edges of face f are 3f, 3f + 1 and 3f + 2, in
+         * counter-clockwise order, so only the origin and twin of each half edge need to be stored.
+         */
+        struct hull_face {
+            hull_plane plane_;
+            /// The first point in front of the face, or invalid_index. The points form a linked list through next_point_.
+            std::uint32_t first_point_ = invalid_index;
+            /// The point in front of the face which is furthest from it.
+            std::uint32_t furthest_point_ = invalid_index;
+            double furthest_distance_ = 0.0;
+            /// The iteration in which the face was last found to see the new point.
+            std::uint32_t visited_ = 0;
+            bool alive_ = true;
+        };
+
+        struct half_edge {
+            /// The point the edge starts at.
+            std::uint32_t origin_;
+            std::uint32_t twin_;
+        };
+
+        /// A horizon edge, copied out before the face it belongs to is replaced.
+        struct horizon_edge {
+            std::uint32_t origin_;
+            std::uint32_t destination_;
+            /// The half edge on the other side of the horizon, which belongs to a face that is kept.
+            std::uint32_t twin_;
+        };
+
+        inline std::uint32_t next_edge(std::uint32_t _edge) {
+            return (_edge % 3 == 2) ? _edge - 2 : _edge + 1;
+        }
+
+        inline hull_plane make_plane(const vector3& _a, const vector3& _b, const vector3& _c) {
+            const double abx = static_cast<double>(_b.x_) - _a.x_, aby = static_cast<double>(_b.y_) - _a.y_, abz = static_cast<double>(_b.z_) - _a.z_;
+            const double acx = static_cast<double>(_c.x_) - _a.x_, acy = static_cast<double>(_c.y_) - _a.y_, acz = static_cast<double>(_c.z_) - _a.z_;
+            const double nx = aby * acz - abz * acy, ny = abz * acx - abx * acz, nz = abx * acy - aby * acx;
+            const double inv_length = 1.0 / std::sqrt(nx * nx + ny * ny + nz * nz);
+            hull_plane result{nx * inv_length, ny * inv_length, nz * inv_length, 0.0};
+            result.d_ = -(result.normal_x_ * _a.x_ + result.normal_y_ * _a.y_ + result.normal_z_ * _a.z_);
+            return result;
+        }
+
+        inline double signed_distance(const hull_plane& _plane, const vector3& _point) {
+            return _plane.normal_x_ * _point.x_ + _plane.normal_y_ * _point.y_ + _plane.normal_z_ * _point.z_ + _plane.d_;
+        }
+
+        class hull_builder {
+        private:
+            std::span<const vector3> points_;
+            double tolerance_;
+            std::vector<hull_face> faces_;
+            std::vector<half_edge> edges_;
+            std::vector<std::uint32_t> next_point_;
+            std::vector<std::uint32_t> free_faces_;
+            std::uint32_t iteration_ = 0;
+
+            // Scratch arrays, reused by every iteration.
+            std::vector<std::uint32_t> visible_;
+            std::vector<horizon_edge> horizon_;
+            std::vector<std::pair<std::uint32_t, std::uint32_t>> stack_;
+            std::vector<std::uint32_t> orphans_;
+            std::vector<std::uint32_t> new_faces_;
+            std::vector<double> normal_x_, normal_y_, normal_z_, d_, distances_;
+            std::vector<std::uint32_t> work_;
+
+            std::uint32_t create_face(std::uint32_t _a, std::uint32_t _b, std::uint32_t _c) {
+                std::uint32_t face;
+                if (free_faces_.empty()) {
+                    face = static_cast<std::uint32_t>(faces_.size());
+                    faces_.emplace_back();
+                    edges_.resize(edges_.size() + 3);
+                } else {
+                    face = free_faces_.back();
+                    free_faces_.pop_back();
+                }
+
+                hull_face& f = faces_[face];
+                f.plane_ = make_plane(points_[_a], points_[_b], points_[_c]);
+                f.first_point_ = invalid_index;
+                f.furthest_point_ = invalid_index;
+                f.furthest_distance_ = 0.0;
+                f.alive_ = true;
+                edges_[face * 3] = {_a, invalid_index};
+                edges_[face * 3 + 1] = {_b, invalid_index};
+                edges_[face * 3 + 2] = {_c, invalid_index};
+                return face;
+            }
+
+            void link(std::uint32_t _edge, std::uint32_t _twin) {
+                edges_[_edge].twin_ = _twin;
+                edges_[_twin].twin_ = _edge;
+            }
+
+            /**
+             * Adds each point to the outside set of the first face in _faces it is in front of, and discards the points
+             * behind every face. Each point is usually tested against most of the faces, so the planes are copied into a
+             * structure of arrays and the distances to every face are found in one vectorised loop, rather than
+             * branching on each face in turn.
+             */
+            void assign(std::span<const std::uint32_t> _points, std::span<const std::uint32_t> _faces) {
+                const size_t num_faces = _faces.size();
+                normal_x_.resize(num_faces), normal_y_.resize(num_faces), normal_z_.resize(num_faces), d_.resize(num_faces);
+                distances_.resize(num_faces);
+                for (size_t i = 0; i < num_faces; ++i) {
+                    const hull_plane& face_plane = faces_[_faces[i]].plane_;
+                    normal_x_[i] = face_plane.normal_x_, normal_y_[i] = face_plane.normal_y_, normal_z_[i] = face_plane.normal_z_, d_[i] = face_plane.d_;
+                }
+
+                const double* __restrict nx = normal_x_.data();
+                const double* __restrict ny = normal_y_.data();
+                const double* __restrict nz = normal_z_.data();
+                const double* __restrict d = d_.data();
+                double* __restrict distances = distances_.data();
+                for (const std::uint32_t point: _points) {
+                    const double x = points_[point].x_, y = points_[point].y_, z = points_[point].z_;
+                    for (size_t i = 0; i < num_faces; ++i) {
+                        distances[i] = nx[i] * x + ny[i] * y + nz[i] * z + d[i];
+                    }
+
+                    size_t i = 0;
+                    while (i < num_faces && distances[i] <= tolerance_) { ++i; }
+                    if (i == num_faces) { continue; }
+
+                    hull_face& f = faces_[_faces[i]];
+                    next_point_[point] = f.first_point_;
+                    f.first_point_ = point;
+                    if (distances[i] > f.furthest_distance_) {
+                        f.furthest_distance_ = distances[i];
+                        f.furthest_point_ = point;
+                    }
+                }
+            }
+
+            /**
+             * Finds the faces which can see a point, starting from one of them, and the edges between those faces and
+             * the rest of the hull. The faces are searched depth first, continuing around each face from the edge after
+             * the one it was entered by, so that the horizon edges are found in counter-clockwise order.
+             */
+            void find_horizon(std::uint32_t _face, const vector3& _point) {
+                visible_.clear();
+                horizon_.clear();
+                stack_.clear();
+
+                faces_[_face].visited_ = iteration_;
+                visible_.push_back(_face);
+                // Each entry is the first edge of a face, and the next edge of it to cross.
+                stack_.emplace_back(_face * 3, _face * 3);
+                bool entered = true;
+                while (!stack_.empty()) {
+                    auto& [first, edge] = stack_.back();
+                    if (!entered && edge == first) {
+                        stack_.pop_back();
+                        continue;
+                    }
+                    entered = false;
+
+                    const std::uint32_t current = edge;
+                    edge = next_edge(edge);
+                    const std::uint32_t twin = edges_[current].twin_;
+                    hull_face& neighbour = faces_[twin / 3];
+                    if (neighbour.visited_ == iteration_) { continue; }
+
+                    if (signed_distance(neighbour.plane_, _point) > tolerance_) {
+                        neighbour.visited_ = iteration_;
+                        visible_.push_back(twin / 3);
+                        stack_.emplace_back(next_edge(twin), next_edge(twin));
+                        entered = true;
+                    } else {
+                        horizon_.push_back({edges_[current].origin_, edges_[next_edge(current)].origin_, twin});
+                    }
+                }
+            }
+
+            void add_point(std::uint32_t _face) {
+                ++iteration_;
+                const std::uint32_t eye = faces_[_face].furthest_point_;
+                find_horizon(_face, points_[eye]);
+
+                // Replace the visible faces with a fan of faces from the horizon to the new point.
+                orphans_.clear();
+                for (const std::uint32_t face: visible_) {
+                    for (std::uint32_t point = faces_[face].first_point_; point != invalid_index; point = next_point_[point]) {
+                        if (point != eye) { orphans_.push_back(point); }
+                    }
+                    faces_[face].alive_ = false;
+                    free_faces_.push_back(face);
+                }
+
+                new_faces_.clear();
+                for (const horizon_edge& edge: horizon_) {
+                    const std::uint32_t face = create_face(edge.origin_, edge.destination_, eye);
+                    link(face * 3, edge.twin_);
+                    new_faces_.push_back(face);
+                }
+                // Each new face shares its edge to the new point with the next face around the horizon.
+                for (size_t i = 0; i < new_faces_.size(); ++i) {
+                    link(new_faces_[i] * 3 + 1, new_faces_[(i + 1) % new_faces_.size()] * 3 + 2);
+                }
+
+                assign(orphans_, new_faces_);
+                for (const std::uint32_t face: new_faces_) {
+                    if (faces_[face].first_point_ != invalid_index) { work_.push_back(face); }
+                }
+            }
+
+            /// Finds 4 points which are not coplanar, or returns false.
+            bool find_initial_points(std::array<std::uint32_t, 4>& _result) const {
+                // The 2 most distant of the extreme points along each axis.
+                std::array<std::uint32_t, 6> extremes{};
+                for (std::uint32_t i = 1; i < points_.size(); ++i) {
+                    const vector3& p = points_[i];
+                    if (p.x_ < points_[extremes[0]].x_) { extremes[0] = i; }
+                    if (p.x_ > points_[extremes[1]].x_) { extremes[1] = i; }
+                    if (p.y_ < points_[extremes[2]].y_) { extremes[2] = i; }
+                    if (p.y_ > points_[extremes[3]].y_) { extremes[3] = i; }
+                    if (p.z_ < points_[extremes[4]].z_) { extremes[4] = i; }
+                    if (p.z_ > points_[extremes[5]].z_) { extremes[5] = i; }
+                }
+                double max_distance = 0.0;
+                for (size_t i = 0; i < 6; ++i) {
+                    for (size_t j = i + 1; j < 6; ++j) {
+                        const vector3& a = points_[extremes[i]];
+                        const vector3& b = points_[extremes[j]];
+                        const double x = static_cast<double>(a.x_) - b.x_, y = static_cast<double>(a.y_) - b.y_, z = static_cast<double>(a.z_) - b.z_;
+                        const double distance = x * x + y * y + z * z;
+                        if (distance > max_distance) {
+                            max_distance = distance;
+                            _result[0] = extremes[i];
+                            _result[1] = extremes[j];
+                        }
+                    }
+                }
+                if (max_distance <= tolerance_ * tolerance_) { return false; }
+
+                // The point furthest from the line through them, by |D x (P - A)|² / |D|².
+                const vector3& a = points_[_result[0]];
+                const double dx = static_cast<double>(points_[_result[1]].x_) - a.x_, dy = static_cast<double>(points_[_result[1]].y_) - a.y_,
+                             dz = static_cast<double>(points_[_result[1]].z_) - a.z_;
+                const double inv_length_squared = 1.0 / (dx * dx + dy * dy + dz * dz);
+                max_distance = 0.0;
+                for (std::uint32_t i = 0; i < points_.size(); ++i) {
+                    const double x = static_cast<double>(points_[i].x_) - a.x_, y = static_cast<double>(points_[i].y_) - a.y_,
+                                 z = static_cast<double>(points_[i].z_) - a.z_;
+                    const double cx = dy * z - dz * y, cy = dz * x - dx * z, cz = dx * y - dy * x;
+                    const double distance = (cx * cx + cy * cy + cz * cz) * inv_length_squared;
+                    if (distance > max_distance) {
+                        max_distance = distance;
+                        _result[2] = i;
+                    }
+                }
+                if (max_distance <= tolerance_ * tolerance_) { return false; }
+
+                // The point furthest from the plane through them.
+                const hull_plane base = make_plane(a, points_[_result[1]], points_[_result[2]]);
+                max_distance = 0.0;
+                for (std::uint32_t i = 0; i < points_.size(); ++i) {
+                    const double distance = std::fabs(signed_distance(base, points_[i]));
+                    if (distance > max_distance) {
+                        max_distance = distance;
+                        _result[3] = i;
+                    }
+                }
+                return max_distance > tolerance_;
+            }
+
+        public:
+            hull_builder(std::span<const vector3> _points)
+                    : points_(_points), next_point_(_points.size(), invalid_index) {
+                float max_x = 0.0f, max_y = 0.0f, max_z = 0.0f;
+                for (const auto& p: _points) {
+                    max_x = maths_util::max(max_x, std::fabs(p.x_));
+                    max_y = maths_util::max(max_y, std::fabs(p.y_));
+                    max_z = maths_util::max(max_z, std::fabs(p.z_));
+                }
+                tolerance_ = 3.0 * std::numeric_limits<double>::epsilon() * (max_x + max_y + max_z);
+            }
+
+            bool build() {
+                std::array<std::uint32_t, 4> initial{};
+                if (points_.size() < 4 || !find_initial_points(initial)) { return false; }
+
+                // Wind the faces of the tetrahedron so that the point opposite each face is behind it.
+                constexpr std::array<std::array<size_t, 3>, 4> tetrahedron{{{0, 1, 2}, {0, 3, 1}, {0, 2, 3}, {1, 3, 2}}};
+                const bool flip = signed_distance(make_plane(points_[initial[0]], points_[initial[1]], points_[initial[2]]), points_[initial[3]]) > 0.0;
+                for (const auto& [a, b, c]: tetrahedron) {
+                    flip ? create_face(initial[a], initial[c], initial[b]) : create_face(initial[a], initial[b], initial[c]);
+                }
+                for (std::uint32_t edge = 0; edge < 12; ++edge) {
+                    for (std::uint32_t other = 0; other < 12; ++other) {
+                        if (edges_[edge].origin_ == edges_[next_edge(other)].origin_ && edges_[next_edge(edge)].origin_ == edges_[other].origin_) {
+                            edges_[edge].twin_ = other;
+                        }
+                    }
+                }
+
+                const std::array<std::uint32_t, 4> initial_faces{0, 1, 2, 3};
+                for (std::uint32_t i = 0; i < points_.size(); ++i) {
+                    if (std::find(initial.begin(), initial.end(), i) == initial.end()) { orphans_.push_back(i); }
+                }
+                assign(orphans_, initial_faces);
+                for (const std::uint32_t face: initial_faces) {
+                    if (faces_[face].first_point_ != invalid_index) { work_.push_back(face); }
+                }
+
+                while (!work_.empty()) {
+                    const std::uint32_t face = work_.back();
+                    work_.pop_back();
+                    if (faces_[face].alive_ && faces_[face].first_point_ != invalid_index) { add_point(face); }
+                }
+                return true;
+            }
+
+            convex_hull to_hull() const {
+                convex_hull hull;
+                std::vector<std::uint32_t> vertex_indices(points_.size(), invalid_index);
+                for (std::uint32_t face = 0; face < faces_.size(); ++face) {
+                    if (!faces_[face].alive_) { continue; }
+
+                    std::array<std::uint32_t, 3>& vertices = hull.faces_.emplace_back();
+                    for (size_t i = 0; i < 3; ++i) {
+                        std::uint32_t& index = vertex_indices[edges_[face * 3 + i].origin_];
+                        if (index == invalid_index) {
+                            index = static_cast<std::uint32_t>(hull.vertices_.size());
+                            hull.vertices_.push_back(points_[edges_[face * 3 + i].origin_]);
+                        }
+                        vertices[i] = index;
+                    }
+                    const hull_plane& p = faces_[face].plane_;
+                    hull.planes_.emplace_back(vector3{static_cast<float>(p.normal_x_), static_cast<float>(p.normal_y_), static_cast<float>(p.normal_z_)},
+                                              static_cast<float>(p.d_));
+                }
+                return hull;
+            }
+        };
+    }
+
+    std::optional<convex_hull> convex_hull::from_points(std::span<const vector3> _points) {
+        hull_builder builder{_points};
+        if (!builder.build()) { return std::nullopt; }
+        return builder.to_hull();
+    }
+
+    vector3 convex_hull::support(const vector3& _direction) const {
+        size_t furthest = 0;
+        float max_distance = std::numeric_limits<float>::lowest();
+        for (size_t i = 0; i < vertices_.size(); ++i) {
+            const float distance = _direction.x_ * vertices_[i].x_ + _direction.y_ * vertices_[i].y_ + _direction.z_ * vertices_[i].z_;
+            if (distance > max_distance) {
+                max_distance = distance;
+                furthest = i;
+            }
+        }
+        return vertices_[furthest];
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "maths/plane.h"
+
+namespace mkr {
+    /**
+     * The convex hull of a set of points, as a closed mesh of triangles.
+     * Faces which are coplanar are not merged, so a flat side of the hull may be made of several triangles.
+     */
+    class convex_hull {
+    public:
+        /// The points of the set which are vertices of the hull.
+        std::vector<vector3> vertices_;
+        /// The vertices of each face, as indices into vertices_, counter-clockwise when seen from outside the hull.
+        std::vector<std::array<std::uint32_t, 3>> faces_;
+        /// The normalised plane of each face, with the normal pointing out of the hull.
+        std::vector<plane> planes_;
+
+        /**
+         * Returns the convex hull of a set of points, using the Quickhull algorithm.
+         * [Implementing Quickhull, Dirk Gregorius 2014]
+         *
+         * The hull starts as a tetrahedron of extreme points. Each point outside the hull is assigned to a face it is in
+         * front of, and the hull is repeatedly expanded to the point furthest from its face, replacing every face which
+         * can see that point. Points within a tolerance (scaled by the size of the set) of a face are treated as inside.
+         * Faces and their half edges are stored in arrays which reuse the slots of replaced faces, and the points
+         * assigned to each face form a linked list, so the build does not allocate per face.
+         * @param _points The points.
+         * @return The convex hull of the points.
+         * @attention Returns std::nullopt if the points are all coplanar, such as when there are fewer than 4 points.
+         */
+        [[nodiscard]] static std::optional<convex_hull> from_points(std::span<const vector3> _points);
+
+        /**
+         * Returns the vertex of the hull furthest along a direction, for use with gjk.
+         * @param _direction The direction.
+         * @return The vertex of the hull furthest along the direction.
+         * @warning The hull must not be empty.
+         */
+        [[nodiscard]] vector3 support(const vector3& _direction) const;
+    };
+}
@@ -0,0 +1,179 @@
+#include "maths/dual_quaternion.h"
+
+namespace mkr {
+    namespace {
+        /**
+         * Quaternion Multiplication Formula:
+         * (sa,va) * (sb,vb) = (sa*sb-va•vb, va×vb + sa*vb + sb*va)
+         *
+         * Written out component-wise, as dual quaternion products need 3 of these.
+         */
+        inline quaternion multiply(const quaternion& _a, const quaternion& _b) {
+            return quaternion{_a.w_ * _b.w_ - _a.x_ * _b.x_ - _a.y_ * _b.y_ - _a.z_ * _b.z_,
+                              _a.w_ * _b.x_ + _a.x_ * _b.w_ + _a.y_ * _b.z_ - _a.z_ * _b.y_,
+                              _a.w_ * _b.y_ - _a.x_ * _b.z_ + _a.y_ * _b.w_ + _a.z_ * _b.x_,
+                              _a.w_ * _b.z_ + _a.x_ * _b.y_ - _a.y_ * _b.x_ + _a.z_ * _b.w_};
+        }
+
+        inline dual_quaternion blend_bones(std::span<const dual_quaternion> _bones,
+                                           const std::array<std::uint32_t, 4>& _indices,
+                                           const std::array<float, 4>& _weights) {
+            const dual_quaternion& pivot = _bones[_indices[0]];
+            dual_quaternion result = pivot * _weights[0];
+            for (size_t i = 1; i < 4; ++i) {
+                // q and -q represent the same transform. Keep all bones in the same hemisphere as the first bone,
+                // otherwise the blend goes the long way around.
+                const dual_quaternion& bone = _bones[_indices[i]];
+                const float weight = (pivot.real_.dot(bone.real_) < 0.0f) ? -_weights[i] : _weights[i];
+                result += bone * weight;
+            }
+            result.normalise();
+            return result;
+        }
+    }
+
+    dual_quaternion::dual_quaternion(const quaternion& _real, const quaternion& _dual)
+            : real_(_real), dual_(_dual) {}
+
+    dual_quaternion::dual_quaternion(const quaternion& _rotation, const vector3& _translation)
+            : real_(_rotation), dual_(multiply(quaternion{0.0f, _translation}, _rotation) * 0.5f) {}
+
+    dual_quaternion dual_quaternion::from_matrix(const matrix4x4& _matrix) {
+        return dual_quaternion{quaternion::from_rotation_matrix(_matrix), vector3{_matrix[3][0], _matrix[3][1], _matrix[3][2]}};
+    }
+
+    void dual_quaternion::blend(std::span<const dual_quaternion> _bones,
+                                std::span<const std::array<std::uint32_t, 4>> _bone_indices,
+                                std::span<const std::array<float, 4>> _bone_weights,
+                                std::span<dual_quaternion> _result) {
+        for (size_t i = 0; i < _result.size(); ++i) {
+            _result[i] = blend_bones(_bones, _bone_indices[i], _bone_weights[i]);
+        }
+    }
+
+    void dual_quaternion::skin(std::span<const dual_quaternion> _bones,
+                               std::span<const std::array<std::uint32_t, 4>> _bone_indices,
+                               std::span<const std::array<float, 4>> _bone_weights,
+                               std::span<const vector3> _positions,
+                               std::span<vector3> _result) {
+        for (size_t i = 0; i < _result.size(); ++i) {
+            _result[i] = blend_bones(_bones, _bone_indices[i], _bone_weights[i]).transform_point(_positions[i]);
+        }
+    }
+
+    bool dual_quaternion::operator==(const dual_quaternion& _rhs) const {
+        return real_ == _rhs.real_ && dual_ == _rhs.dual_;
+    }
+
+    bool dual_quaternion::operator!=(const dual_quaternion& _rhs) const {
+        return !((*this) == _rhs);
+    }
+
+    dual_quaternion dual_quaternion::operator+(const dual_quaternion& _rhs) const {
+        return dual_quaternion{real_ + _rhs.real_, dual_ + _rhs.dual_};
+    }
+
+    dual_quaternion& dual_quaternion::operator+=(const dual_quaternion& _rhs) {
+        *this = (*this) + _rhs;
+        return *this;
+    }
+
+    dual_quaternion dual_quaternion::operator*(const dual_quaternion& _rhs) const {
+        /**
+         * Dual Quaternion Multiplication Formula:
+         * (ra + da*ε) * (rb + db*ε) = ra*rb + (ra*db + da*rb)ε, since ε² = 0.
+         */
+        return dual_quaternion{multiply(real_, _rhs.real_), multiply(real_, _rhs.dual_) + multiply(dual_, _rhs.real_)};
+    }
+
+    dual_quaternion& dual_quaternion::operator*=(const dual_quaternion& _rhs) {
+        *this = (*this) * _rhs;
+        return *this;
+    }
+
+    dual_quaternion dual_quaternion::operator*(float _rhs) const {
+        return dual_quaternion{real_ * _rhs, dual_ * _rhs};
+    }
+
+    dual_quaternion& dual_quaternion::operator*=(float _rhs) {
+        *this = (*this) * _rhs;
+        return *this;
+    }
+
+    void dual_quaternion::normalise() {
+        /**
+         * A unit dual quaternion satisfies |real| = 1 and real·dual = 0.
+         * Dividing both parts by |real| satisfies the first condition.
+         * Removing the projection of dual onto real satisfies the second.
+         */
+        const float length = real_.length();
+        if (maths_util::approx_equal(length, 0.0f)) {
+            real_ = dual_ = quaternion::zero();
+            return;
+        }
+        const float inv_length = 1.0f / length;
+        real_ *= inv_length;
+        dual_ *= inv_length;
+        dual_ -= real_ * real_.dot(dual_);
+    }
+
+    dual_quaternion dual_quaternion::normalised() const {
+        dual_quaternion result = *this;
+        result.normalise();
+        return result;
+    }
+
+    void dual_quaternion::conjugate() {
+        real_.conjugate();
+        dual_.conjugate();
+    }
+
+    dual_quaternion dual_quaternion::conjugated() const {
+        return dual_quaternion{real_.conjugated(), dual_.conjugated()};
+    }
+
+    void dual_quaternion::inverse() {
+        (*this) = inversed();
+    }
+
+    dual_quaternion dual_quaternion::inversed() const {
+        /**
+         * (r + dε)^-1 = r^-1 - (r^-1 * d * r^-1)ε
+         */
+        const quaternion real_inverse = real_.inversed();
+        return dual_quaternion{real_inverse, multiply(multiply(real_inverse, dual_), real_inverse) * -1.0f};
+    }
+
+    quaternion dual_quaternion::rotation() const {
+        return real_;
+    }
+
+    vector3 dual_quaternion::translation() const {
+        /**
+         * dual = 0.5 * T * R
+         * T = 2 * dual * R.Inverse
+         *
+         * Expanding the product (dw,dv) * (rw,-rv), the vector part is rw*dv - dw*rv + rv×dv.
+         */
+        return vector3{2.0f * (real_.w_ * dual_.x_ - dual_.w_ * real_.x_ + real_.y_ * dual_.z_ - real_.z_ * dual_.y_),
+                       2.0f * (real_.w_ * dual_.y_ - dual_.w_ * real_.y_ + real_.z_ * dual_.x_ - real_.x_ * dual_.z_),
+                       2.0f * (real_.w_ * dual_.z_ - dual_.w_ * real_.z_ + real_.x_ * dual_.y_ - real_.y_ * dual_.x_)};
+    }
+
+    vector3 dual_quaternion::transform_point(const vector3& _point) const {
+        return quaternion::rotate(_point, real_) + translation();
+    }
+
+    matrix4x4 dual_quaternion::to_matrix() const {
+        matrix4x4 result = real_.to_rotation_matrix();
+        const vector3 t = translation();
+        result[3][0] = t.x_;
+        result[3][1] = t.y_;
+        result[3][2] = t.z_;
+        return result;
+    }
+
+    dual_quaternion operator*(float _lhs, const dual_quaternion& _dual_quaternion) {
+        return _dual_quaternion * _lhs;
+    }
+}
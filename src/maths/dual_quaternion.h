@@ -0,0 +1,180 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include "maths/quaternion.h"
+
+namespace mkr {
+    /**
+     * @brief
+     * Dual Quaternion
+     *
+     * [https://cs.gmu.edu/~jmlien/teaching/cs451/uploads/Main/dual-quaternion.pdf]
+     * [https://users.cs.utah.edu/~ladislav/kavan07skinning/kavan07skinning.pdf]
+     *
+     * A dual quaternion is written as real + dual * ε, where ε² = 0.
+     * A unit dual quaternion represents a rigid transform (a rotation followed by a translation) using 8 floats.
+     *
+     * For a rotation R and a translation T (as the pure quaternion (0, T)):
+     * real = R
+     * dual = 0.5 * T * R
+     *
+     * Like matrices, (A * B) is the transform which applies B first, then A.
+     */
+    class dual_quaternion {
+    public:
+        static dual_quaternion identity() { return dual_quaternion{quaternion::identity(), quaternion::zero()}; }
+
+        /// The real part. For a rigid transform, this is the rotation.
+        quaternion real_;
+        /// The dual part. For a rigid transform, this is half the translation multiplied by the rotation.
+        quaternion dual_;
+
+        /**
+         * Constructs a dual quaternion.
+         * @param _real The real part.
+         * @param _dual The dual part.
+         */
+        explicit dual_quaternion(const quaternion& _real = quaternion::identity(), const quaternion& _dual = quaternion::zero());
+
+        /**
+         * Constructs a unit dual quaternion representing a rotation followed by a translation.
+         * @param _rotation The unit rotation.
+         * @param _translation The translation.
+         * @warning _rotation must be a rotational quaternion.
+         */
+        explicit dual_quaternion(const quaternion& _rotation, const vector3& _translation);
+
+        /**
+         * Constructs a unit dual quaternion from a rigid transform matrix.
+         * @param _matrix The rigid transform matrix.
+         * @return The unit dual quaternion.
+         * @warning The upper 3x3 part of _matrix must be a pure rotation matrix, with no scale or shear.
+         */
+        [[nodiscard]] static dual_quaternion from_matrix(const matrix4x4& _matrix);
+
+        /**
+         * Dual Quaternion Linear Blending of bone transforms for skinning.
+         * Each vertex's transform is the normalised, weighted sum of the transforms of up to 4 bones.
+         * @param _bones The bone transforms.
+         * @param _bone_indices The indices of the bones which influence each vertex.
+         * @param _bone_weights The weights of the bones which influence each vertex. Unused influences should have a weight of 0.
+         * @param _result The blended transform of each vertex.
+         * @warning _bone_indices, _bone_weights and _result must be the same size.
+         * @warning _bones must be unit dual quaternions.
+         */
+        static void blend(std::span<const dual_quaternion> _bones,
+                          std::span<const std::array<std::uint32_t, 4>> _bone_indices,
+                          std::span<const std::array<float, 4>> _bone_weights,
+                          std::span<dual_quaternion> _result);
+
+        /**
+         * Skin vertex positions using Dual Quaternion Linear Blending.
+         * @param _bones The bone transforms.
+         * @param _bone_indices The indices of the bones which influence each vertex.
+         * @param _bone_weights The weights of the bones which influence each vertex. Unused influences should have a weight of 0.
+         * @param _positions The vertex positions in bind space.
+         * @param _result The skinned vertex positions.
+         * @warning _bone_indices, _bone_weights, _positions and _result must be the same size.
+         * @warning _bones must be unit dual quaternions.
+         */
+        static void skin(std::span<const dual_quaternion> _bones,
+                         std::span<const std::array<std::uint32_t, 4>> _bone_indices,
+                         std::span<const std::array<float, 4>> _bone_weights,
+                         std::span<const vector3> _positions,
+                         std::span<vector3> _result);
+
+        bool operator==(const dual_quaternion& _rhs) const;
+
+        bool operator!=(const dual_quaternion& _rhs) const;
+
+        dual_quaternion operator+(const dual_quaternion& _rhs) const;
+
+        dual_quaternion& operator+=(const dual_quaternion& _rhs);
+
+        dual_quaternion operator*(const dual_quaternion& _rhs) const;
+
+        dual_quaternion& operator*=(const dual_quaternion& _rhs);
+
+        dual_quaternion operator*(float _rhs) const;
+
+        dual_quaternion& operator*=(float _rhs);
+
+        /**
+         * Normalise this dual quaternion, so that it represents a rigid transform.
+         * The real part is made unit length, and the dual part is made orthogonal to the real part.
+         */
+        void normalise();
+
+        /**
+         * Get a normalised copy of this dual quaternion.
+         * @return A normalised copy of this dual quaternion.
+         */
+        [[nodiscard]] dual_quaternion normalised() const;
+
+        /**
+         * Conjugate this dual quaternion (the quaternion conjugate of both parts).
+         * @note For unit dual quaternions, the inverse is equal to the conjugate.
+         */
+        void conjugate();
+
+        /**
+         * Get a conjugated copy of this dual quaternion.
+         * @return A conjugated copy of this dual quaternion.
+         * @note For unit dual quaternions, the inverse is equal to the conjugate.
+         */
+        [[nodiscard]] dual_quaternion conjugated() const;
+
+        /**
+         * Inverse this dual quaternion.
+         * @warning The real part must not be a zero quaternion.
+         */
+        void inverse();
+
+        /**
+         * Get an inversed copy of this dual quaternion.
+         * @return An inversed copy of this dual quaternion.
+         * @warning The real part must not be a zero quaternion.
+         */
+        [[nodiscard]] dual_quaternion inversed() const;
+
+        /**
+         * Get the rotation of this transform.
+         * @return The rotation of this transform.
+         */
+        [[nodiscard]] quaternion rotation() const;
+
+        /**
+         * Get the translation of this transform.
+         * @return The translation of this transform.
+         * @warning This dual quaternion must be a unit dual quaternion.
+         */
+        [[nodiscard]] vector3 translation() const;
+
+        /**
+         * Transform a point by this transform.
+         * @param _point The point to transform.
+         * @return The transformed point.
+         * @warning This dual quaternion must be a unit dual quaternion.
+         */
+        [[nodiscard]] vector3 transform_point(const vector3& _point) const;
+
+        /**
+         * Get this transform as a matrix4x4.
+         * @return This transform as a matrix4x4.
+         * @warning This dual quaternion must be a unit dual quaternion.
+         */
+        [[nodiscard]] matrix4x4 to_matrix() const;
+
+        friend dual_quaternion operator*(float _lhs, const dual_quaternion& _dual_quaternion);
+
+        [[nodiscard]] std::string to_string(const int _precision = 4) const {
+            return real_.to_string(_precision) + " + (" + dual_.to_string(_precision) + ")ε";
+        }
+
+        friend std::ostream& operator<<(std::ostream& _stream, const dual_quaternion& _dual_quaternion) {
+            return _stream << _dual_quaternion.to_string();
+        }
+    };
+}
@@ -0,0 +1,488 @@
+#include <algorithm>
+#include <initializer_list>
+#include "maths/gjk.h"
+
+namespace mkr {
+    namespace {
+        /// A distance query ends when the next support point is no more than this fraction of the squared distance closer.
+        constexpr float relative_tolerance = 1e-5f;
+        /// A penetration query ends when the polytope grows by no more than this fraction of its distance to the origin.
+        constexpr float epa_tolerance = 1e-4f;
+        constexpr size_t max_epa_vertices = 4 + gjk::max_iterations;
+        constexpr size_t max_epa_faces = 256;
+        constexpr size_t max_epa_edges = 128;
+
+        /// A vertex of the Minkowski difference, and the points of each shape it was made from.
+        struct simplex_vertex {
+            vector3 w_;
+            vector3 a_;
+            vector3 b_;
+            /// The direction the vertex was found along.
+            vector3 direction_;
+        };
+
+        simplex_vertex support(const support_function& _a, const support_function& _b, const vector3& _direction) {
+            const vector3 a = _a(_direction);
+            const vector3 b = _b(-_direction);
+            return simplex_vertex{a - b, a, b, _direction};
+        }
+
+        /// A simplex, and the barycentric weights of the point on it closest to the origin.
+        struct simplex {
+            std::array<simplex_vertex, 4> vertices_;
+            std::array<float, 4> weights_{};
+            size_t size_ = 0;
+
+            void set(std::initializer_list<std::pair<const simplex_vertex*, float>> _vertices) {
+                size_ = 0;
+                for (const auto& [vertex, weight]: _vertices) {
+                    vertices_[size_] = *vertex;
+                    weights_[size_++] = weight;
+                }
+            }
+
+            [[nodiscard]] vector3 closest_point() const {
+                vector3 result = vector3::zero();
+                for (size_t i = 0; i < size_; ++i) {
+                    result += vertices_[i].w_ * weights_[i];
+                }
+                return result;
+            }
+        };
+
+        /// Reduces _result to the vertices of a segment closest to the origin.
+        void solve_segment(const simplex_vertex& _a, const simplex_vertex& _b, simplex& _result) {
+            const vector3 ab = _b.w_ - _a.w_;
+            const float length_squared = ab.length_squared();
+            const float t = (length_squared > 0.0f) ? -_a.w_.dot(ab) / length_squared : 0.0f;
+            if (t <= 0.0f) {
+                _result.set({{&_a, 1.0f}});
+            } else if (t >= 1.0f) {
+                _result.set({{&_b, 1.0f}});
+            } else {
+                _result.set({{&_a, 1.0f - t}, {&_b, t}});
+            }
+        }
+
+        /// Reduces _result to the vertices of a triangle closest to the origin.
+        void solve_triangle(const simplex_vertex& _a, const simplex_vertex& _b, const simplex_vertex& _c, simplex& _result) {
+            /**
+             * Find the Voronoi region of the triangle containing the origin P, by the signs of the dot products of the
+             * edges with the vectors from each vertex to P.
+             * [Real-Time Collision Detection, Christer Ericson 2005, 5.1.5]
+             */
+            const vector3 ab = _b.w_ - _a.w_;
+            const vector3 ac = _c.w_ - _a.w_;
+            const float d1 = -ab.dot(_a.w_), d2 = -ac.dot(_a.w_);
+            if (d1 <= 0.0f && d2 <= 0.0f) { return _result.set({{&_a, 1.0f}}); }
+
+            const float d3 = -ab.dot(_b.w_), d4 = -ac.dot(_b.w_);
+            if (d3 >= 0.0f && d4 <= d3) { return _result.set({{&_b, 1.0f}}); }
+
+            const float vc = d1 * d4 - d3 * d2;
+            if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+                const float v = d1 / (d1 - d3);
+                return _result.set({{&_a, 1.0f - v}, {&_b, v}});
+            }
+
+            const float d5 = -ab.dot(_c.w_), d6 = -ac.dot(_c.w_);
+            if (d6 >= 0.0f && d5 <= d6) { return _result.set({{&_c, 1.0f}}); }
+
+            const float vb = d5 * d2 - d1 * d6;
+            if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+                const float w = d2 / (d2 - d6);
+                return _result.set({{&_a, 1.0f - w}, {&_c, w}});
+            }
+
+            const float va = d3 * d6 - d5 * d4;
+            if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+                const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+                return _result.set({{&_b, 1.0f - w}, {&_c, w}});
+            }
+
+            const float denominator = va + vb + vc;
+            if (denominator <= std::numeric_limits<float>::min()) {
+                // The triangle is degenerate, so the closest point is on its longest edge.
+                const float ab_length = ab.length_squared(), ac_length = ac.length_squared(), bc_length = (_c.w_ - _b.w_).length_squared();
+                if (ab_length >= ac_length && ab_length >= bc_length) { return solve_segment(_a, _b, _result); }
+                return (ac_length >= bc_length) ? solve_segment(_a, _c, _result) : solve_segment(_b, _c, _result);
+            }
+            const float v = vb / denominator, w = vc / denominator;
+            _result.set({{&_a, 1.0f - v - w}, {&_b, v}, {&_c, w}});
+        }
+
+        /**
+         * Reduces _simplex to the vertices closest to the origin.
+         * @return Returns true if the simplex is a tetrahedron containing the origin, else returns false.
+         */
+        bool solve(simplex& _simplex) {
+            const auto v = _simplex.vertices_;
+            switch (_simplex.size_) {
+                case 1:
+                    _simplex.weights_[0] = 1.0f;
+                    return false;
+                case 2:
+                    solve_segment(v[0], v[1], _simplex);
+                    return false;
+                case 3:
+                    solve_triangle(v[0], v[1], v[2], _simplex);
+                    return false;
+                default:
+                    break;
+            }
+
+            // Check each face of the tetrahedron which has the origin on the other side from the 4th vertex.
+            constexpr std::array<std::array<size_t, 4>, 4> faces{{{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}}};
+            bool outside = false;
+            float min_distance = std::numeric_limits<float>::max();
+            simplex best, candidate;
+            for (const auto& [a, b, c, opposite]: faces) {
+                const vector3 normal = (v[b].w_ - v[a].w_).cross(v[c].w_ - v[a].w_);
+                const float origin_side = -normal.dot(v[a].w_);
+                const float opposite_side = normal.dot(v[opposite].w_ - v[a].w_);
+                // A flat tetrahedron cannot contain the origin, so every face is checked.
+                const bool is_flat = opposite_side * opposite_side <= std::numeric_limits<float>::epsilon() * normal.length_squared() *
+                                                                      (v[opposite].w_ - v[a].w_).length_squared();
+                if (!is_flat && origin_side * opposite_side >= 0.0f) { continue; }
+
+                outside = true;
+                solve_triangle(v[a], v[b], v[c], candidate);
+                const float distance = candidate.closest_point().length_squared();
+                if (distance < min_distance) {
+                    min_distance = distance;
+                    best = candidate;
+                }
+            }
+            if (!outside) { return true; }
+
+            _simplex = best;
+            return false;
+        }
+
+        /// Copies the directions of the vertices of a simplex, to warm start the next query.
+        void store(const simplex& _simplex, gjk_simplex& _result) {
+            for (size_t i = 0; i < _simplex.size_; ++i) {
+                _result.directions_[i] = _simplex.vertices_[i].direction_;
+            }
+            _result.size_ = _simplex.size_;
+        }
+
+        struct epa_face {
+            std::array<std::uint32_t, 3> vertices_;
+            vector3 normal_;
+            float distance_;
+            bool alive_;
+        };
+
+        /// The faces of the polytope of a penetration query, with their normals pointing away from the origin.
+        class polytope {
+        public:
+            std::array<simplex_vertex, max_epa_vertices> vertices_;
+            std::array<epa_face, max_epa_faces> faces_;
+            size_t num_vertices_ = 0;
+            size_t num_faces_ = 0;
+
+            bool add_face(std::uint32_t _a, std::uint32_t _b, std::uint32_t _c) {
+                if (num_faces_ == max_epa_faces) { return false; }
+
+                epa_face& face = faces_[num_faces_++];
+                face.vertices_ = {_a, _b, _c};
+                face.alive_ = true;
+                const vector3 normal = (vertices_[_b].w_ - vertices_[_a].w_).cross(vertices_[_c].w_ - vertices_[_a].w_);
+                const float length = normal.length();
+                if (length <= std::numeric_limits<float>::min()) {
+                    // A face with no area is never the closest face, and never seen by a new vertex.
+                    face.normal_ = vector3::zero();
+                    face.distance_ = std::numeric_limits<float>::max();
+                    return true;
+                }
+                face.normal_ = normal * (1.0f / length);
+                face.distance_ = face.normal_.dot(vertices_[_a].w_);
+                return true;
+            }
+
+            [[nodiscard]] const epa_face* closest_face() const {
+                const epa_face* result = nullptr;
+                for (size_t i = 0; i < num_faces_; ++i) {
+                    if (faces_[i].alive_ && (!result || faces_[i].distance_ < result->distance_)) { result = &faces_[i]; }
+                }
+                return result;
+            }
+        };
+
+        /// Returns a vector perpendicular to _v.
+        vector3 perpendicular(const vector3& _v) {
+            // Crossing with the axis _v is least aligned with avoids a result near 0.
+            const vector3 axis = (std::fabs(_v.x_) < std::fabs(_v.y_)) ? ((std::fabs(_v.x_) < std::fabs(_v.z_)) ? vector3::x_axis() : vector3::z_axis())
+                                                                       : ((std::fabs(_v.y_) < std::fabs(_v.z_)) ? vector3::y_axis() : vector3::z_axis());
+            return _v.cross(axis);
+        }
+
+        /// Adds a vertex to a simplex that is not a tetrahedron, off the point, line or plane of its vertices.
+        bool expand(const support_function& _a, const support_function& _b, std::array<simplex_vertex, 4>& _vertices, size_t& _size) {
+            const float epsilon = std::numeric_limits<float>::epsilon();
+            std::array<vector3, 6> directions;
+            if (_size == 1) {
+                directions = {vector3::x_axis(), -vector3::x_axis(), vector3::y_axis(), -vector3::y_axis(), vector3::z_axis(), -vector3::z_axis()};
+            } else if (_size == 2) {
+                const vector3 d = _vertices[1].w_ - _vertices[0].w_;
+                const vector3 n1 = perpendicular(d), n2 = d.cross(n1);
+                directions = {n1, -n1, n2, -n2, n1 + n2, -n1 - n2};
+            } else {
+                const vector3 n = (_vertices[1].w_ - _vertices[0].w_).cross(_vertices[2].w_ - _vertices[0].w_);
+                directions = {n, -n, n, -n, n, -n};
+            }
+
+            for (const auto& direction: directions) {
+                const simplex_vertex vertex = support(_a, _b, direction);
+                const vector3 offset = vertex.w_ - _vertices[0].w_;
+                float distance_squared, scale;
+                if (_size == 1) {
+                    distance_squared = offset.length_squared();
+                    scale = maths_util::max(1.0f, _vertices[0].w_.length_squared());
+                } else if (_size == 2) {
+                    const vector3 d = _vertices[1].w_ - _vertices[0].w_;
+                    distance_squared = d.cross(offset).length_squared();
+                    scale = d.length_squared() * maths_util::max(1.0f, offset.length_squared());
+                } else {
+                    const vector3 n = (_vertices[1].w_ - _vertices[0].w_).cross(_vertices[2].w_ - _vertices[0].w_);
+                    const float d = n.dot(offset);
+                    distance_squared = d * d;
+                    scale = n.length_squared() * maths_util::max(1.0f, offset.length_squared());
+                }
+                if (distance_squared > epsilon * scale) {
+                    _vertices[_size++] = vertex;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// Finds the distance and the closest points between the cores of 2 shapes.
+        gjk_result core_distance(const support_function& _a, const support_function& _b, gjk_simplex& _simplex) {
+            simplex s;
+            if (_simplex.size_ > 0) {
+                for (size_t i = 0; i < _simplex.size_; ++i) {
+                    s.vertices_[i] = support(_a, _b, _simplex.directions_[i]);
+                }
+                s.size_ = _simplex.size_;
+            } else {
+                s.vertices_[0] = support(_a, _b, vector3::x_axis());
+                s.size_ = 1;
+            }
+
+            gjk_result result{false, 0.0f, vector3::zero(), vector3::zero(), 0};
+            vector3 closest = vector3::zero();
+            while (true) {
+                if (solve(s)) {
+                    result.intersects_ = true;
+                    break;
+                }
+
+                // The origin is on the simplex if its closest point is within rounding error of the origin.
+                closest = s.closest_point();
+                const float distance_squared = closest.length_squared();
+                float scale = 0.0f;
+                for (size_t i = 0; i < s.size_; ++i) {
+                    scale = maths_util::max(scale, s.vertices_[i].w_.length_squared());
+                }
+                if (distance_squared <= std::numeric_limits<float>::epsilon() * scale) {
+                    result.intersects_ = true;
+                    break;
+                }
+                if (result.iterations_ == gjk::max_iterations) { break; }
+
+                // Stop when the support point furthest towards the origin does not get closer to it than the simplex.
+                const simplex_vertex vertex = support(_a, _b, -closest);
+                ++result.iterations_;
+                if (distance_squared - closest.dot(vertex.w_) <= relative_tolerance * distance_squared) { break; }
+
+                // A vertex already in the simplex means the query has converged.
+                bool is_duplicate = false;
+                for (size_t i = 0; i < s.size_; ++i) {
+                    is_duplicate |= (s.vertices_[i].w_ == vertex.w_);
+                }
+                if (is_duplicate) { break; }
+                s.vertices_[s.size_++] = vertex;
+            }
+
+            store(s, _simplex);
+            if (!result.intersects_) {
+                result.distance_ = closest.length();
+                for (size_t i = 0; i < s.size_; ++i) {
+                    result.point_a_ += s.vertices_[i].a_ * s.weights_[i];
+                    result.point_b_ += s.vertices_[i].b_ * s.weights_[i];
+                }
+            }
+            return result;
+        }
+    }
+
+    convex_points::convex_points(std::span<const vector3> _points)
+            : points_(_points) {}
+
+    vector3 convex_points::support(const vector3& _direction) const {
+        size_t furthest = 0;
+        float max_distance = std::numeric_limits<float>::lowest();
+        for (size_t i = 0; i < points_.size(); ++i) {
+            const float distance = _direction.x_ * points_[i].x_ + _direction.y_ * points_[i].y_ + _direction.z_ * points_[i].z_;
+            if (distance > max_distance) {
+                max_distance = distance;
+                furthest = i;
+            }
+        }
+        return points_[furthest];
+    }
+
+    gjk_result gjk::distance(support_function _a, support_function _b, gjk_simplex& _simplex) {
+        gjk_result result = core_distance(_a, _b, _simplex);
+        const float radius = _a.radius() + _b.radius();
+        if (result.intersects_ || radius == 0.0f) { return result; }
+
+        // The closest points of the shapes are the closest points of the cores, moved towards each other by the radii.
+        if (result.distance_ <= radius) {
+            result.intersects_ = true;
+            result.distance_ = 0.0f;
+            return result;
+        }
+        const vector3 normal = (result.point_b_ - result.point_a_) * (1.0f / result.distance_);
+        result.distance_ -= radius;
+        result.point_a_ += normal * _a.radius();
+        result.point_b_ -= normal * _b.radius();
+        return result;
+    }
+
+    gjk_result gjk::distance(support_function _a, support_function _b) {
+        gjk_simplex simplex;
+        return distance(_a, _b, simplex);
+    }
+
+    std::optional<epa_result> gjk::penetration(support_function _a, support_function _b) {
+        gjk_simplex simplex;
+        return penetration(_a, _b, simplex);
+    }
+
+    std::optional<epa_result> gjk::penetration(support_function _a, support_function _b, gjk_simplex& _simplex) {
+        const gjk_result core = core_distance(_a, _b, _simplex);
+        const float radius = _a.radius() + _b.radius();
+        if (!core.intersects_) {
+            if (core.distance_ >= radius) { return std::nullopt; }
+            // The cores are apart, so the shapes overlap by their radii along the line between the closest points of the cores.
+            if (core.distance_ > std::numeric_limits<float>::epsilon() * radius) {
+                const vector3 normal = (core.point_b_ - core.point_a_) * (1.0f / core.distance_);
+                return epa_result{radius - core.distance_, normal, core.point_a_ + normal * _a.radius(), core.point_b_ - normal * _b.radius()};
+            }
+        }
+
+        // Rebuild the simplex, and expand it into a tetrahedron if the origin was found on a face, edge or vertex of it.
+        simplex initial;
+        initial.size_ = _simplex.size_;
+        for (size_t i = 0; i < initial.size_; ++i) {
+            initial.vertices_[i] = support(_a, _b, _simplex.directions_[i]);
+        }
+        while (initial.size_ < 4) {
+            if (expand(_a, _b, initial.vertices_, initial.size_)) { continue; }
+
+            /**
+             * The Minkowski difference of the cores is a point, segment or polygon, such as for 2 spheres with the same
+             * centre or 2 capsules whose segments cross. The cores touch without overlapping, so the shapes overlap by
+             * their radii, along any direction off the point, segment or polygon.
+             */
+            const simplex_vertex* v = initial.vertices_.data();
+            vector3 normal = vector3::x_axis();
+            if (initial.size_ == 2) {
+                normal = perpendicular(v[1].w_ - v[0].w_).normalised();
+            } else if (initial.size_ == 3) {
+                normal = (v[1].w_ - v[0].w_).cross(v[2].w_ - v[0].w_).normalised();
+            }
+            solve(initial);
+            vector3 point_a = vector3::zero(), point_b = vector3::zero();
+            for (size_t i = 0; i < initial.size_; ++i) {
+                point_a += v[i].a_ * initial.weights_[i];
+                point_b += v[i].b_ * initial.weights_[i];
+            }
+            return epa_result{radius, normal, point_a + normal * _a.radius(), point_b - normal * _b.radius()};
+        }
+
+        polytope p;
+        const auto& vertices = initial.vertices_;
+        std::copy(vertices.begin(), vertices.end(), p.vertices_.begin());
+        p.num_vertices_ = 4;
+        // Wind each face so that the vertex opposite it is behind it.
+        const bool flip = (vertices[1].w_ - vertices[0].w_).cross(vertices[2].w_ - vertices[0].w_).dot(vertices[3].w_ - vertices[0].w_) > 0.0f;
+        constexpr std::array<std::array<std::uint32_t, 3>, 4> tetrahedron{{{0, 1, 2}, {0, 3, 1}, {0, 2, 3}, {1, 3, 2}}};
+        for (const auto& [a, b, c]: tetrahedron) {
+            flip ? p.add_face(a, c, b) : p.add_face(a, b, c);
+        }
+
+        std::array<std::pair<std::uint32_t, std::uint32_t>, max_epa_edges> edges;
+        const epa_face* closest = p.closest_face();
+        bool converged = false;
+        for (std::uint32_t iteration = 0; iteration < max_iterations; ++iteration) {
+            const simplex_vertex vertex = support(_a, _b, closest->normal_);
+            const float distance = closest->normal_.dot(vertex.w_);
+            if (distance - closest->distance_ <= epa_tolerance * maths_util::max(1.0f, distance)) {
+                converged = true;
+                break;
+            }
+            if (p.num_vertices_ == max_epa_vertices) { return std::nullopt; }
+
+            const auto index = static_cast<std::uint32_t>(p.num_vertices_++);
+            p.vertices_[index] = vertex;
+
+            // Remove the faces which can see the new vertex. The edges used by only one removed face form the horizon.
+            size_t num_edges = 0;
+            bool is_full = false;
+            for (size_t i = 0; i < p.num_faces_; ++i) {
+                epa_face& face = p.faces_[i];
+                if (!face.alive_ || face.normal_.dot(vertex.w_ - p.vertices_[face.vertices_[0]].w_) <= 0.0f) { continue; }
+
+                face.alive_ = false;
+                for (size_t j = 0; j < 3; ++j) {
+                    const std::pair<std::uint32_t, std::uint32_t> edge{face.vertices_[j], face.vertices_[(j + 1) % 3]};
+                    const auto twin = std::find(edges.begin(), edges.begin() + static_cast<std::ptrdiff_t>(num_edges), std::make_pair(edge.second, edge.first));
+                    if (twin != edges.begin() + static_cast<std::ptrdiff_t>(num_edges)) {
+                        *twin = edges[--num_edges];
+                    } else if (num_edges < max_epa_edges) {
+                        edges[num_edges++] = edge;
+                    } else {
+                        is_full = true;
+                    }
+                }
+            }
+
+            // Compact the face array, then add a face from each horizon edge to the new vertex.
+            size_t num_alive = 0;
+            for (size_t i = 0; i < p.num_faces_; ++i) {
+                if (p.faces_[i].alive_) { p.faces_[num_alive++] = p.faces_[i]; }
+            }
+            p.num_faces_ = num_alive;
+            for (size_t i = 0; i < num_edges; ++i) {
+                is_full |= !p.add_face(edges[i].first, edges[i].second, index);
+            }
+            if (is_full) { return std::nullopt; }
+            closest = p.closest_face();
+        }
+        // The closest face of a polytope which has not converged is not the closest face of the Minkowski difference.
+        if (!converged) { return std::nullopt; }
+
+        /**
+         * The closest point of the Minkowski difference to the origin is the projection of the origin onto the closest
+         * face. Its barycentric coordinates on the face give the points on each shape.
+         * [Real-Time Collision Detection, Christer Ericson 2005, 3.4]
+         */
+        const simplex_vertex& a = p.vertices_[closest->vertices_[0]];
+        const simplex_vertex& b = p.vertices_[closest->vertices_[1]];
+        const simplex_vertex& c = p.vertices_[closest->vertices_[2]];
+        const vector3 v0 = b.w_ - a.w_, v1 = c.w_ - a.w_, v2 = closest->normal_ * closest->distance_ - a.w_;
+        const float d00 = v0.dot(v0), d01 = v0.dot(v1), d11 = v1.dot(v1), d20 = v2.dot(v0), d21 = v2.dot(v1);
+        const float inv_denominator = 1.0f / (d00 * d11 - d01 * d01);
+        const float v = (d11 * d20 - d01 * d21) * inv_denominator;
+        const float w = (d00 * d21 - d01 * d20) * inv_denominator;
+        const float u = 1.0f - v - w;
+        // The rounded parts of the shapes add their radii to the overlap of the cores.
+        const vector3& normal = closest->normal_;
+        return epa_result{maths_util::max(0.0f, closest->distance_) + radius, normal,
+                          a.a_ * u + b.a_ * v + c.a_ * w + normal * _a.radius(), a.b_ * u + b.b_ * v + c.b_ * w - normal * _b.radius()};
+    }
+}
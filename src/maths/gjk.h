@@ -0,0 +1,205 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include "maths/vector3.h"
+
+namespace mkr {
+    /**
+     * A shape with a core, which is a point or segment, and a radius, such as a sphere or a capsule. The shape is every
+     * point within the radius of its core.
+     */
+    template<typename Shape>
+    concept rounded_shape = requires(const Shape& _shape, const vector3& _direction) {
+        { _shape.core_support(_direction) } -> std::convertible_to<vector3>;
+        { _shape.radius_ } -> std::convertible_to<float>;
+    };
+
+    /**
+     * A convex shape, given by a function which returns the point of its core furthest along a direction, and a radius.
+     * The shape is every point within the radius of its core.
+     *
+     * Any type with a member function vector3 support(const vector3&) const, such as aabb, convex_hull and
+     * convex_points, converts to a support_function which is its own core, with a radius of 0. A rounded_shape, such as
+     * a sphere or a capsule, converts to a support_function of its core and radius instead, so that gjk works on a point
+     * or segment rather than a curved surface, which would only be approached a little closer with each iteration.
+     * The shape is referenced rather than copied.
+     */
+    class support_function {
+    private:
+        const void* shape_;
+        vector3 (* support_)(const void*, const vector3&);
+        float radius_;
+
+    public:
+        /**
+         * Constructs the support function of a shape.
+         * @param _shape The shape.
+         * @warning _shape must outlive the support function.
+         */
+        template<typename Shape>
+        support_function(const Shape& _shape)
+                : shape_(&_shape),
+                  support_([](const void* _s, const vector3& _direction) { return static_cast<const Shape*>(_s)->support(_direction); }),
+                  radius_(0.0f) {}
+
+        /**
+         * Constructs the support function of a rounded shape.
+         * @param _shape The shape.
+         * @warning _shape must outlive the support function.
+         */
+        template<rounded_shape Shape>
+        support_function(const Shape& _shape)
+                : shape_(&_shape),
+                  support_([](const void* _s, const vector3& _direction) { return static_cast<const Shape*>(_s)->core_support(_direction); }),
+                  radius_(_shape.radius_) {}
+
+        /**
+         * Returns the point of the core of the shape furthest along a direction.
+         * @param _direction The direction.
+         * @return The point of the core of the shape furthest along the direction.
+         */
+        [[nodiscard]] vector3 operator()(const vector3& _direction) const { return support_(shape_, _direction); }
+
+        /**
+         * Returns the radius of the shape around its core.
+         * @return The radius of the shape around its core.
+         */
+        [[nodiscard]] float radius() const { return radius_; }
+    };
+
+    /**
+     * The convex hull of a set of points, without building the hull. Each support query checks every point.
+     */
+    class convex_points {
+    public:
+        /// The points.
+        std::span<const vector3> points_;
+
+        /**
+         * Constructs the set.
+         * @param _points The points.
+         * @warning _points must not be empty, and must outlive the set.
+         */
+        explicit convex_points(std::span<const vector3> _points);
+
+        /**
+         * Returns the point furthest along a direction, for use with gjk.
+         * @param _direction The direction.
+         * @return The point furthest along the direction.
+         */
+        [[nodiscard]] vector3 support(const vector3& _direction) const;
+    };
+
+    /**
+     * The simplex a gjk query ended with, kept between queries of the same pair of shapes to warm start the next query.
+     * The directions that the vertices of the simplex were found along are stored, rather than the vertices themselves,
+     * so that the simplex can be rebuilt on the shapes after they have moved. When the shapes have only moved a little,
+     * the rebuilt simplex is already close to the answer, and the query usually ends after 1 or 2 iterations.
+     */
+    class gjk_simplex {
+    public:
+        /// The directions the vertices of the simplex were found along.
+        std::array<vector3, 4> directions_;
+        /// The number of vertices of the simplex. A simplex of size 0 is not used to warm start.
+        size_t size_ = 0;
+
+        /**
+         * Empties the simplex, so the next query is not warm started.
+         */
+        void clear() { size_ = 0; }
+    };
+
+    /**
+     * The result of gjk::distance.
+     */
+    struct gjk_result {
+        /// Whether the shapes overlap.
+        bool intersects_;
+        /// The distance between the shapes, or 0 if they overlap.
+        float distance_;
+        /// The point on the first shape closest to the second shape. Unused if the shapes overlap.
+        vector3 point_a_;
+        /// The point on the second shape closest to the first shape. Unused if the shapes overlap.
+        vector3 point_b_;
+        /// The number of support points found, not counting those used to rebuild a warm started simplex.
+        std::uint32_t iterations_;
+    };
+
+    /**
+     * The result of gjk::penetration.
+     */
+    struct epa_result {
+        /// How far the shapes overlap.
+        float depth_;
+        /// The direction from the first shape to the second. Moving the second shape by normal_ * depth_ separates them.
+        vector3 normal_;
+        /// The point of the first shape deepest inside the second shape.
+        vector3 point_a_;
+        /// The point of the second shape deepest inside the first shape.
+        vector3 point_b_;
+    };
+
+    /**
+     * Distance and penetration queries between convex shapes, using their support functions.
+     * Both queries work on the Minkowski difference A - B of the cores of the shapes, whose support along a direction d
+     * is support_a(d) - support_b(-d). The shapes overlap if and only if the origin is within the sum of their radii of
+     * the Minkowski difference.
+     */
+    class gjk {
+    public:
+        gjk() = delete;
+
+        /// The maximum number of iterations of a query.
+        static constexpr std::uint32_t max_iterations = 64;
+
+        /**
+         * Finds the distance and the closest points between 2 convex shapes, using the Gilbert-Johnson-Keerthi algorithm.
+         * [A Fast Procedure for Computing the Distance Between Complex Objects in Three-Dimensional Space, Gilbert et al. 1988]
+         * The query finds the closest points of the cores of the shapes, and then moves them towards each other by the radii.
+         * @param _a The first shape.
+         * @param _b The second shape.
+         * @param _simplex If not empty, the simplex is rebuilt on the shapes to start the query. It is replaced with the
+         * simplex the query ends with.
+         * @return The distance and closest points between the shapes.
+         */
+        [[nodiscard]] static gjk_result distance(support_function _a, support_function _b, gjk_simplex& _simplex);
+
+        /**
+         * Finds the distance and the closest points between 2 convex shapes, without warm starting.
+         * @param _a The first shape.
+         * @param _b The second shape.
+         * @return The distance and closest points between the shapes.
+         */
+        [[nodiscard]] static gjk_result distance(support_function _a, support_function _b);
+
+        /**
+         * Finds the penetration depth and direction of 2 convex shapes, using the Expanding Polytope Algorithm.
+         * [Proximity Queries and Penetration Depth Computation on 3D Game Objects, Gino van den Bergen 2001]
+         * A distance query of the cores of the shapes runs first. If the cores are apart, the shapes only overlap by
+         * their radii, and no polytope is needed. Otherwise the polytope starts from the simplex of that query. Its
+         * vertices and faces are kept in fixed size arrays, so nothing is allocated.
+         * @param _a The first shape.
+         * @param _b The second shape.
+         * @param _simplex If not empty, the simplex is rebuilt on the shapes to start the query. It is replaced with the
+         * simplex the distance query of the cores ends with.
+         * @return The penetration depth and direction of the shapes.
+         * @attention Returns std::nullopt if the shapes do not overlap, or if the polytope runs out of space or does not
+         * converge within max_iterations.
+         */
+        [[nodiscard]] static std::optional<epa_result> penetration(support_function _a, support_function _b, gjk_simplex& _simplex);
+
+        /**
+         * Finds the penetration depth and direction of 2 convex shapes, without warm starting.
+         * @param _a The first shape.
+         * @param _b The second shape.
+         * @return The penetration depth and direction of the shapes.
+         * @attention Returns std::nullopt if the shapes do not overlap, or if the polytope runs out of space or does not
+         * converge within max_iterations.
+         */
+        [[nodiscard]] static std::optional<epa_result> penetration(support_function _a, support_function _b);
+    };
+}
@@ -0,0 +1,163 @@
+#include <bit>
+#include "maths/half.h"
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace mkr {
+    namespace {
+        static_assert(sizeof(half) == sizeof(std::uint16_t));
+        static_assert(sizeof(vector3) == 3 * sizeof(float) && sizeof(vector3_half) == 3 * sizeof(half));
+        static_assert(sizeof(colour) == 4 * sizeof(float) && sizeof(colour_half) == 4 * sizeof(half));
+        static_assert(sizeof(matrix4x4) == 16 * sizeof(float) && sizeof(matrix4x4_half) == 16 * sizeof(half));
+
+        std::uint16_t float_to_half_bits(float _value) {
+            /**
+             * [https://gist.github.com/rygorous/2156668]
+             *
+             * Normal results are rounded by adding 0xFFF (plus 1 if the result's lowest mantissa bit is odd) before truncating
+             * the 13 extra mantissa bits, which gives round to nearest, ties to even. A carry out of the mantissa correctly
+             * bumps the exponent, and overflows into infinity.
+             * Subnormal results are rounded by the FPU, by adding a magic number which aligns the mantissa bits we want
+             * with the bottom of the float's mantissa.
+             */
+            constexpr std::uint32_t f32_infinity = 255u << 23;
+            constexpr std::uint32_t f16_max = (127u + 16u) << 23; // 65536.0f, anything equal or larger is infinity.
+            constexpr std::uint32_t min_normal = 113u << 23; // 2^-14, the smallest normal half.
+            constexpr std::uint32_t denorm_magic_bits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+            std::uint32_t bits = std::bit_cast<std::uint32_t>(_value);
+            const std::uint32_t sign = bits & 0x80000000u;
+            bits ^= sign;
+
+            std::uint32_t result;
+            if (bits >= f16_max) {
+                // NaN keeps the top of its payload and becomes quiet, the same as the hardware conversion.
+                result = (bits > f32_infinity) ? (0x7E00u | ((bits >> 13) & 0x3FFu)) : 0x7C00u;
+            } else if (bits < min_normal) {
+                const float denorm_magic = std::bit_cast<float>(denorm_magic_bits);
+                result = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) + denorm_magic) - denorm_magic_bits;
+            } else {
+                const std::uint32_t mantissa_odd = (bits >> 13) & 1u;
+                bits += ((15u - 127u) << 23) + 0xFFFu;
+                bits += mantissa_odd;
+                result = bits >> 13;
+            }
+            return static_cast<std::uint16_t>(result | (sign >> 16));
+        }
+
+        float half_bits_to_float(std::uint16_t _bits) {
+            /**
+             * [https://gist.github.com/rygorous/2144712]
+             *
+             * Shift the exponent and mantissa into place and rebias the exponent.
+             * Infinity and NaN need their exponent to be all 1s, and subnormals are normalised by the FPU.
+             */
+            constexpr std::uint32_t shifted_exponent = 0x7C00u << 13;
+            constexpr std::uint32_t magic_bits = 113u << 23;
+
+            std::uint32_t bits = (static_cast<std::uint32_t>(_bits) & 0x7FFFu) << 13;
+            const std::uint32_t exponent = bits & shifted_exponent;
+            bits += (127u - 15u) << 23;
+            if (exponent == shifted_exponent) {
+                // Infinity or NaN. NaN is made quiet, the same as the hardware conversion.
+                bits += (128u - 16u) << 23;
+                if (bits & 0x007FFFFFu) { bits |= 0x00400000u; }
+            } else if (exponent == 0) {
+                bits += 1u << 23;
+                bits = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) - std::bit_cast<float>(magic_bits));
+            }
+            bits |= (static_cast<std::uint32_t>(_bits) & 0x8000u) << 16;
+            return std::bit_cast<float>(bits);
+        }
+
+        void float_to_half_array(const float* _src, std::uint16_t* _dst, size_t _count) {
+            size_t i = 0;
+#if defined(__F16C__)
+            for (; i + 8 <= _count; i += 8) {
+                const __m128i result = _mm256_cvtps_ph(_mm256_loadu_ps(_src + i), _MM_FROUND_TO_NEAREST_INT);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(_dst + i), result);
+            }
+#endif
+            for (; i < _count; ++i) {
+                _dst[i] = float_to_half_bits(_src[i]);
+            }
+        }
+
+        void half_to_float_array(const std::uint16_t* _src, float* _dst, size_t _count) {
+            size_t i = 0;
+#if defined(__F16C__)
+            for (; i + 8 <= _count; i += 8) {
+                const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_src + i));
+                _mm256_storeu_ps(_dst + i, _mm256_cvtph_ps(values));
+            }
+#endif
+            for (; i < _count; ++i) {
+                _dst[i] = half_bits_to_float(_src[i]);
+            }
+        }
+
+        template<size_t Components, class Float, class Half>
+        void to_half_array(std::span<const Float> _src, std::span<Half> _dst) {
+            float_to_half_array(reinterpret_cast<const float*>(_src.data()),
+                                reinterpret_cast<std::uint16_t*>(_dst.data()),
+                                _src.size() * Components);
+        }
+
+        template<size_t Components, class Half, class Float>
+        void to_float_array(std::span<const Half> _src, std::span<Float> _dst) {
+            half_to_float_array(reinterpret_cast<const std::uint16_t*>(_src.data()),
+                                reinterpret_cast<float*>(_dst.data()),
+                                _src.size() * Components);
+        }
+    }
+
+    half::half(float _value) : bits_(float_to_half_bits(_value)) {}
+
+    float half::to_float() const {
+        return half_bits_to_float(bits_);
+    }
+
+    matrix4x4_half::matrix4x4_half(const matrix4x4& _matrix) {
+        float_to_half_array(_matrix[0], reinterpret_cast<std::uint16_t*>(values_.data()), values_.size());
+    }
+
+    matrix4x4 matrix4x4_half::to_matrix4x4() const {
+        matrix4x4 result;
+        half_to_float_array(reinterpret_cast<const std::uint16_t*>(values_.data()), result[0], values_.size());
+        return result;
+    }
+
+    void half_util::to_half(std::span<const float> _src, std::span<half> _dst) {
+        to_half_array<1>(_src, _dst);
+    }
+
+    void half_util::to_float(std::span<const half> _src, std::span<float> _dst) {
+        to_float_array<1>(_src, _dst);
+    }
+
+    void half_util::to_half(std::span<const vector3> _src, std::span<vector3_half> _dst) {
+        to_half_array<3>(_src, _dst);
+    }
+
+    void half_util::to_float(std::span<const vector3_half> _src, std::span<vector3> _dst) {
+        to_float_array<3>(_src, _dst);
+    }
+
+    void half_util::to_half(std::span<const colour> _src, std::span<colour_half> _dst) {
+        to_half_array<4>(_src, _dst);
+    }
+
+    void half_util::to_float(std::span<const colour_half> _src, std::span<colour> _dst) {
+        to_float_array<4>(_src, _dst);
+    }
+
+    void half_util::to_half(std::span<const matrix4x4> _src, std::span<matrix4x4_half> _dst) {
+        to_half_array<16>(_src, _dst);
+    }
+
+    void half_util::to_float(std::span<const matrix4x4_half> _src, std::span<matrix4x4> _dst) {
+        to_float_array<16>(_src, _dst);
+    }
+}
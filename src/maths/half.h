@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include "maths/vector3.h"
+#include "maths/colour.h"
+#include "maths/matrix.h"
+
+namespace mkr {
+    /**
+     * A 16-bit IEEE 754 half precision floating point number.
+     * This is a storage type only. Convert it to a float to do any arithmetic.
+     *
+     * Layout: 1 sign bit, 5 exponent bits, 10 mantissa bits.
+     */
+    class half {
+    public:
+        /// The raw bits of the half.
+        std::uint16_t bits_;
+
+        /**
+         * Constructs a half with the value of positive zero.
+         */
+        constexpr half() : bits_(0) {}
+
+        /**
+         * Constructs a half from a float, rounding to the nearest representable value (ties to even).
+         * Values too large to be represented become infinity.
+         * @param _value The float value.
+         */
+        explicit half(float _value);
+
+        /**
+         * Constructs a half from its raw bits.
+         * @param _bits The raw bits of the half.
+         * @return The half.
+         */
+        static constexpr half from_bits(std::uint16_t _bits) {
+            half result;
+            result.bits_ = _bits;
+            return result;
+        }
+
+        /**
+         * Returns the value of this half as a float. The conversion is exact.
+         * @return The value of this half as a float.
+         */
+        [[nodiscard]] float to_float() const;
+
+        explicit operator float() const { return to_float(); }
+
+        bool operator==(const half& _rhs) const { return bits_ == _rhs.bits_; }
+
+        bool operator!=(const half& _rhs) const { return bits_ != _rhs.bits_; }
+    };
+
+    /**
+     * Half precision storage for a vector3.
+     */
+    struct vector3_half {
+        half x_;
+        half y_;
+        half z_;
+
+        vector3_half() = default;
+
+        explicit vector3_half(const vector3& _vector)
+                : x_(_vector.x_), y_(_vector.y_), z_(_vector.z_) {}
+
+        [[nodiscard]] vector3 to_vector3() const { return vector3{x_.to_float(), y_.to_float(), z_.to_float()}; }
+    };
+
+    /**
+     * Half precision storage for a colour.
+     */
+    struct colour_half {
+        half r_;
+        half g_;
+        half b_;
+        half a_;
+
+        colour_half() = default;
+
+        explicit colour_half(const colour& _colour)
+                : r_(_colour.r_), g_(_colour.g_), b_(_colour.b_), a_(_colour.a_) {}
+
+        [[nodiscard]] colour to_colour() const {
+            return colour{r_.to_float(), g_.to_float(), b_.to_float(), a_.to_float()};
+        }
+    };
+
+    /**
+     * Half precision storage for a matrix4x4. The elements are stored in the same (column-major) order as matrix4x4.
+     */
+    struct matrix4x4_half {
+        std::array<half, 16> values_;
+
+        matrix4x4_half() = default;
+
+        explicit matrix4x4_half(const matrix4x4& _matrix);
+
+        [[nodiscard]] matrix4x4 to_matrix4x4() const;
+    };
+
+    /**
+     * Batch conversions between single and half precision data.
+     * Uses F16C instructions when the library is compiled with them enabled, else falls back to a software
+     * conversion which gives bit-identical results.
+     */
+    class half_util {
+    public:
+        half_util() = delete;
+
+        /**
+         * Converts an array of floats to halves.
+         * @param _src The floats to convert.
+         * @param _dst The converted halves.
+         * @warning _dst must be at least as large as _src.
+         */
+        static void to_half(std::span<const float> _src, std::span<half> _dst);
+
+        /**
+         * Converts an array of halves to floats.
+         * @param _src The halves to convert.
+         * @param _dst The converted floats.
+         * @warning _dst must be at least as large as _src.
+         */
+        static void to_float(std::span<const half> _src, std::span<float> _dst);
+
+        static void to_half(std::span<const vector3> _src, std::span<vector3_half> _dst);
+
+        static void to_float(std::span<const vector3_half> _src, std::span<vector3> _dst);
+
+        static void to_half(std::span<const colour> _src, std::span<colour_half> _dst);
+
+        static void to_float(std::span<const colour_half> _src, std::span<colour> _dst);
+
+        static void to_half(std::span<const matrix4x4> _src, std::span<matrix4x4_half> _dst);
+
+        static void to_float(std::span<const matrix4x4_half> _src, std::span<matrix4x4> _dst);
+    };
+}
@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <bit>
+#include <future>
+#include <thread>
+#include "maths/kd_tree.h"
+
+namespace mkr {
+    namespace {
+        /// Subtrees with fewer points than this are built on the calling thread.
+        constexpr size_t parallel_threshold = 16384;
+
+        inline float coordinate(const vector3& _point, std::uint8_t _axis) {
+            return (_axis == 0) ? _point.x_ : ((_axis == 1) ? _point.y_ : _point.z_);
+        }
+
+        inline float distance_squared(const vector3& _a, const vector3& _b) {
+            const float x = _a.x_ - _b.x_, y = _a.y_ - _b.y_, z = _a.z_ - _b.z_;
+            return x * x + y * y + z * z;
+        }
+
+        inline bool is_closer(const kd_tree_neighbour& _a, const kd_tree_neighbour& _b) {
+            return _a.distance_squared_ < _b.distance_squared_;
+        }
+
+        struct build_context {
+            std::span<const vector3> points_;
+            std::span<std::uint32_t> indices_;
+            std::span<std::uint8_t> axes_;
+        };
+
+        /**
+         * Builds the subtree of the range [_begin, _end) of the indices, splitting each range along the axis it is widest
+         * on. The 2 halves of large ranges are built on separate threads, until _parallel_depth levels have been split.
+         */
+        void build(const build_context& _context, size_t _begin, size_t _end, size_t _parallel_depth) {
+            if (_end - _begin <= kd_tree::max_leaf_size) { return; }
+
+            vector3 min = _context.points_[_context.indices_[_begin]], max = min;
+            for (size_t i = _begin + 1; i < _end; ++i) {
+                const vector3& point = _context.points_[_context.indices_[i]];
+                min.x_ = maths_util::min(min.x_, point.x_), min.y_ = maths_util::min(min.y_, point.y_), min.z_ = maths_util::min(min.z_, point.z_);
+                max.x_ = maths_util::max(max.x_, point.x_), max.y_ = maths_util::max(max.y_, point.y_), max.z_ = maths_util::max(max.z_, point.z_);
+            }
+            const float x = max.x_ - min.x_, y = max.y_ - min.y_, z = max.z_ - min.z_;
+            const std::uint8_t axis = (x >= y && x >= z) ? 0 : ((y >= z) ? 1 : 2);
+
+            const size_t middle = _begin + (_end - _begin) / 2;
+            std::nth_element(_context.indices_.begin() + static_cast<std::ptrdiff_t>(_begin),
+                             _context.indices_.begin() + static_cast<std::ptrdiff_t>(middle),
+                             _context.indices_.begin() + static_cast<std::ptrdiff_t>(_end),
+                             [&](std::uint32_t _a, std::uint32_t _b) {
+                                 return coordinate(_context.points_[_a], axis) < coordinate(_context.points_[_b], axis);
+                             });
+            _context.axes_[middle] = axis;
+
+            if (_end - _begin < parallel_threshold || _parallel_depth == 0) {
+                build(_context, _begin, middle, 0);
+                build(_context, middle + 1, _end, 0);
+                return;
+            }
+
+            // The 2 halves are disjoint ranges of the indices, so they can be built at the same time.
+            auto left_future = std::async(std::launch::async, build, std::cref(_context), _begin, middle, _parallel_depth - 1);
+            build(_context, middle + 1, _end, _parallel_depth - 1);
+            left_future.get();
+        }
+
+        struct search_context {
+            std::span<const vector3> points_;
+            std::span<const std::uint8_t> axes_;
+            vector3 position_;
+        };
+
+        /**
+         * Searches the subtree of the range [_begin, _end) for a point closer than _best. _best holds the position of the
+         * point in the tree, rather than its index.
+         */
+        void find_nearest(const search_context& _context, size_t _begin, size_t _end, kd_tree_neighbour& _best) {
+            if (_end - _begin <= kd_tree::max_leaf_size) {
+                for (size_t i = _begin; i < _end; ++i) {
+                    const float d = distance_squared(_context.points_[i], _context.position_);
+                    if (d < _best.distance_squared_) { _best = {static_cast<std::uint32_t>(i), d}; }
+                }
+                return;
+            }
+
+            const size_t middle = _begin + (_end - _begin) / 2;
+            const float d = distance_squared(_context.points_[middle], _context.position_);
+            if (d < _best.distance_squared_) { _best = {static_cast<std::uint32_t>(middle), d}; }
+
+            // Search the side of the split containing the position first, then the other side only if it may be closer.
+            const std::uint8_t axis = _context.axes_[middle];
+            const float offset = coordinate(_context.position_, axis) - coordinate(_context.points_[middle], axis);
+            if (offset < 0.0f) {
+                find_nearest(_context, _begin, middle, _best);
+                if (offset * offset < _best.distance_squared_) { find_nearest(_context, middle + 1, _end, _best); }
+            } else {
+                find_nearest(_context, middle + 1, _end, _best);
+                if (offset * offset < _best.distance_squared_) { find_nearest(_context, _begin, middle, _best); }
+            }
+        }
+
+        /**
+         * Searches the subtree of the range [_begin, _end) for the _k closest points. _heap is a max heap of the closest
+         * points found so far, by position in the tree.
+         */
+        void find_k_nearest(const search_context& _context, size_t _begin, size_t _end, size_t _k, std::vector<kd_tree_neighbour>& _heap) {
+            const auto visit = [&](size_t _i) {
+                const float d = distance_squared(_context.points_[_i], _context.position_);
+                if (_heap.size() < _k) {
+                    _heap.push_back({static_cast<std::uint32_t>(_i), d});
+                    std::push_heap(_heap.begin(), _heap.end(), is_closer);
+                } else if (d < _heap.front().distance_squared_) {
+                    std::pop_heap(_heap.begin(), _heap.end(), is_closer);
+                    _heap.back() = {static_cast<std::uint32_t>(_i), d};
+                    std::push_heap(_heap.begin(), _heap.end(), is_closer);
+                }
+            };
+            const auto bound = [&]() {
+                return (_heap.size() < _k) ? std::numeric_limits<float>::infinity() : _heap.front().distance_squared_;
+            };
+
+            if (_end - _begin <= kd_tree::max_leaf_size) {
+                for (size_t i = _begin; i < _end; ++i) { visit(i); }
+                return;
+            }
+
+            const size_t middle = _begin + (_end - _begin) / 2;
+            visit(middle);
+
+            const std::uint8_t axis = _context.axes_[middle];
+            const float offset = coordinate(_context.position_, axis) - coordinate(_context.points_[middle], axis);
+            if (offset < 0.0f) {
+                find_k_nearest(_context, _begin, middle, _k, _heap);
+                if (offset * offset < bound()) { find_k_nearest(_context, middle + 1, _end, _k, _heap); }
+            } else {
+                find_k_nearest(_context, middle + 1, _end, _k, _heap);
+                if (offset * offset < bound()) { find_k_nearest(_context, _begin, middle, _k, _heap); }
+            }
+        }
+
+        void find_within(const search_context& _context, size_t _begin, size_t _end, float _radius_squared,
+                         std::span<const std::uint32_t> _indices, std::vector<std::uint32_t>& _result) {
+            if (_end - _begin <= kd_tree::max_leaf_size) {
+                for (size_t i = _begin; i < _end; ++i) {
+                    if (distance_squared(_context.points_[i], _context.position_) <= _radius_squared) { _result.push_back(_indices[i]); }
+                }
+                return;
+            }
+
+            const size_t middle = _begin + (_end - _begin) / 2;
+            if (distance_squared(_context.points_[middle], _context.position_) <= _radius_squared) { _result.push_back(_indices[middle]); }
+
+            const std::uint8_t axis = _context.axes_[middle];
+            const float offset = coordinate(_context.position_, axis) - coordinate(_context.points_[middle], axis);
+            if (offset <= 0.0f || offset * offset <= _radius_squared) { find_within(_context, _begin, middle, _radius_squared, _indices, _result); }
+            if (offset >= 0.0f || offset * offset <= _radius_squared) { find_within(_context, middle + 1, _end, _radius_squared, _indices, _result); }
+        }
+    }
+
+    kd_tree::kd_tree(std::span<const vector3> _points)
+            : indices_(_points.size()), axes_(_points.size(), 0) {
+        for (size_t i = 0; i < _points.size(); ++i) {
+            indices_[i] = static_cast<std::uint32_t>(i);
+        }
+
+        // Split enough levels in parallel to give every hardware thread a subtree.
+        const size_t parallel_depth = std::bit_width(maths_util::max(1u, std::thread::hardware_concurrency()));
+        build(build_context{_points, indices_, axes_}, 0, _points.size(), parallel_depth);
+
+        points_.reserve(_points.size());
+        for (const std::uint32_t index: indices_) {
+            points_.push_back(_points[index]);
+        }
+    }
+
+    std::optional<kd_tree_neighbour> kd_tree::nearest(const vector3& _position) const {
+        if (points_.empty()) { return std::nullopt; }
+
+        kd_tree_neighbour best{0, std::numeric_limits<float>::infinity()};
+        find_nearest(search_context{points_, axes_, _position}, 0, points_.size(), best);
+        return kd_tree_neighbour{indices_[best.index_], best.distance_squared_};
+    }
+
+    void kd_tree::nearest(const vector3& _position, size_t _k, std::vector<kd_tree_neighbour>& _result) const {
+        _result.clear();
+        if (_k == 0) { return; }
+
+        find_k_nearest(search_context{points_, axes_, _position}, 0, points_.size(), _k, _result);
+        std::sort_heap(_result.begin(), _result.end(), is_closer);
+        for (auto& neighbour: _result) {
+            neighbour.index_ = indices_[neighbour.index_];
+        }
+    }
+
+    void kd_tree::nearest(std::span<const vector3> _positions, std::span<kd_tree_neighbour> _result) const {
+        std::uint32_t previous = 0;
+        for (size_t i = 0; i < _positions.size(); ++i) {
+            // The distance to the previous result bounds the search, so fewer nodes are visited.
+            kd_tree_neighbour best{previous, distance_squared(points_[previous], _positions[i])};
+            find_nearest(search_context{points_, axes_, _positions[i]}, 0, points_.size(), best);
+            previous = best.index_;
+            _result[i] = kd_tree_neighbour{indices_[best.index_], best.distance_squared_};
+        }
+    }
+
+    void kd_tree::query(const vector3& _centre, float _radius, std::vector<std::uint32_t>& _result) const {
+        find_within(search_context{points_, axes_, _centre}, 0, points_.size(), _radius * _radius, indices_, _result);
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "maths/vector3.h"
+
+namespace mkr {
+    /**
+     * A point found by a kd_tree query.
+     */
+    struct kd_tree_neighbour {
+        /// The index of the point, in the span the tree was built from.
+        std::uint32_t index_;
+        /// The squared distance from the query position to the point.
+        float distance_squared_;
+    };
+
+    /**
+     * A static k-d tree over a set of points, for nearest neighbour and radius queries.
+     *
+     * The tree is implicit. The points are reordered so that the point at the middle of each range is the median of the
+     * range along the split axis, the points before it are its left subtree and the points after it are its right
+     * subtree. Only the points, their original indices and the split axis of each node are stored. Ranges of at most
+     * max_leaf_size points are leaves, and are searched linearly. The subtrees of large ranges are built in parallel.
+     */
+    class kd_tree {
+    private:
+        /// The points, reordered into the implicit tree.
+        std::vector<vector3> points_;
+        /// The index of each point of points_ in the span the tree was built from.
+        std::vector<std::uint32_t> indices_;
+        /// The split axis (0, 1 or 2 for x, y or z) of the node at each position of points_. Unused for leaves.
+        std::vector<std::uint8_t> axes_;
+
+    public:
+        /// The maximum number of points in a leaf.
+        static constexpr size_t max_leaf_size = 8;
+
+        /**
+         * Constructs an empty tree.
+         */
+        kd_tree() = default;
+
+        /**
+         * Builds a tree over a set of points.
+         * @param _points The points.
+         */
+        explicit kd_tree(std::span<const vector3> _points);
+
+        /**
+         * Returns the number of points in the tree.
+         * @return The number of points in the tree.
+         */
+        [[nodiscard]] size_t size() const { return points_.size(); }
+
+        /**
+         * Finds the point closest to a position.
+         * @param _position The position.
+         * @return The closest point.
+         * @attention Returns std::nullopt if the tree is empty.
+         */
+        [[nodiscard]] std::optional<kd_tree_neighbour> nearest(const vector3& _position) const;
+
+        /**
+         * Finds the k points closest to a position.
+         * @param _position The position.
+         * @param _k The number of points to find.
+         * @param _result Replaced with the min(k, size()) closest points, closest first.
+         */
+        void nearest(const vector3& _position, size_t _k, std::vector<kd_tree_neighbour>& _result) const;
+
+        /**
+         * Finds the point closest to each of many positions.
+         * Each search starts with the result of the previous position as its closest point so far, so the search skips
+         * most of the tree when consecutive positions are close together, such as the points of a scan in order.
+         * @param _positions The positions.
+         * @param _result The closest point to each position.
+         * @warning The tree must not be empty, and _positions and _result must be the same size.
+         */
+        void nearest(std::span<const vector3> _positions, std::span<kd_tree_neighbour> _result) const;
+
+        /**
+         * Finds every point within a distance of a position.
+         * @param _centre The position.
+         * @param _radius The distance.
+         * @param _result The indices of the points, in the span the tree was built from, are appended to _result.
+         */
+        void query(const vector3& _centre, float _radius, std::vector<std::uint32_t>& _result) const;
+    };
+}
@@ -1,4 +1,5 @@
 #include "maths/line.h"
+#include "maths/vector3_block.h"
 
 namespace mkr {
     line::line(const vector3& _point, const vector3& _direction)
@@ -51,16 +52,78 @@ namespace mkr {
          * There's 2 unknowns in our equations, C and λ, so let's get rid of one unknown.
          *
          * Subbing (1) into (2), we get the equation
-         * (P - A + λD)·D = 0
-         * (P - A)·D + λD·D = 0
-         * (P - A)·D = -λD·D
-         * (A - P)·D = λD·D
-         * λ = [(A - P)·D]/(D·D)
+         * (P - A - λD)·D = 0
+         * (P - A)·D - λD·D = 0
+         * (P - A)·D = λD·D
+         * λ = [(P - A)·D]/(D·D)
          *
-         * Therefore, C = A + {[(A - P)·D]/(D·D)}D
+         * Therefore, C = A + {[(P - A)·D]/(D·D)}D
          */
 
-        const float lambda = direction_.dot(this->point_ - _point) / direction_.length_squared();
+        const float lambda = direction_.dot(_point - this->point_) / direction_.length_squared();
         return point_ + lambda * direction_;
     }
+
+    std::optional<std::pair<vector3, vector3>> line::closest_points(const line& _line) const {
+        if (is_parallel(_line)) {
+            return std::nullopt;
+        }
+
+        float lambda, mu;
+        closest_points(std::span<const line>{&_line, 1}, std::span<float>{&lambda, 1}, std::span<float>{&mu, 1});
+        return std::make_pair(point_ + direction_ * lambda, _line.point_ + _line.direction_ * mu);
+    }
+
+    void line::closest_points(std::span<const line> _lines, std::span<float> _lambda, std::span<float> _mu) const {
+        /**
+         * Let the lines be P + λD and Q + μE, and R = P - Q.
+         * The line between the closest points is perpendicular to both lines.
+         * (R + λD - μE)·D = 0
+         * (R + λD - μE)·E = 0
+         *
+         * Let a = D·D, b = D·E, c = D·R, e = E·E and f = E·R.
+         * aλ - bμ = -c
+         * bλ - eμ = -f
+         *
+         * Solving the 2 equations,
+         * λ = (bf - ce) / (ae - b²)
+         * μ = (bλ + f) / e
+         *
+         * If the lines are parallel, ae - b² is 0, and λ is set to 0.
+         *
+         * The lines are copied into vector3_blocks, and the loop over each block has no branches, so that it can be
+         * vectorised.
+         */
+        constexpr float epsilon = std::numeric_limits<float>::epsilon();
+        const float px = point_.x_, py = point_.y_, pz = point_.z_;
+        const float dx = direction_.x_, dy = direction_.y_, dz = direction_.z_;
+        const float a = dx * dx + dy * dy + dz * dz;
+
+        vector3_block points, directions;
+        vector3_block::for_each_block(_lines.size(), [&](size_t _block_start, size_t _block_size) {
+            for (size_t i = 0; i < _block_size; ++i) {
+                const line& other = _lines[_block_start + i];
+                points.set(i, other.point_);
+                directions.set(i, other.direction_);
+            }
+
+            float* __restrict lambda_out = &_lambda[_block_start];
+            float* __restrict mu_out = &_mu[_block_start];
+            for (size_t i = 0; i < _block_size; ++i) {
+                const float ex = directions.x_[i], ey = directions.y_[i], ez = directions.z_[i];
+                const float rx = px - points.x_[i], ry = py - points.y_[i], rz = pz - points.z_[i];
+                const float b = dx * ex + dy * ey + dz * ez;
+                const float c = dx * rx + dy * ry + dz * rz;
+                const float e = ex * ex + ey * ey + ez * ez;
+                const float f = ex * rx + ey * ry + ez * rz;
+                const float denominator = a * e - b * b;
+
+                // Dividing by 1 instead of 0 and then selecting 0 keeps the division unconditional.
+                const bool is_parallel = denominator <= epsilon * a * e;
+                const float lambda = is_parallel ? 0.0f : (b * f - c * e) / (is_parallel ? 1.0f : denominator);
+                lambda_out[i] = lambda;
+                mu_out[i] = (b * lambda + f) / e;
+            }
+        });
+    }
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
 #include <optional>
+#include <span>
+#include <utility>
 #include "maths/vector3.h"
 
 namespace mkr {
@@ -86,5 +89,71 @@ namespace mkr {
          * @return The point on this line closest to a given point.
          */
         [[nodiscard]] vector3 closest_point(const vector3& _point) const;
+
+        /**
+         * Returns the closest points between 2 lines.
+         * @param _line The other line.
+         * @return The point on this line, and the point on _line, which are closest to each other.
+         * @attention Returns std::nullopt if the lines are parallel, as every point is then equally close.
+         */
+        [[nodiscard]] std::optional<std::pair<vector3, vector3>> closest_points(const line& _line) const;
+
+        /**
+         * Finds the closest points between this line and many lines.
+         * The closest points are P + λD on this line and Q + μE on the other line, where P, D, Q and E are the points and
+         * directions of the lines.
+         * @param _lines The other lines.
+         * @param _lambda The value of λ for each line. If the lines are parallel, λ is 0.
+         * @param _mu The value of μ for each line.
+         * @warning _lines, _lambda and _mu must be the same size.
+         */
+        void closest_points(std::span<const line> _lines, std::span<float> _lambda, std::span<float> _mu) const;
+    };
+
+    /**
+     * A packet of N lines stored as a structure of arrays, so that they can be tested against the same shape together.
+     */
+    template<size_t N>
+    class line_packet {
+    public:
+        /// The number of lines in a packet.
+        static constexpr size_t width = N;
+
+        std::array<float, N> point_x_{};
+        std::array<float, N> point_y_{};
+        std::array<float, N> point_z_{};
+        std::array<float, N> direction_x_{};
+        std::array<float, N> direction_y_{};
+        std::array<float, N> direction_z_{};
+
+        /**
+         * Constructs a packet of lines with a zero direction.
+         */
+        line_packet() = default;
+
+        /**
+         * Constructs a packet of lines. If there are fewer than N lines, the remaining lines have a zero direction.
+         * @param _lines The lines.
+         * @warning _lines must not have more than N lines.
+         */
+        explicit line_packet(std::span<const line> _lines) {
+            for (size_t i = 0; i < _lines.size(); ++i) {
+                set(i, _lines[i]);
+            }
+        }
+
+        /**
+         * Set a line of the packet.
+         * @param _index The index of the line.
+         * @param _line The line.
+         */
+        void set(size_t _index, const line& _line) {
+            point_x_[_index] = _line.point_.x_;
+            point_y_[_index] = _line.point_.y_;
+            point_z_[_index] = _line.point_.z_;
+            direction_x_[_index] = _line.direction_.x_;
+            direction_y_[_index] = _line.direction_.y_;
+            direction_z_[_index] = _line.direction_.z_;
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "maths/loose_octree.h"
+
+namespace mkr {
+    namespace {
+        /// How much of the space of a node a node test found to be inside a query.
+        enum class containment {
+            outside,
+            intersects,
+            inside,
+        };
+
+        /// Checks if a box is completely in front of a plane (on the side the normal points to).
+        bool is_in_front(const aabb& _box, const plane& _plane) {
+            // The corner furthest against the normal is the last part of the box to go in front of the plane.
+            const vector3 corner{_plane.normal_.x_ >= 0.0f ? _box.min_.x_ : _box.max_.x_,
+                                 _plane.normal_.y_ >= 0.0f ? _box.min_.y_ : _box.max_.y_,
+                                 _plane.normal_.z_ >= 0.0f ? _box.min_.z_ : _box.max_.z_};
+            return _plane.normal_.dot(corner) + _plane.d_ >= 0.0f;
+        }
+
+        /// Returns the largest of the half extents of a box along each axis.
+        float half_size(const aabb& _box) {
+            return maths_util::max(maths_util::max(_box.max_.x_ - _box.min_.x_, _box.max_.y_ - _box.min_.y_), _box.max_.z_ - _box.min_.z_) * 0.5f;
+        }
+    }
+
+    loose_octree::loose_octree(const aabb& _bounds, std::uint32_t _max_depth)
+            : max_depth_(_max_depth) {
+        nodes_.push_back(node{_bounds.centre(), half_size(_bounds), 0, invalid_handle, {}, invalid_handle, 0});
+        nodes_[0].children_.fill(invalid_handle);
+    }
+
+    bool loose_octree::fits(const node& _node, const aabb& _bounds) const {
+        // The node must contain the centre of the object, be at least as large as the object, and its children must be too small.
+        const float size = half_size(_bounds);
+        const vector3 centre = _bounds.centre();
+        return std::fabs(centre.x_ - _node.centre_.x_) <= _node.half_size_ &&
+               std::fabs(centre.y_ - _node.centre_.y_) <= _node.half_size_ &&
+               std::fabs(centre.z_ - _node.centre_.z_) <= _node.half_size_ &&
+               size <= _node.half_size_ && (_node.depth_ == max_depth_ || size > _node.half_size_ * 0.5f);
+    }
+
+    std::uint32_t loose_octree::create_node(std::uint32_t _parent, size_t _octant) {
+        const node& parent = nodes_[_parent];
+        const float half_size = parent.half_size_ * 0.5f;
+        node child{vector3{parent.centre_.x_ + ((_octant & 1) ? half_size : -half_size),
+                           parent.centre_.y_ + ((_octant & 2) ? half_size : -half_size),
+                           parent.centre_.z_ + ((_octant & 4) ? half_size : -half_size)},
+                   half_size, parent.depth_ + 1, _parent, {}, invalid_handle, 0};
+        child.children_.fill(invalid_handle);
+
+        // Unused nodes form a linked list through their parent.
+        std::uint32_t index = free_node_;
+        if (index == invalid_handle) {
+            index = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.push_back(child);
+        } else {
+            free_node_ = nodes_[index].parent_;
+            nodes_[index] = child;
+        }
+        nodes_[_parent].children_[_octant] = index;
+        return index;
+    }
+
+    void loose_octree::link(std::uint32_t _handle) {
+        object& o = objects_[_handle];
+        const float size = half_size(o.bounds_);
+        const vector3 centre = o.bounds_.centre();
+
+        // Go down while the child containing the centre of the object is at least as large as the object.
+        std::uint32_t current = 0;
+        while (nodes_[current].depth_ < max_depth_ && size <= nodes_[current].half_size_ * 0.5f) {
+            const node& n = nodes_[current];
+            if (std::fabs(centre.x_ - n.centre_.x_) > n.half_size_ ||
+                std::fabs(centre.y_ - n.centre_.y_) > n.half_size_ ||
+                std::fabs(centre.z_ - n.centre_.z_) > n.half_size_) {
+                break;
+            }
+
+            const size_t octant = (centre.x_ >= n.centre_.x_ ? 1 : 0) | (centre.y_ >= n.centre_.y_ ? 2 : 0) | (centre.z_ >= n.centre_.z_ ? 4 : 0);
+            const std::uint32_t child = n.children_[octant];
+            current = (child == invalid_handle) ? create_node(current, octant) : child;
+        }
+
+        node& n = nodes_[current];
+        o.node_ = current;
+        o.previous_ = invalid_handle;
+        o.next_ = n.first_object_;
+        if (n.first_object_ != invalid_handle) { objects_[n.first_object_].previous_ = _handle; }
+        n.first_object_ = _handle;
+
+        for (std::uint32_t i = current; i != invalid_handle; i = nodes_[i].parent_) {
+            ++nodes_[i].count_;
+        }
+    }
+
+    void loose_octree::unlink(std::uint32_t _handle) {
+        const object& o = objects_[_handle];
+        if (o.previous_ != invalid_handle) {
+            objects_[o.previous_].next_ = o.next_;
+        } else {
+            nodes_[o.node_].first_object_ = o.next_;
+        }
+        if (o.next_ != invalid_handle) { objects_[o.next_].previous_ = o.previous_; }
+
+        // Return nodes left without objects to the pool. Their children have already been returned.
+        std::uint32_t current = o.node_;
+        while (current != invalid_handle) {
+            node& n = nodes_[current];
+            const std::uint32_t parent = n.parent_;
+            if (--n.count_ == 0 && parent != invalid_handle) {
+                for (auto& child: nodes_[parent].children_) {
+                    if (child == current) { child = invalid_handle; }
+                }
+                n.parent_ = free_node_;
+                free_node_ = current;
+            }
+            current = parent;
+        }
+    }
+
+    std::uint32_t loose_octree::insert(const aabb& _bounds) {
+        // Unused objects form a linked list through their next object.
+        std::uint32_t handle = free_object_;
+        if (handle == invalid_handle) {
+            handle = static_cast<std::uint32_t>(objects_.size());
+            objects_.push_back(object{_bounds, invalid_handle, invalid_handle, invalid_handle});
+        } else {
+            free_object_ = objects_[handle].next_;
+            objects_[handle].bounds_ = _bounds;
+        }
+
+        link(handle);
+        ++size_;
+        return handle;
+    }
+
+    void loose_octree::update(std::uint32_t _handle, const aabb& _bounds) {
+        object& o = objects_[_handle];
+        o.bounds_ = _bounds;
+        if (fits(nodes_[o.node_], _bounds)) { return; }
+
+        unlink(_handle);
+        link(_handle);
+    }
+
+    void loose_octree::remove(std::uint32_t _handle) {
+        unlink(_handle);
+        object& o = objects_[_handle];
+        o.node_ = invalid_handle;
+        o.next_ = free_object_;
+        free_object_ = _handle;
+        --size_;
+    }
+
+    template<typename NodeTest, typename ObjectTest>
+    void loose_octree::query(std::uint32_t _node, bool _inside, NodeTest _node_test, ObjectTest _object_test, std::vector<std::uint32_t>& _result) const {
+        const node& n = nodes_[_node];
+
+        // The root also holds the objects outside the bounds of the tree, so it is never skipped.
+        bool inside = _inside;
+        if (!inside && _node != 0) {
+            const float loose_size = n.half_size_ * 2.0f;
+            const containment c = _node_test(aabb{vector3{n.centre_.x_ - loose_size, n.centre_.y_ - loose_size, n.centre_.z_ - loose_size},
+                                                  vector3{n.centre_.x_ + loose_size, n.centre_.y_ + loose_size, n.centre_.z_ + loose_size}});
+            if (c == containment::outside) { return; }
+            inside = (c == containment::inside);
+        }
+
+        for (std::uint32_t i = n.first_object_; i != invalid_handle; i = objects_[i].next_) {
+            if (inside || _object_test(objects_[i].bounds_)) { _result.push_back(i); }
+        }
+        for (const std::uint32_t child: n.children_) {
+            if (child != invalid_handle) { query(child, inside, _node_test, _object_test, _result); }
+        }
+    }
+
+    void loose_octree::query(const aabb& _box, std::vector<std::uint32_t>& _result) const {
+        const auto overlaps = [&](const aabb& _bounds) { return _box.overlaps(_bounds); };
+        query(0, false, [&](const aabb& _bounds) { return overlaps(_bounds) ? containment::intersects : containment::outside; }, overlaps, _result);
+    }
+
+    void loose_octree::query(const line& _line, std::vector<std::uint32_t>& _result) const {
+        const auto intersects = [&](const aabb& _bounds) {
+            const auto range = _bounds.intersect(_line);
+            return range && range->second >= 0.0f;
+        };
+        query(0, false, [&](const aabb& _bounds) { return intersects(_bounds) ? containment::intersects : containment::outside; }, intersects, _result);
+    }
+
+    void loose_octree::query(std::span<const plane> _planes, std::vector<std::uint32_t>& _result) const {
+        const auto node_test = [&](const aabb& _bounds) {
+            containment result = containment::inside;
+            for (const auto& p: _planes) {
+                if (_bounds.is_behind(p)) { return containment::outside; }
+                if (!is_in_front(_bounds, p)) { result = containment::intersects; }
+            }
+            return result;
+        };
+        const auto object_test = [&](const aabb& _bounds) {
+            for (const auto& p: _planes) {
+                if (_bounds.is_behind(p)) { return false; }
+            }
+            return true;
+        };
+        query(0, false, node_test, object_test, _result);
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "maths/aabb.h"
+
+namespace mkr {
+    /**
+     * A loose octree of boxes, for scenes where objects are added, moved and removed every frame.
+     *
+     * Each node covers a cube of space, and its loose bounds are that cube doubled in size around the same centre. An
+     * object is stored in the deepest node whose cube contains the centre of the object and whose size is at least the
+     * size of the object, so the object always lies inside the loose bounds of its node. Moving an object only needs to
+     * find a new node when its centre leaves the cube of its node, which is cheap for small movements.
+     *
+     * Nodes and objects are stored in pools, and reuse the slots of removed nodes and objects, so a scene with a steady
+     * number of objects allocates nothing. The objects of each node form a linked list through the object pool.
+     * Objects outside the bounds of the tree are stored in the root.
+     */
+    class loose_octree {
+    public:
+        /// The handle of an object which is not in the tree.
+        static constexpr std::uint32_t invalid_handle = std::numeric_limits<std::uint32_t>::max();
+
+    private:
+        struct node {
+            /// The centre of the cube the node covers.
+            vector3 centre_;
+            /// Half the size of the cube the node covers.
+            float half_size_;
+            std::uint32_t depth_;
+            std::uint32_t parent_;
+            /// The children of the node, indexed by octant, or invalid_handle.
+            std::array<std::uint32_t, 8> children_;
+            /// The first object of the node, or invalid_handle.
+            std::uint32_t first_object_;
+            /// The number of objects in the node and all its descendants.
+            std::uint32_t count_;
+        };
+
+        struct object {
+            aabb bounds_;
+            /// The node the object is in, or invalid_handle if the slot is unused.
+            std::uint32_t node_;
+            std::uint32_t previous_;
+            /// The next object of the node, or the next unused slot if the slot is unused.
+            std::uint32_t next_;
+        };
+
+        std::vector<node> nodes_;
+        std::vector<object> objects_;
+        std::uint32_t free_node_ = invalid_handle;
+        std::uint32_t free_object_ = invalid_handle;
+        std::uint32_t max_depth_;
+        size_t size_ = 0;
+
+        [[nodiscard]] bool fits(const node& _node, const aabb& _bounds) const;
+
+        std::uint32_t create_node(std::uint32_t _parent, size_t _octant);
+
+        void link(std::uint32_t _handle);
+
+        void unlink(std::uint32_t _handle);
+
+        template<typename NodeTest, typename ObjectTest>
+        void query(std::uint32_t _node, bool _inside, NodeTest _node_test, ObjectTest _object_test, std::vector<std::uint32_t>& _result) const;
+
+    public:
+        /**
+         * Constructs an empty tree.
+         * @param _bounds The space the tree covers. The tree covers the smallest cube around the centre of _bounds containing it.
+         * @param _max_depth The maximum depth of the tree. The root is at depth 0.
+         */
+        explicit loose_octree(const aabb& _bounds, std::uint32_t _max_depth = 8);
+
+        /**
+         * Returns the number of objects in the tree.
+         * @return The number of objects in the tree.
+         */
+        [[nodiscard]] size_t size() const { return size_; }
+
+        /**
+         * Returns the bounds of an object.
+         * @param _handle The handle of the object.
+         * @return The bounds of the object.
+         */
+        [[nodiscard]] const aabb& bounds(std::uint32_t _handle) const { return objects_[_handle].bounds_; }
+
+        /**
+         * Adds an object to the tree.
+         * @param _bounds The bounds of the object.
+         * @return The handle of the object. Handles of removed objects are reused.
+         */
+        std::uint32_t insert(const aabb& _bounds);
+
+        /**
+         * Changes the bounds of an object. The object only moves to another node if it no longer fits its node.
+         * @param _handle The handle of the object.
+         * @param _bounds The new bounds of the object.
+         */
+        void update(std::uint32_t _handle, const aabb& _bounds);
+
+        /**
+         * Removes an object from the tree. Nodes left without objects are returned to the pool.
+         * @param _handle The handle of the object.
+         */
+        void remove(std::uint32_t _handle);
+
+        /**
+         * Finds every object whose bounds overlap a box.
+         * @param _box The box.
+         * @param _result The handles of the objects are appended to _result.
+         */
+        void query(const aabb& _box, std::vector<std::uint32_t>& _result) const;
+
+        /**
+         * Finds every object whose bounds are intersected by a line, where λ >= 0.
+         * @param _line The line.
+         * @param _result The handles of the objects are appended to _result.
+         */
+        void query(const line& _line, std::vector<std::uint32_t>& _result) const;
+
+        /**
+         * Finds every object whose bounds are not completely behind any of a set of planes, such as the planes of a
+         * view frustum with their normals pointing inwards. Subtrees completely in front of every plane are added without
+         * testing their objects.
+         * @param _planes The planes.
+         * @param _result The handles of the objects are appended to _result.
+         */
+        void query(std::span<const plane> _planes, std::vector<std::uint32_t>& _result) const;
+    };
+}
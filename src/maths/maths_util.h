@@ -75,6 +75,22 @@ namespace mkr {
             return _val;
         }
 
+        /**
+         * Computes the sine and cosine of an angle together.
+         * On GCC and Clang, this is a single call which shares the argument reduction between both results.
+         * @param _angle The angle in radians.
+         * @param _sin The sine of the angle.
+         * @param _cos The cosine of the angle.
+         */
+        static void sincos(float _angle, float& _sin, float& _cos) {
+#if defined(__GNUC__)
+            __builtin_sincosf(_angle, &_sin, &_cos);
+#else
+            _sin = std::sin(_angle);
+            _cos = std::cos(_angle);
+#endif
+        }
+
         /**
          * Checks if 2 floating point numbers are approximately equal. Useful for dealing with floating point errors.
          * @tparam T The floating point type.
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <array>
 #include <optional>
 #include "maths/matrix.h"
 #include "maths/maths_util.h"
+#include "maths/plane.h"
 #include "maths/vector3.h"
 
 namespace mkr {
@@ -683,5 +685,32 @@ namespace mkr {
 
             return mat;
         }
+
+        /**
+         * Returns the clipping planes of a view frustum, with their normals pointing into the frustum.
+         * [Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix, Gribb & Hartmann 2001]
+         * @param _view_projection The projection matrix multiplied by the view matrix, with clip space z in [-1, 1].
+         * @return The left, right, bottom, top, near and far planes, which are not normalised.
+         */
+        static std::array<plane, 6> frustum_planes(const matrix4x4& _view_projection) {
+            /**
+             * A point P is inside the frustum if -w <= x, y, z <= w, where (x, y, z, w) = M(P, 1).
+             * Let row i of M be Ri, so that x = R0·(P, 1), and so on.
+             *
+             * -w <= x is (R3 + R0)·(P, 1) >= 0, which is the left plane, with its normal pointing inwards.
+             * x <= w is (R3 - R0)·(P, 1) >= 0, which is the right plane, and likewise for y and z.
+             */
+            const auto row = [&](size_t _row) {
+                return std::array<float, 4>{_view_projection[0][_row], _view_projection[1][_row], _view_projection[2][_row], _view_projection[3][_row]};
+            };
+            const std::array<float, 4> w = row(3);
+            const auto make_plane = [&](size_t _axis, float _sign) {
+                const std::array<float, 4> r = row(_axis);
+                return plane{vector3{w[0] + _sign * r[0], w[1] + _sign * r[1], w[2] + _sign * r[2]}, w[3] + _sign * r[3]};
+            };
+            return {make_plane(0, 1.0f), make_plane(0, -1.0f),
+                    make_plane(1, 1.0f), make_plane(1, -1.0f),
+                    make_plane(2, 1.0f), make_plane(2, -1.0f)};
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,256 @@
+#include <array>
+#include <cmath>
+#include "maths/packed_colour.h"
+
+// SSE2 is part of x86-64, but MSVC does not define __SSE2__ for it.
+#if defined(__SSE2__) || defined(_M_X64)
+#define MKR_MATHS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace mkr {
+    namespace {
+        static_assert(sizeof(colour_rgba8) == sizeof(std::uint32_t) && sizeof(colour_rgb10a2) == sizeof(std::uint32_t));
+        static_assert(sizeof(colour) == 4 * sizeof(float));
+
+        /**
+         * The layout of a packed colour, as a 32 bit integer whose components are at the given shifts, in the order RGBA.
+         * The SSE2 kernels read and write the integers directly, which for colour_rgba8 relies on x86 being little
+         * endian. The scalar conversions go through to_bits and from_bits, which do not.
+         */
+        struct rgba8_format {
+            using packed_type = colour_rgba8;
+            static constexpr std::array<std::uint32_t, 4> shifts{0, 8, 16, 24};
+            static constexpr std::array<std::uint32_t, 4> maxima{255, 255, 255, 255};
+
+            static std::uint32_t to_bits(const colour_rgba8& _colour) {
+                return static_cast<std::uint32_t>(_colour.r_) | (static_cast<std::uint32_t>(_colour.g_) << 8) |
+                       (static_cast<std::uint32_t>(_colour.b_) << 16) | (static_cast<std::uint32_t>(_colour.a_) << 24);
+            }
+
+            static colour_rgba8 from_bits(std::uint32_t _bits) {
+                return colour_rgba8{static_cast<std::uint8_t>(_bits), static_cast<std::uint8_t>(_bits >> 8),
+                                    static_cast<std::uint8_t>(_bits >> 16), static_cast<std::uint8_t>(_bits >> 24)};
+            }
+        };
+
+        struct rgb10a2_format {
+            using packed_type = colour_rgb10a2;
+            static constexpr std::array<std::uint32_t, 4> shifts{0, 10, 20, 30};
+            static constexpr std::array<std::uint32_t, 4> maxima{1023, 1023, 1023, 3};
+
+            static std::uint32_t to_bits(const colour_rgb10a2& _colour) { return _colour.bits_; }
+
+            static colour_rgb10a2 from_bits(std::uint32_t _bits) {
+                colour_rgb10a2 result;
+                result.bits_ = _bits;
+                return result;
+            }
+        };
+
+        /// Clamps _value to [0, 1], with NaN becoming 0, the same as _mm_min_ps(_mm_max_ps(_value, 0), 1).
+        inline float saturate(float _value) {
+            _value = (_value > 0.0f) ? _value : 0.0f;
+            return (_value < 1.0f) ? _value : 1.0f;
+        }
+
+        /**
+         * Rounds a component in [0, 1] to an unsigned normalised integer in [0, _max].
+         * The product is rounded to a float before being rounded to the nearest integer in the current rounding mode,
+         * the same as _mm_cvtps_epi32(_mm_mul_ps(_value, _max)). Adding 0.5 and truncating instead would allow the
+         * compiler to fuse the multiply and add, which would change the results of some ties.
+         */
+        inline std::uint32_t to_unorm(float _value, std::uint32_t _max) {
+            return static_cast<std::uint32_t>(std::lrint(_value * static_cast<float>(_max)));
+        }
+
+        template<class Format, bool Premultiplied>
+        std::uint32_t pack_colour(const colour& _colour) {
+            constexpr auto& shifts = Format::shifts;
+            constexpr auto& maxima = Format::maxima;
+            float r = saturate(_colour.r_), g = saturate(_colour.g_), b = saturate(_colour.b_);
+            const std::uint32_t a = to_unorm(saturate(_colour.a_), maxima[3]);
+            if constexpr (Premultiplied) {
+                // RGB is multiplied by the alpha which is stored, not the alpha given, so that the packed colour is
+                // valid (RGB is never more than alpha) and unpremultiplies back to the original RGB.
+                const float stored_alpha = static_cast<float>(a) * (1.0f / static_cast<float>(maxima[3]));
+                r *= stored_alpha;
+                g *= stored_alpha;
+                b *= stored_alpha;
+            }
+            return (to_unorm(r, maxima[0]) << shifts[0]) | (to_unorm(g, maxima[1]) << shifts[1]) |
+                   (to_unorm(b, maxima[2]) << shifts[2]) | (a << shifts[3]);
+        }
+
+        template<class Format, bool Premultiplied>
+        colour unpack_colour(std::uint32_t _bits) {
+            constexpr auto& shifts = Format::shifts;
+            constexpr auto& maxima = Format::maxima;
+            std::array<float, 4> components;
+            for (size_t i = 0; i < 4; ++i) {
+                components[i] = static_cast<float>((_bits >> shifts[i]) & maxima[i]) * (1.0f / static_cast<float>(maxima[i]));
+            }
+            const float a = components[3];
+            if constexpr (Premultiplied) {
+                for (size_t i = 0; i < 3; ++i) {
+                    components[i] = (a > 0.0f) ? components[i] / a : 0.0f;
+                }
+            }
+            return colour{components[0], components[1], components[2], a};
+        }
+
+#if defined(MKR_MATHS_SSE2)
+        /**
+         * Packs 4 colours at a time, and returns the number of colours packed.
+         * The colours are transposed into a register for each component, so that each component is scaled, rounded and
+         * shifted into place for all 4 colours at once, and the packed colours are written with a single store.
+         */
+        template<class Format, bool Premultiplied>
+        size_t pack_sse2(const colour* _src, void* _dst, size_t _count) {
+            constexpr auto& shifts = Format::shifts;
+            constexpr auto& maxima = Format::maxima;
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const auto saturate = [&](__m128 _value) { return _mm_min_ps(_mm_max_ps(_value, zero), one); };
+            const auto to_unorm = [](__m128 _value, std::uint32_t _max) {
+                return _mm_cvtps_epi32(_mm_mul_ps(_value, _mm_set1_ps(static_cast<float>(_max))));
+            };
+            const auto to_bits = [&](__m128 _value, std::uint32_t _max, std::uint32_t _shift) {
+                return _mm_slli_epi32(to_unorm(_value, _max), static_cast<int>(_shift));
+            };
+
+            size_t i = 0;
+            for (; i + 4 <= _count; i += 4) {
+                const float* src = &_src[i].r_;
+                __m128 r = _mm_loadu_ps(src);
+                __m128 g = _mm_loadu_ps(src + 4);
+                __m128 b = _mm_loadu_ps(src + 8);
+                __m128 a = _mm_loadu_ps(src + 12);
+                _MM_TRANSPOSE4_PS(r, g, b, a);
+
+                r = saturate(r);
+                g = saturate(g);
+                b = saturate(b);
+                const __m128i alpha = to_unorm(saturate(a), maxima[3]);
+                if constexpr (Premultiplied) {
+                    const __m128 stored_alpha = _mm_mul_ps(_mm_cvtepi32_ps(alpha), _mm_set1_ps(1.0f / static_cast<float>(maxima[3])));
+                    r = _mm_mul_ps(r, stored_alpha);
+                    g = _mm_mul_ps(g, stored_alpha);
+                    b = _mm_mul_ps(b, stored_alpha);
+                }
+
+                const __m128i packed = _mm_or_si128(_mm_or_si128(to_bits(r, maxima[0], shifts[0]), to_bits(g, maxima[1], shifts[1])),
+                                                    _mm_or_si128(to_bits(b, maxima[2], shifts[2]), _mm_slli_epi32(alpha, static_cast<int>(shifts[3]))));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(static_cast<std::uint32_t*>(_dst) + i), packed);
+            }
+            return i;
+        }
+
+        /**
+         * Unpacks 4 colours at a time, and returns the number of colours unpacked.
+         * The reverse of pack_sse2.
+         */
+        template<class Format, bool Premultiplied>
+        size_t unpack_sse2(const void* _src, colour* _dst, size_t _count) {
+            constexpr auto& shifts = Format::shifts;
+            constexpr auto& maxima = Format::maxima;
+            const auto to_float = [](__m128i _packed, std::uint32_t _max, std::uint32_t _shift) {
+                const __m128i value = _mm_and_si128(_mm_srli_epi32(_packed, static_cast<int>(_shift)), _mm_set1_epi32(static_cast<int>(_max)));
+                return _mm_mul_ps(_mm_cvtepi32_ps(value), _mm_set1_ps(1.0f / static_cast<float>(_max)));
+            };
+
+            size_t i = 0;
+            for (; i + 4 <= _count; i += 4) {
+                const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(static_cast<const std::uint32_t*>(_src) + i));
+                __m128 r = to_float(packed, maxima[0], shifts[0]);
+                __m128 g = to_float(packed, maxima[1], shifts[1]);
+                __m128 b = to_float(packed, maxima[2], shifts[2]);
+                __m128 a = to_float(packed, maxima[3], shifts[3]);
+                if constexpr (Premultiplied) {
+                    // Dividing by an alpha of 0 gives NaN or infinity, which the mask replaces with 0.
+                    const __m128 opaque = _mm_cmpgt_ps(a, _mm_setzero_ps());
+                    r = _mm_and_ps(_mm_div_ps(r, a), opaque);
+                    g = _mm_and_ps(_mm_div_ps(g, a), opaque);
+                    b = _mm_and_ps(_mm_div_ps(b, a), opaque);
+                }
+                _MM_TRANSPOSE4_PS(r, g, b, a);
+
+                float* dst = &_dst[i].r_;
+                _mm_storeu_ps(dst, r);
+                _mm_storeu_ps(dst + 4, g);
+                _mm_storeu_ps(dst + 8, b);
+                _mm_storeu_ps(dst + 12, a);
+            }
+            return i;
+        }
+#endif
+
+        template<class Format, bool Premultiplied>
+        void pack_array(std::span<const colour> _src, std::span<typename Format::packed_type> _dst) {
+            size_t i = 0;
+#if defined(MKR_MATHS_SSE2)
+            i = pack_sse2<Format, Premultiplied>(_src.data(), _dst.data(), _src.size());
+#endif
+            for (; i < _src.size(); ++i) {
+                _dst[i] = Format::from_bits(pack_colour<Format, Premultiplied>(_src[i]));
+            }
+        }
+
+        template<class Format, bool Premultiplied>
+        void unpack_array(std::span<const typename Format::packed_type> _src, std::span<colour> _dst) {
+            size_t i = 0;
+#if defined(MKR_MATHS_SSE2)
+            i = unpack_sse2<Format, Premultiplied>(_src.data(), _dst.data(), _src.size());
+#endif
+            for (; i < _src.size(); ++i) {
+                _dst[i] = unpack_colour<Format, Premultiplied>(Format::to_bits(_src[i]));
+            }
+        }
+    }
+
+    colour_rgba8::colour_rgba8(const colour& _colour)
+            : colour_rgba8(rgba8_format::from_bits(pack_colour<rgba8_format, false>(_colour))) {}
+
+    colour colour_rgba8::to_colour() const {
+        return unpack_colour<rgba8_format, false>(rgba8_format::to_bits(*this));
+    }
+
+    colour_rgb10a2::colour_rgb10a2(const colour& _colour)
+            : bits_(pack_colour<rgb10a2_format, false>(_colour)) {}
+
+    colour colour_rgb10a2::to_colour() const {
+        return unpack_colour<rgb10a2_format, false>(bits_);
+    }
+
+    void packed_colour_util::pack(std::span<const colour> _src, std::span<colour_rgba8> _dst) {
+        pack_array<rgba8_format, false>(_src, _dst);
+    }
+
+    void packed_colour_util::pack(std::span<const colour> _src, std::span<colour_rgb10a2> _dst) {
+        pack_array<rgb10a2_format, false>(_src, _dst);
+    }
+
+    void packed_colour_util::unpack(std::span<const colour_rgba8> _src, std::span<colour> _dst) {
+        unpack_array<rgba8_format, false>(_src, _dst);
+    }
+
+    void packed_colour_util::unpack(std::span<const colour_rgb10a2> _src, std::span<colour> _dst) {
+        unpack_array<rgb10a2_format, false>(_src, _dst);
+    }
+
+    void packed_colour_util::pack_premultiplied(std::span<const colour> _src, std::span<colour_rgba8> _dst) {
+        pack_array<rgba8_format, true>(_src, _dst);
+    }
+
+    void packed_colour_util::pack_premultiplied(std::span<const colour> _src, std::span<colour_rgb10a2> _dst) {
+        pack_array<rgb10a2_format, true>(_src, _dst);
+    }
+
+    void packed_colour_util::unpack_premultiplied(std::span<const colour_rgba8> _src, std::span<colour> _dst) {
+        unpack_array<rgba8_format, true>(_src, _dst);
+    }
+
+    void packed_colour_util::unpack_premultiplied(std::span<const colour_rgb10a2> _src, std::span<colour> _dst) {
+        unpack_array<rgb10a2_format, true>(_src, _dst);
+    }
+}
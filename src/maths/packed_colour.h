@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include "maths/colour.h"
+
+namespace mkr {
+    /**
+     * 8 bit unsigned normalised storage for a colour, with the components in the order RGBA in memory.
+     * This is a storage type only. Convert it to a colour to do any arithmetic.
+     */
+    struct colour_rgba8 {
+        std::uint8_t r_;
+        std::uint8_t g_;
+        std::uint8_t b_;
+        std::uint8_t a_;
+
+        colour_rgba8() = default;
+
+        constexpr colour_rgba8(std::uint8_t _r, std::uint8_t _g, std::uint8_t _b, std::uint8_t _a)
+                : r_(_r), g_(_g), b_(_b), a_(_a) {}
+
+        /**
+         * Constructs the packed colour from a colour. Each component is clamped to [0, 1] and rounded to the nearest
+         * representable value (ties to even). NaN becomes 0.
+         * @param _colour The colour.
+         */
+        explicit colour_rgba8(const colour& _colour);
+
+        /**
+         * Returns this colour unpacked. The conversion is exact, to within the rounding of a float.
+         * @return This colour unpacked.
+         */
+        [[nodiscard]] colour to_colour() const;
+
+        bool operator==(const colour_rgba8& _rhs) const { return r_ == _rhs.r_ && g_ == _rhs.g_ && b_ == _rhs.b_ && a_ == _rhs.a_; }
+
+        bool operator!=(const colour_rgba8& _rhs) const { return !(*this == _rhs); }
+    };
+
+    /**
+     * Unsigned normalised storage for a colour, with 10 bits for each of RGB and 2 bits for alpha, packed into 32 bits.
+     * Red is in the lowest bits and alpha in the highest, the same layout as DXGI_FORMAT_R10G10B10A2_UNORM.
+     * This is a storage type only. Convert it to a colour to do any arithmetic.
+     */
+    struct colour_rgb10a2 {
+        /// The packed bits of the colour.
+        std::uint32_t bits_;
+
+        colour_rgb10a2() = default;
+
+        /**
+         * Constructs the packed colour from its components.
+         * @param _r The red component, from 0 to 1023.
+         * @param _g The green component, from 0 to 1023.
+         * @param _b The blue component, from 0 to 1023.
+         * @param _a The alpha component, from 0 to 3.
+         */
+        constexpr colour_rgb10a2(std::uint32_t _r, std::uint32_t _g, std::uint32_t _b, std::uint32_t _a)
+                : bits_((_r & 0x3FFu) | ((_g & 0x3FFu) << 10) | ((_b & 0x3FFu) << 20) | ((_a & 0x3u) << 30)) {}
+
+        /**
+         * Constructs the packed colour from a colour. Each component is clamped to [0, 1] and rounded to the nearest
+         * representable value (ties to even). NaN becomes 0.
+         * @param _colour The colour.
+         */
+        explicit colour_rgb10a2(const colour& _colour);
+
+        [[nodiscard]] constexpr std::uint32_t r() const { return bits_ & 0x3FFu; }
+
+        [[nodiscard]] constexpr std::uint32_t g() const { return (bits_ >> 10) & 0x3FFu; }
+
+        [[nodiscard]] constexpr std::uint32_t b() const { return (bits_ >> 20) & 0x3FFu; }
+
+        [[nodiscard]] constexpr std::uint32_t a() const { return bits_ >> 30; }
+
+        /**
+         * Returns this colour unpacked. The conversion is exact, to within the rounding of a float.
+         * @return This colour unpacked.
+         */
+        [[nodiscard]] colour to_colour() const;
+
+        bool operator==(const colour_rgb10a2& _rhs) const { return bits_ == _rhs.bits_; }
+
+        bool operator!=(const colour_rgb10a2& _rhs) const { return bits_ != _rhs.bits_; }
+    };
+
+    /**
+     * Batch conversions between colours and packed colours.
+     * Uses SSE2 instructions on x86-64, else falls back to a scalar conversion which gives bit-identical results.
+     * Packing clamps each component to [0, 1] and rounds it to the nearest representable value (ties to even), and
+     * NaN becomes 0.
+     */
+    class packed_colour_util {
+    public:
+        packed_colour_util() = delete;
+
+        /**
+         * Packs an array of colours.
+         * @param _src The colours to pack.
+         * @param _dst The packed colours.
+         * @warning _dst must be at least as large as _src.
+         */
+        static void pack(std::span<const colour> _src, std::span<colour_rgba8> _dst);
+
+        static void pack(std::span<const colour> _src, std::span<colour_rgb10a2> _dst);
+
+        /**
+         * Unpacks an array of packed colours.
+         * @param _src The packed colours to unpack.
+         * @param _dst The colours.
+         * @warning _dst must be at least as large as _src.
+         */
+        static void unpack(std::span<const colour_rgba8> _src, std::span<colour> _dst);
+
+        static void unpack(std::span<const colour_rgb10a2> _src, std::span<colour> _dst);
+
+        /**
+         * Packs an array of colours with straight alpha into packed colours with premultiplied alpha.
+         * The components are clamped, and alpha is rounded to the packed format before RGB is multiplied by it, so that
+         * the packed RGB matches the packed alpha.
+         * @param _src The colours to pack, with straight alpha.
+         * @param _dst The packed colours, with premultiplied alpha.
+         * @warning _dst must be at least as large as _src.
+         */
+        static void pack_premultiplied(std::span<const colour> _src, std::span<colour_rgba8> _dst);
+
+        static void pack_premultiplied(std::span<const colour> _src, std::span<colour_rgb10a2> _dst);
+
+        /**
+         * Unpacks an array of packed colours with premultiplied alpha into colours with straight alpha.
+         * RGB is divided by alpha, and colours with an alpha of 0 become transparent black.
+         * @param _src The packed colours to unpack, with premultiplied alpha.
+         * @param _dst The colours, with straight alpha.
+         * @warning _dst must be at least as large as _src.
+         */
+        static void unpack_premultiplied(std::span<const colour_rgba8> _src, std::span<colour> _dst);
+
+        static void unpack_premultiplied(std::span<const colour_rgb10a2> _src, std::span<colour> _dst);
+    };
+}
@@ -1,6 +1,32 @@
+#include <array>
 #include "maths/plane.h"
+#include "maths/vector3_block.h"
 
 namespace mkr {
+    namespace {
+        /**
+         * Write the signed distances of a normalised plane to a block of points.
+         * The loop has no branches and no divisions, so that the compiler can vectorise it.
+         */
+        inline void block_distances(const plane& _plane, const float* __restrict _x, const float* __restrict _y,
+                                    const float* __restrict _z, size_t _num_points, float* __restrict _result) {
+            const float nx = _plane.normal_.x_, ny = _plane.normal_.y_, nz = _plane.normal_.z_, d = _plane.d_;
+            for (size_t i = 0; i < _num_points; ++i) {
+                _result[i] = nx * _x[i] + ny * _y[i] + nz * _z[i] + d;
+            }
+        }
+
+        /**
+         * Copies the points of a block into a vector3_block, so that every plane can be tested against it with a
+         * vectorised loop.
+         */
+        inline void load_block(std::span<const vector3> _points, size_t _block_start, size_t _block_size, vector3_block& _block) {
+            for (size_t i = 0; i < _block_size; ++i) {
+                _block.set(i, _points[_block_start + i]);
+            }
+        }
+    }
+
     plane::plane(const vector3& _normal, float _d)
             : normal_(_normal), d_(_d) {}
 
@@ -20,6 +46,18 @@ namespace mkr {
                maths_util::approx_equal(distance_from_origin(), _plane.distance_from_origin());
     }
 
+    plane plane::normalised() const {
+        plane result = *this;
+        result.normalise();
+        return result;
+    }
+
+    void plane::normalise() {
+        const float inv_length = 1.0f / normal_.length();
+        normal_ *= inv_length;
+        d_ *= inv_length;
+    }
+
     plane plane::flipped() const {
         return plane(-normal_, d_);
     }
@@ -105,6 +143,51 @@ namespace mkr {
         return (normal_.dot(_point) + d_) / normal_.length();
     }
 
+    void plane::distances(std::span<const vector3> _points, std::span<float> _result) const {
+        distances(std::span<const plane>{this, 1}, _points, _result);
+    }
+
+    void plane::distances(std::span<const plane> _planes, std::span<const vector3> _points, std::span<float> _result) {
+        // Each block of points is copied once, and tested against every plane while it is in the L1 cache.
+        vector3_block block;
+        vector3_block::for_each_block(_points.size(), [&](size_t _block_start, size_t _block_size) {
+            load_block(_points, _block_start, _block_size, block);
+            for (size_t i = 0; i < _planes.size(); ++i) {
+                block_distances(_planes[i].normalised(), block.x_, block.y_, block.z_, _block_size,
+                                &_result[i * _points.size() + _block_start]);
+            }
+        });
+    }
+
+    void plane::classify(std::span<const vector3> _points, std::span<std::uint64_t> _front, std::span<std::uint64_t> _back,
+                         float _tolerance) const {
+        classify(std::span<const plane>{this, 1}, _points, _front, _back, _tolerance);
+    }
+
+    void plane::classify(std::span<const plane> _planes, std::span<const vector3> _points, std::span<std::uint64_t> _front,
+                         std::span<std::uint64_t> _back, float _tolerance) {
+        // Classify the points a block at a time, one bitmask word per block.
+        static_assert(vector3_block::capacity == 64);
+        const size_t words = mask_size(_points.size());
+        vector3_block block;
+        float distances[vector3_block::capacity];
+        vector3_block::for_each_block(_points.size(), [&](size_t _block_start, size_t _block_size) {
+            load_block(_points, _block_start, _block_size, block);
+            const size_t word = _block_start / vector3_block::capacity;
+            for (size_t i = 0; i < _planes.size(); ++i) {
+                block_distances(_planes[i].normalised(), block.x_, block.y_, block.z_, _block_size, distances);
+
+                std::uint64_t front = 0, back = 0;
+                for (size_t j = 0; j < _block_size; ++j) {
+                    front |= static_cast<std::uint64_t>(distances[j] > _tolerance) << j;
+                    back |= static_cast<std::uint64_t>(distances[j] < -_tolerance) << j;
+                }
+                _front[i * words + word] = front;
+                _back[i * words + word] = back;
+            }
+        });
+    }
+
     float plane::angle_between(const plane& _plane) const {
         return normal_.angle_between(_plane.normal_);
     }
@@ -193,6 +276,30 @@ namespace mkr {
         return _line.point_ + _line.direction_ * lambda;
     }
 
+    std::optional<vector3> plane::intersect_point(const plane& _plane_b, const plane& _plane_c) const {
+        /**
+         * Let the planes be P·Na + da = 0, P·Nb + db = 0 and P·Nc + dc = 0.
+         * [Real-Time Collision Detection, Christer Ericson 2005, 5.4.5]
+         *
+         * Since Na·(Nb×Nc) is the triple product [Na Nb Nc], and Na·(Nc×Na) = Na·(Na×Nb) = 0,
+         * P = -(da(Nb×Nc) + db(Nc×Na) + dc(Na×Nb)) / [Na Nb Nc]
+         * satisfies P·Na = -da, and likewise for the other 2 planes.
+         *
+         * The planes meet at a single point if and only if their normals are linearly independent, which is when the
+         * triple product is not 0.
+         */
+        const vector3 bc = _plane_b.normal_.cross(_plane_c.normal_);
+        const float denominator = normal_.dot(bc);
+        const float scale = normal_.length() * _plane_b.normal_.length() * _plane_c.normal_.length();
+        if (std::fabs(denominator) <= std::numeric_limits<float>::epsilon() * scale) {
+            return std::nullopt;
+        }
+
+        const vector3 ca = _plane_c.normal_.cross(normal_);
+        const vector3 ab = normal_.cross(_plane_b.normal_);
+        return (bc * d_ + ca * _plane_b.d_ + ab * _plane_c.d_) * (-1.0f / denominator);
+    }
+
     std::optional<line> plane::intersect_line(const plane& _plane) const {
         /**
          * 2 planes intersect at a line if they are not parallel.
@@ -216,4 +323,47 @@ namespace mkr {
 
         return line{point_on_line, plane_c_normal};
     }
-}
\ No newline at end of file
+
+    void plane::frustum_corners(std::span<const plane> _planes, std::span<vector3> _corners) {
+        /**
+         * Each corner is the intersection of a side plane X (left or right), a side plane Y (bottom or top) and an end
+         * plane Z (near or far), as in intersect_point:
+         * P = -(dx(Ny×Nz) + dy(Nz×Nx) + dz(Nx×Ny)) / (Nx·(Ny×Nz))
+         *
+         * Nx×Ny is the direction of the edge between 2 side planes, and is the same for the near and far corner of
+         * the edge. Ny×Nz and Nz×Nx are each shared by 2 corners too.
+         */
+        const auto cross = [](const plane& _a, const plane& _b) {
+            const vector3& a = _a.normal_;
+            const vector3& b = _b.normal_;
+            return std::array<float, 3>{a.y_ * b.z_ - a.z_ * b.y_, a.z_ * b.x_ - a.x_ * b.z_, a.x_ * b.y_ - a.y_ * b.x_};
+        };
+
+        for (size_t frustum = 0; frustum < _planes.size() / 6; ++frustum) {
+            const plane* planes = &_planes[frustum * 6];
+            vector3* corners = &_corners[frustum * 8];
+
+            // xy[right | top << 1], yz[top | far << 1] and zx[right | far << 1].
+            std::array<std::array<float, 3>, 4> xy, yz, zx;
+            for (size_t i = 0; i < 4; ++i) {
+                const size_t low = i & 1, high = i >> 1;
+                xy[i] = cross(planes[low], planes[2 + high]);
+                yz[i] = cross(planes[2 + low], planes[4 + high]);
+                zx[i] = cross(planes[4 + high], planes[low]);
+            }
+
+            for (size_t i = 0; i < 8; ++i) {
+                const size_t right = i & 1, top = (i >> 1) & 1, far = i >> 2;
+                const plane& x = planes[right];
+                const float dx = x.d_, dy = planes[2 + top].d_, dz = planes[4 + far].d_;
+                const auto& ny_nz = yz[top | (far << 1)];
+                const auto& nz_nx = zx[right | (far << 1)];
+                const auto& nx_ny = xy[right | (top << 1)];
+                const float scale = -1.0f / (x.normal_.x_ * ny_nz[0] + x.normal_.y_ * ny_nz[1] + x.normal_.z_ * ny_nz[2]);
+                corners[i] = vector3{(ny_nz[0] * dx + nz_nx[0] * dy + nx_ny[0] * dz) * scale,
+                                     (ny_nz[1] * dx + nz_nx[1] * dy + nx_ny[1] * dz) * scale,
+                                     (ny_nz[2] * dx + nz_nx[2] * dy + nx_ny[2] * dz) * scale};
+            }
+        }
+    }
+}
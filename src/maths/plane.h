@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <span>
 #include "maths/line.h"
 
 namespace mkr {
@@ -44,6 +47,20 @@ namespace mkr {
          */
         plane(const vector3& _vertex_a, const vector3& _vertex_b, const vector3& _vertex_c);
 
+        /**
+         * Returns a copy of the plane with a unit normal. The plane is the same, but the normal and d are scaled so that
+         * distances can be calculated without dividing by the length of the normal.
+         * @return A copy of the plane with a unit normal.
+         * @warning The normal must not be a zero vector.
+         */
+        [[nodiscard]] plane normalised() const;
+
+        /**
+         * Scales the normal and d of this plane so that the normal is a unit vector.
+         * @warning The normal must not be a zero vector.
+         */
+        void normalise();
+
         /**
          * Returns a copy of the plane in the opposite direction.
          * @return A copy of the plane in the opposite direction.
@@ -109,6 +126,69 @@ namespace mkr {
          */
         [[nodiscard]] float distance_to(const vector3& _point) const;
 
+        /**
+         * Returns the signed distance of this plane to a point, without dividing by the length of the normal.
+         * Points in front of the plane (on the side the normal points to) have a positive distance.
+         * @param _point The point.
+         * @return The signed distance of this plane to a point.
+         * @warning The plane must be normalised.
+         */
+        [[nodiscard]] float signed_distance(const vector3& _point) const { return normal_.dot(_point) + d_; }
+
+        /**
+         * Returns the signed distance of this plane to many points.
+         * The points are copied into vector3_blocks, so that the distances are calculated with a vectorised loop, and the
+         * length of the normal is calculated once per block, rather than once per point.
+         * @param _points The points.
+         * @param _result The signed distance to each point.
+         * @warning _points and _result must be the same size.
+         */
+        void distances(std::span<const vector3> _points, std::span<float> _result) const;
+
+        /**
+         * Returns the signed distance of many planes to many points.
+         * Each block of points is copied once, and tested against every plane.
+         * @param _planes The planes.
+         * @param _points The points.
+         * @param _result The signed distances. The distance of plane i to point j is at _result[i * _points.size() + j].
+         * @warning _result must have a size of _planes.size() * _points.size().
+         */
+        static void distances(std::span<const plane> _planes, std::span<const vector3> _points, std::span<float> _result);
+
+        /**
+         * Returns the number of 64 bit words needed for a bitmask of _num_points points.
+         * @param _num_points The number of points.
+         * @return The number of 64 bit words needed for a bitmask of _num_points points.
+         */
+        [[nodiscard]] static constexpr size_t mask_size(size_t _num_points) { return (_num_points + 63) / 64; }
+
+        /**
+         * Classifies many points as in front of, behind, or on this plane.
+         * Point i is represented by bit (i % 64) of word (i / 64) of the bitmasks. A point whose bit is not set in either
+         * bitmask is on the plane.
+         * @param _points The points.
+         * @param _front The bitmask of the points whose signed distance is greater than _tolerance.
+         * @param _back The bitmask of the points whose signed distance is less than -_tolerance.
+         * @param _tolerance The distance from the plane within which a point is on the plane.
+         * @warning _front and _back must have a size of mask_size(_points.size()).
+         */
+        void classify(std::span<const vector3> _points, std::span<std::uint64_t> _front, std::span<std::uint64_t> _back,
+                      float _tolerance = std::numeric_limits<float>::epsilon()) const;
+
+        /**
+         * Classifies many points against many planes, such as the clipping planes of a frustum.
+         * Each block of points is copied once, and tested against every plane.
+         * The bitmasks of plane i start at word i * mask_size(_points.size()).
+         * @param _planes The planes.
+         * @param _points The points.
+         * @param _front The bitmasks of the points in front of each plane.
+         * @param _back The bitmasks of the points behind each plane.
+         * @param _tolerance The distance from a plane within which a point is on the plane.
+         * @warning _front and _back must have a size of _planes.size() * mask_size(_points.size()).
+         */
+        static void classify(std::span<const plane> _planes, std::span<const vector3> _points, std::span<std::uint64_t> _front,
+                             std::span<std::uint64_t> _back, float _tolerance = std::numeric_limits<float>::epsilon());
+
         /**
          * Returns the angle between 2 planes.
          * @param _plane The plane to check against.
@@ -159,6 +239,15 @@ namespace mkr {
          */
         [[nodiscard]] std::optional<vector3> intersect_point(const line& _line) const;
 
+        /**
+         * Return the intersection point between this plane and 2 other planes.
+         * @param _plane_b The second plane.
+         * @param _plane_c The third plane.
+         * @return The point which lies on all 3 planes.
+         * @attention Returns std::nullopt if the 3 planes do not meet at a single point.
+         */
+        [[nodiscard]] std::optional<vector3> intersect_point(const plane& _plane_b, const plane& _plane_c) const;
+
         /**
          * Return the line of intersection between 2 planes.
          * @param _line The plane to intersect with.
@@ -166,5 +255,19 @@ namespace mkr {
          * @attention Returns std::nullopt if the 2 planes do not intersect.
          */
         [[nodiscard]] std::optional<line> intersect_line(const plane& _plane) const;
+
+        /**
+         * Finds the corners of many frusta, such as the cascades of a shadow map, from their planes.
+         * Each corner is the intersection of 3 planes, so no matrix is inverted. The 4 edges between the side planes
+         * are shared by the near and far corners, so each frustum needs 12 cross products rather than 24.
+         * Corner i of a frustum is on the right plane if bit 0 of i is set, else the left plane, on the top plane if
+         * bit 1 is set, else the bottom plane, and on the far plane if bit 2 is set, else the near plane.
+         * @param _planes The left, right, bottom, top, near and far planes of each frustum, as given by
+         * matrix_util::frustum_planes.
+         * @param _corners The 8 corners of each frustum.
+         * @warning _planes must have a size of 6n, and _corners must have a size of 8n, for n frusta.
+         * @warning Each corner must be a single point, so opposite planes must not be parallel to the other planes.
+         */
+        static void frustum_corners(std::span<const plane> _planes, std::span<vector3> _corners);
     };
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include "maths/polygon_clipper.h"
+#include "maths/vector3_block.h"
+
+namespace mkr {
+    namespace {
+        /**
+         * Clips a polygon against a plane, given the signed distance of each vertex to the plane.
+         * @return The number of vertices written to _result.
+         */
+        size_t clip_polygon(const vector3* _polygon, const float* _distances, size_t _num_vertices, vector3* _result,
+                            size_t _capacity) {
+            size_t count = 0;
+            for (size_t i = 0; i < _num_vertices; ++i) {
+                const size_t next = (i + 1 == _num_vertices) ? 0 : i + 1;
+                const float d0 = _distances[i], d1 = _distances[next];
+                if (d0 >= 0.0f && count < _capacity) {
+                    _result[count++] = _polygon[i];
+                }
+                // The edge crosses the plane, so the point where it crosses is a vertex of the clipped polygon.
+                // A vertex on the plane is kept as it is, so only a strict change of sign is a crossing, otherwise the
+                // vertex would be added a second time at t = 0 or 1.
+                if (((d0 > 0.0f && d1 < 0.0f) || (d0 < 0.0f && d1 > 0.0f)) && count < _capacity) {
+                    const vector3& a = _polygon[i];
+                    const vector3& b = _polygon[next];
+                    const float t = d0 / (d0 - d1);
+                    _result[count++] = vector3{a.x_ + (b.x_ - a.x_) * t, a.y_ + (b.y_ - a.y_) * t, a.z_ + (b.z_ - a.z_) * t};
+                }
+            }
+            return count;
+        }
+    }
+
+    polygon_clipper::polygon_clipper(std::span<const plane> _planes)
+            : planes_(_planes.begin(), _planes.end()) {
+        scratch_.resize(max_vertices(3));
+        polygon_.resize(max_vertices(3));
+        distances_.resize(max_vertices(3));
+    }
+
+    size_t polygon_clipper::clip(std::span<const vector3> _polygon, std::span<vector3> _result) {
+        const size_t capacity = max_vertices(_polygon.size());
+        if (scratch_.size() < capacity) {
+            scratch_.resize(capacity);
+            distances_.resize(capacity);
+        }
+
+        // Each plane reads the polygon from one buffer and writes it to the other, starting from _polygon.
+        const vector3* polygon = _polygon.data();
+        size_t num_vertices = _polygon.size();
+        for (const plane& p: planes_) {
+            // The plane does not need to be normalised, since only the signs and ratios of the distances are used.
+            const float nx = p.normal_.x_, ny = p.normal_.y_, nz = p.normal_.z_, d = p.d_;
+            float* __restrict distances = distances_.data();
+            bool all_front = true, all_back = true;
+            for (size_t i = 0; i < num_vertices; ++i) {
+                distances[i] = nx * polygon[i].x_ + ny * polygon[i].y_ + nz * polygon[i].z_ + d;
+                all_front &= distances[i] >= 0.0f;
+                all_back &= distances[i] < 0.0f;
+            }
+            if (all_back) { return 0; }
+            if (all_front) { continue; }
+
+            vector3* output = (polygon == _result.data()) ? scratch_.data() : _result.data();
+            num_vertices = clip_polygon(polygon, distances, num_vertices, output, capacity);
+            // Only a point or an edge on the plane is left, which would otherwise become a polygon with no area.
+            if (num_vertices < 3) { return 0; }
+            polygon = output;
+        }
+
+        if (polygon != _result.data()) {
+            std::copy(polygon, polygon + num_vertices, _result.begin());
+        }
+        return num_vertices;
+    }
+
+    size_t polygon_clipper::clip(std::span<const triangle> _triangles, std::span<triangle> _result, std::span<std::uint32_t> _sources) {
+        // The vertices of the triangles are copied into blocks, so that the test against each plane can be vectorised.
+        vector3_block a, b, c;
+        // Whether each triangle is completely in front of every plane, or completely behind any plane.
+        std::uint8_t inside[vector3_block::capacity], outside[vector3_block::capacity];
+
+        size_t count = 0;
+        vector3_block::for_each_block(_triangles.size(), [&](size_t _block_start, size_t _block_size) {
+            for (size_t i = 0; i < _block_size; ++i) {
+                const triangle& t = _triangles[_block_start + i];
+                a.set(i, t.vertex_a_);
+                b.set(i, t.vertex_b_);
+                c.set(i, t.vertex_c_);
+                inside[i] = 1;
+                outside[i] = 0;
+            }
+
+            for (const plane& p: planes_) {
+                const float nx = p.normal_.x_, ny = p.normal_.y_, nz = p.normal_.z_, d = p.d_;
+                for (size_t i = 0; i < _block_size; ++i) {
+                    const float da = nx * a.x_[i] + ny * a.y_[i] + nz * a.z_[i] + d;
+                    const float db = nx * b.x_[i] + ny * b.y_[i] + nz * b.z_[i] + d;
+                    const float dc = nx * c.x_[i] + ny * c.y_[i] + nz * c.z_[i] + d;
+                    inside[i] &= static_cast<std::uint8_t>(maths_util::min(da, maths_util::min(db, dc)) >= 0.0f);
+                    outside[i] |= static_cast<std::uint8_t>(maths_util::max(da, maths_util::max(db, dc)) < 0.0f);
+                }
+            }
+
+            for (size_t i = 0; i < _block_size; ++i) {
+                if (outside[i]) { continue; }
+
+                const auto source = static_cast<std::uint32_t>(_block_start + i);
+                const triangle& t = _triangles[source];
+                if (inside[i]) {
+                    _result[count] = t;
+                    _sources[count++] = source;
+                    continue;
+                }
+
+                const vector3 vertices[3]{t.vertex_a_, t.vertex_b_, t.vertex_c_};
+                const size_t num_vertices = clip(vertices, polygon_);
+                for (size_t j = 2; j < num_vertices; ++j) {
+                    _result[count] = triangle{polygon_[0], polygon_[j - 1], polygon_[j]};
+                    _sources[count++] = source;
+                }
+            }
+        });
+        return count;
+    }
+}
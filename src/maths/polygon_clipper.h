@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "maths/triangle.h"
+
+namespace mkr {
+    /**
+     * Clips convex polygons and triangles against a set of planes, keeping the parts in front of every plane (on the side
+     * the normals point to), such as the inside of a decal box or a view frustum.
+     * [Reentrant Polygon Clipping, Sutherland & Hodgman 1974]
+     *
+     * Each plane is clipped against in turn, and the signed distances of every vertex to the plane are found before
+     * any vertex is clipped. A clipper keeps its own scratch buffers, so clipping allocates nothing once the buffers are
+     * large enough for the largest polygon clipped. A clipper must therefore not be used by more than one thread at a
+     * time.
+     */
+    class polygon_clipper {
+    private:
+        std::vector<plane> planes_;
+        /// Holds the polygon between planes.
+        std::vector<vector3> scratch_;
+        /// Holds a clipped triangle of a triangle soup.
+        std::vector<vector3> polygon_;
+        /// The signed distances of the vertices of the polygon to the plane being clipped against.
+        std::vector<float> distances_;
+
+    public:
+        /**
+         * Constructs a clipper.
+         * @param _planes The planes to clip against. They do not need to be normalised.
+         */
+        explicit polygon_clipper(std::span<const plane> _planes);
+
+        /**
+         * Returns the planes clipped against.
+         * @return The planes clipped against.
+         */
+        [[nodiscard]] const std::vector<plane>& planes() const { return planes_; }
+
+        /**
+         * Returns the most vertices a convex polygon can have after clipping. Each plane adds at most 1 vertex.
+         * @param _num_vertices The number of vertices of the polygon before clipping.
+         * @return The most vertices the polygon can have after clipping.
+         */
+        [[nodiscard]] size_t max_vertices(size_t _num_vertices) const { return _num_vertices + planes_.size(); }
+
+        /**
+         * Returns the most triangles a triangle soup can be clipped into. Each triangle becomes a convex polygon of at
+         * most max_vertices(3) vertices, which is split into a fan of triangles.
+         * @param _num_triangles The number of triangles before clipping.
+         * @return The most triangles after clipping.
+         */
+        [[nodiscard]] size_t max_triangles(size_t _num_triangles) const { return _num_triangles * (planes_.size() + 1); }
+
+        /**
+         * Clips a convex polygon against the planes.
+         * @param _polygon The vertices of the polygon, in order around it.
+         * @param _result The vertices of the clipped polygon, in the same order.
+         * @return The number of vertices written to _result, which is 0 if the polygon is completely clipped away, or
+         *         only a point or an edge of it lies on a plane.
+         * @warning _result must have a size of at least max_vertices(_polygon.size()), and must not overlap _polygon.
+         */
+        size_t clip(std::span<const vector3> _polygon, std::span<vector3> _result);
+
+        /**
+         * Clips many triangles against the planes.
+         * The triangles are tested against all of the planes in blocks, with a loop that the compiler can vectorise.
+         * Triangles completely in front of every plane are copied and triangles completely behind any plane are skipped,
+         * so only the triangles which cross a plane are clipped.
+         * @param _triangles The triangles.
+         * @param _result The clipped triangles. Each clipped triangle is split into a fan of triangles around its first
+         * vertex, with the same winding.
+         * @param _sources The index in _triangles of the triangle each triangle of _result was clipped from.
+         * @return The number of triangles written to _result and _sources.
+         * @warning _result and _sources must have a size of at least max_triangles(_triangles.size()).
+         */
+        size_t clip(std::span<const triangle> _triangles, std::span<triangle> _result, std::span<std::uint32_t> _sources);
+    };
+}
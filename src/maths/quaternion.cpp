@@ -1,24 +1,58 @@
 #include "quaternion.h"
+#include "vector3_block.h"
 
 namespace mkr {
+    namespace {
+        inline void rotate_point(float& _x, float& _y, float& _z, float _qw, float _qx, float _qy, float _qz) {
+            /**
+             * Rotation Formula:
+             * R * P * R.Inverse
+             *
+             * Expanding the two quaternion products (and using the fact that R is a unit quaternion) reduces this to:
+             * t = 2 * (R.xyz ✕ P)
+             * P' = P + R.w * t + (R.xyz ✕ t)
+             */
+            const float tx = 2.0f * (_qy * _z - _qz * _y);
+            const float ty = 2.0f * (_qz * _x - _qx * _z);
+            const float tz = 2.0f * (_qx * _y - _qy * _x);
+            const float x = _x + _qw * tx + (_qy * tz - _qz * ty);
+            const float y = _y + _qw * ty + (_qz * tx - _qx * tz);
+            const float z = _z + _qw * tz + (_qx * ty - _qy * tx);
+            _x = x;
+            _y = y;
+            _z = z;
+        }
+    }
+
     vector3 quaternion::rotate(const vector3& _point, float _angle, const vector3& _rotation_axis) {
-        /**
-         * Rotation Formula:
-         * R * P * R.Inverse
-         */
-        quaternion rotation{_rotation_axis, _angle};
-        quaternion point{0.0f, _point.x_, _point.y_, _point.z_};
-        quaternion result = rotation * point * rotation.conjugated();
-        return vector3{result.x_, result.y_, result.z_};
+        return rotate(_point, quaternion{_rotation_axis, _angle});
     }
 
     vector3 quaternion::rotate(const vector3& _point, const quaternion& _rotation) {
-        /**
-         * Rotation Formula:
-         * R * P * R.Inverse
-         */
-        quaternion result = _rotation * quaternion{0.0f, _point.x_, _point.y_, _point.z_} * _rotation.conjugated();
-        return vector3{result.x_, result.y_, result.z_};
+        vector3 result = _point;
+        rotate_point(result.x_, result.y_, result.z_, _rotation.w_, _rotation.x_, _rotation.y_, _rotation.z_);
+        return result;
+    }
+
+    void quaternion::rotate(std::span<float> _x, std::span<float> _y, std::span<float> _z, const quaternion& _rotation) {
+        // Plain loop over separate component arrays, so that the compiler can vectorise it.
+        const float qw = _rotation.w_, qx = _rotation.x_, qy = _rotation.y_, qz = _rotation.z_;
+        float* __restrict x = _x.data();
+        float* __restrict y = _y.data();
+        float* __restrict z = _z.data();
+        for (size_t i = 0; i < _x.size(); ++i) {
+            rotate_point(x[i], y[i], z[i], qw, qx, qy, qz);
+        }
+    }
+
+    void quaternion::rotate(std::span<float> _x, std::span<float> _y, std::span<float> _z, std::span<const quaternion> _rotations) {
+        float* __restrict x = _x.data();
+        float* __restrict y = _y.data();
+        float* __restrict z = _z.data();
+        const quaternion* __restrict q = _rotations.data();
+        for (size_t i = 0; i < _x.size(); ++i) {
+            rotate_point(x[i], y[i], z[i], q[i].w_, q[i].x_, q[i].y_, q[i].z_);
+        }
     }
 
     quaternion quaternion::slerp(const quaternion& _start, const quaternion& _end, float _ratio, bool _clamp_ratio) {
@@ -51,6 +85,99 @@ namespace mkr {
         return quaternion{d_axis, d_angle * ratio} * _start;
     }
 
+    namespace {
+        inline quaternion nlerp_shortest(const quaternion& _start, const quaternion& _end, float _ratio) {
+            // q and -q represent the same rotation. Flip the end rotation if needed so that we take the shortest path.
+            const float end_ratio = (_start.dot(_end) < 0.0f) ? -_ratio : _ratio;
+            const float start_ratio = 1.0f - _ratio;
+            quaternion result{start_ratio * _start.w_ + end_ratio * _end.w_,
+                              start_ratio * _start.x_ + end_ratio * _end.x_,
+                              start_ratio * _start.y_ + end_ratio * _end.y_,
+                              start_ratio * _start.z_ + end_ratio * _end.z_};
+            const float inv_length = 1.0f / std::sqrt(result.length_squared());
+            return result * inv_length;
+        }
+
+        /**
+         * A Fast and Accurate Algorithm for Computing SLERP, David Eberly
+         * [https://www.geometrictools.com/Documentation/FastAndAccurateSlerp.pdf]
+         *
+         * slerp(S, E, t) = S * sin((1-t)θ)/sinθ + E * sin(tθ)/sinθ, where cosθ = S·E.
+         *
+         * The coefficient sin(tθ)/sinθ is expanded as a power series in (cosθ - 1), whose terms can be generated by the
+         * recurrence t * Π(1 + ((t² - i²) / (i(2i+1))) * (cosθ - 1)). 8 terms are used, with the last term scaled by a
+         * correction factor μ, which minimises the maximum error over cosθ in [0, 1] and t in [0, 1].
+         *
+         * The factors which only depend on t are computed once, so that they can be reused for many quaternions.
+         */
+        class fast_slerp_coefficients {
+        private:
+            static constexpr float mu = 1.85298109240830f;
+            static constexpr float u[8] = {1.0f / (1.0f * 3.0f), 1.0f / (2.0f * 5.0f), 1.0f / (3.0f * 7.0f), 1.0f / (4.0f * 9.0f),
+                                           1.0f / (5.0f * 11.0f), 1.0f / (6.0f * 13.0f), 1.0f / (7.0f * 15.0f), mu / (8.0f * 17.0f)};
+            static constexpr float v[8] = {1.0f / 3.0f, 2.0f / 5.0f, 3.0f / 7.0f, 4.0f / 9.0f,
+                                           5.0f / 11.0f, 6.0f / 13.0f, 7.0f / 15.0f, mu * 8.0f / 17.0f};
+
+            float t_;
+            float d_;
+            float factor_t_[8];
+            float factor_d_[8];
+
+        public:
+            explicit fast_slerp_coefficients(float _ratio) {
+                t_ = maths_util::clamp(_ratio, 0.0f, 1.0f);
+                d_ = 1.0f - t_;
+                for (int i = 0; i < 8; ++i) {
+                    factor_t_[i] = u[i] * t_ * t_ - v[i];
+                    factor_d_[i] = u[i] * d_ * d_ - v[i];
+                }
+            }
+
+            [[nodiscard]] quaternion slerp(const quaternion& _start, const quaternion& _end) const {
+                // q and -q represent the same rotation. Flip the end rotation if needed so that we take the shortest path.
+                const float cos_theta = _start.dot(_end);
+                const float sign = (cos_theta < 0.0f) ? -1.0f : 1.0f;
+                const float x_minus_1 = sign * cos_theta - 1.0f;
+
+                float coeff_t = 1.0f;
+                float coeff_d = 1.0f;
+                for (int i = 7; i >= 0; --i) {
+                    coeff_t = 1.0f + factor_t_[i] * x_minus_1 * coeff_t;
+                    coeff_d = 1.0f + factor_d_[i] * x_minus_1 * coeff_d;
+                }
+                coeff_t *= t_ * sign;
+                coeff_d *= d_;
+
+                return quaternion{coeff_d * _start.w_ + coeff_t * _end.w_,
+                                  coeff_d * _start.x_ + coeff_t * _end.x_,
+                                  coeff_d * _start.y_ + coeff_t * _end.y_,
+                                  coeff_d * _start.z_ + coeff_t * _end.z_};
+            }
+        };
+    }
+
+    quaternion quaternion::nlerp(const quaternion& _start, const quaternion& _end, float _ratio, bool _clamp_ratio) {
+        const float ratio = _clamp_ratio ? maths_util::clamp(_ratio, 0.0f, 1.0f) : _ratio;
+        return nlerp_shortest(_start, _end, ratio);
+    }
+
+    quaternion quaternion::fast_slerp(const quaternion& _start, const quaternion& _end, float _ratio) {
+        return fast_slerp_coefficients{_ratio}.slerp(_start, _end);
+    }
+
+    void quaternion::nlerp(std::span<const quaternion> _start, std::span<const quaternion> _end, float _ratio, std::span<quaternion> _result) {
+        for (size_t i = 0; i < _result.size(); ++i) {
+            _result[i] = nlerp_shortest(_start[i], _end[i], _ratio);
+        }
+    }
+
+    void quaternion::fast_slerp(std::span<const quaternion> _start, std::span<const quaternion> _end, float _ratio, std::span<quaternion> _result) {
+        const fast_slerp_coefficients coefficients{_ratio};
+        for (size_t i = 0; i < _result.size(); ++i) {
+            _result[i] = coefficients.slerp(_start[i], _end[i]);
+        }
+    }
+
     quaternion::quaternion(float _w, float _x, float _y, float _z)
             : w_(_w), x_(_x), y_(_y), z_(_z) {}
 
@@ -200,6 +327,327 @@ namespace mkr {
         _rotation_axis = xyz.normalised();
     }
 
+    namespace {
+        /**
+         * Write the rotation matrix of a unit quaternion into the upper 3x3 part of a column-major matrix.
+         * @param _columns The matrix's columns.
+         * @param _stride The number of floats in each column.
+         */
+        inline void write_rotation_matrix(const quaternion& _q, float* _columns, size_t _stride) {
+            const float xx = _q.x_ * _q.x_, yy = _q.y_ * _q.y_, zz = _q.z_ * _q.z_;
+            const float xy = _q.x_ * _q.y_, xz = _q.x_ * _q.z_, yz = _q.y_ * _q.z_;
+            const float wx = _q.w_ * _q.x_, wy = _q.w_ * _q.y_, wz = _q.w_ * _q.z_;
+
+            float* column0 = _columns;
+            float* column1 = _columns + _stride;
+            float* column2 = _columns + 2 * _stride;
+            column0[0] = 1.0f - 2.0f * (yy + zz);
+            column0[1] = 2.0f * (xy + wz);
+            column0[2] = 2.0f * (xz - wy);
+            column1[0] = 2.0f * (xy - wz);
+            column1[1] = 1.0f - 2.0f * (xx + zz);
+            column1[2] = 2.0f * (yz + wx);
+            column2[0] = 2.0f * (xz + wy);
+            column2[1] = 2.0f * (yz - wx);
+            column2[2] = 1.0f - 2.0f * (xx + yy);
+        }
+
+        /**
+         * Get the rotation of the upper 3x3 part of a column-major rotation matrix as a quaternion.
+         * @param _columns The matrix's columns.
+         * @param _stride The number of floats in each column.
+         */
+        inline quaternion read_rotation_matrix(const float* _columns, size_t _stride) {
+            /**
+             * Shepperd's Method:
+             * [https://www.euclideanspace.com/maths/geometry/rotations/conversions/matrixToQuaternion/index.htm]
+             *
+             * Let the matrix elements be Rrc, where r is the row and c is the column.
+             * From the rotation matrix of a unit quaternion,
+             * 4w² = 1 + R00 + R11 + R22
+             * 4x² = 1 + R00 - R11 - R22
+             * 4y² = 1 - R00 + R11 - R22
+             * 4z² = 1 - R00 - R11 + R22
+             *
+             * Any one of these can be used to find a component, and the other components are then found from the sums and
+             * differences of the off-diagonal elements (e.g. R21 - R12 = 4wx). To avoid dividing by a small number, we
+             * choose the equation which gives the largest component.
+             */
+            auto r = [&](size_t _row, size_t _column) { return _columns[_column * _stride + _row]; };
+            const float trace = r(0, 0) + r(1, 1) + r(2, 2);
+
+            if (trace >= r(0, 0) && trace >= r(1, 1) && trace >= r(2, 2)) {
+                const float s = 2.0f * std::sqrt(1.0f + trace); // s = 4w
+                const float inv_s = 1.0f / s;
+                return quaternion{0.25f * s, (r(2, 1) - r(1, 2)) * inv_s, (r(0, 2) - r(2, 0)) * inv_s, (r(1, 0) - r(0, 1)) * inv_s};
+            }
+            if (r(0, 0) >= r(1, 1) && r(0, 0) >= r(2, 2)) {
+                const float s = 2.0f * std::sqrt(1.0f + r(0, 0) - r(1, 1) - r(2, 2)); // s = 4x
+                const float inv_s = 1.0f / s;
+                return quaternion{(r(2, 1) - r(1, 2)) * inv_s, 0.25f * s, (r(0, 1) + r(1, 0)) * inv_s, (r(0, 2) + r(2, 0)) * inv_s};
+            }
+            if (r(1, 1) >= r(2, 2)) {
+                const float s = 2.0f * std::sqrt(1.0f + r(1, 1) - r(0, 0) - r(2, 2)); // s = 4y
+                const float inv_s = 1.0f / s;
+                return quaternion{(r(0, 2) - r(2, 0)) * inv_s, (r(0, 1) + r(1, 0)) * inv_s, 0.25f * s, (r(1, 2) + r(2, 1)) * inv_s};
+            }
+            const float s = 2.0f * std::sqrt(1.0f + r(2, 2) - r(0, 0) - r(1, 1)); // s = 4z
+            const float inv_s = 1.0f / s;
+            return quaternion{(r(1, 0) - r(0, 1)) * inv_s, (r(0, 2) + r(2, 0)) * inv_s, (r(1, 2) + r(2, 1)) * inv_s, 0.25f * s};
+        }
+
+        /**
+         * The same as read_rotation_matrix, for a block of matrices whose columns are stored in vector3_blocks.
+         *
+         * Let t be 4c², where c is the largest of w, x, y and z, and let s = 2√t = 4c as in read_rotation_matrix. Each
+         * component is then its numerator divided by s, where the numerator of c is t, since t / s = 4c² / 4c = c, and
+         * the other numerators are the sums and differences of the off-diagonal elements.
+         * The numerators are selected instead of branched on, so that the loop can be vectorised.
+         */
+        void read_rotation_matrices(const vector3_block& _column0, const vector3_block& _column1, const vector3_block& _column2,
+                                    size_t _count, float* __restrict _w, float* __restrict _x, float* __restrict _y,
+                                    float* __restrict _z) {
+            for (size_t i = 0; i < _count; ++i) {
+                const float r00 = _column0.x_[i], r10 = _column0.y_[i], r20 = _column0.z_[i];
+                const float r01 = _column1.x_[i], r11 = _column1.y_[i], r21 = _column1.z_[i];
+                const float r02 = _column2.x_[i], r12 = _column2.y_[i], r22 = _column2.z_[i];
+                const float trace = r00 + r11 + r22;
+
+                const float wx = r21 - r12, wy = r02 - r20, wz = r10 - r01; // 4wx, 4wy, 4wz
+                const float xy = r01 + r10, xz = r02 + r20, yz = r12 + r21; // 4xy, 4xz, 4yz
+
+                // Choose the largest of 4w², 4x², 4y² and 4z², preferring w, then x, then y on a tie. This is the same
+                // choice as read_rotation_matrix, since for example trace >= R00 is the same as 4w² >= 4x².
+                float t = 1.0f + r22 - r00 - r11;
+                float nw = wz, nx = xz, ny = yz, nz = t;
+                const float t_y = 1.0f + r11 - r00 - r22;
+                const bool use_y = t_y >= t;
+                t = use_y ? t_y : t;
+                nw = use_y ? wy : nw, nx = use_y ? xy : nx, ny = use_y ? t_y : ny, nz = use_y ? yz : nz;
+                const float t_x = 1.0f + r00 - r11 - r22;
+                const bool use_x = t_x >= t;
+                t = use_x ? t_x : t;
+                nw = use_x ? wx : nw, nx = use_x ? t_x : nx, ny = use_x ? xy : ny, nz = use_x ? xz : nz;
+                const float t_w = 1.0f + trace;
+                const bool use_w = t_w >= t;
+                t = use_w ? t_w : t;
+                nw = use_w ? t_w : nw, nx = use_w ? wx : nx, ny = use_w ? wy : ny, nz = use_w ? wz : nz;
+
+                const float inv_s = 1.0f / (2.0f * std::sqrt(t));
+                _w[i] = nw * inv_s;
+                _x[i] = nx * inv_s;
+                _y[i] = ny * inv_s;
+                _z[i] = nz * inv_s;
+            }
+        }
+    }
+
+    quaternion quaternion::from_rotation_matrix(const matrix3x3& _matrix) {
+        return read_rotation_matrix(_matrix[0], 3);
+    }
+
+    quaternion quaternion::from_rotation_matrix(const matrix4x4& _matrix) {
+        return read_rotation_matrix(_matrix[0], 4);
+    }
+
+    void quaternion::from_rotation_matrix(std::span<const matrix4x4> _matrices, std::span<quaternion> _result) {
+        vector3_block column0, column1, column2;
+        float w[vector3_block::capacity], x[vector3_block::capacity], y[vector3_block::capacity], z[vector3_block::capacity];
+        vector3_block::for_each_block(_matrices.size(), [&](size_t _block_start, size_t _block_size) {
+            for (size_t i = 0; i < _block_size; ++i) {
+                const float* columns = _matrices[_block_start + i][0];
+                column0.set(i, columns[0], columns[1], columns[2]);
+                column1.set(i, columns[4], columns[5], columns[6]);
+                column2.set(i, columns[8], columns[9], columns[10]);
+            }
+            read_rotation_matrices(column0, column1, column2, _block_size, w, x, y, z);
+            for (size_t i = 0; i < _block_size; ++i) {
+                _result[_block_start + i] = quaternion{w[i], x[i], y[i], z[i]};
+            }
+        });
+    }
+
+    void quaternion::to_rotation_matrix(std::span<const quaternion> _rotations, std::span<matrix4x4> _result) {
+        for (size_t i = 0; i < _rotations.size(); ++i) {
+            float* columns = _result[i][0];
+            write_rotation_matrix(_rotations[i], columns, 4);
+            columns[3] = columns[7] = columns[11] = 0.0f;
+            columns[12] = columns[13] = columns[14] = 0.0f;
+            columns[15] = 1.0f;
+        }
+    }
+
+    namespace {
+        inline quaternion euler_to_quaternion(const vector3& _euler_angles) {
+            /**
+             * rotation_matrix(euler) = Rx * Ry * Rz, so the quaternion is Qx * Qy * Qz, where
+             * Qx = (cx, sx, 0, 0), Qy = (cy, 0, sy, 0), Qz = (cz, 0, 0, sz),
+             * and cx, sx are the cosine and sine of half the X angle, and so on.
+             *
+             * Expanding the products:
+             * w = cx*cy*cz - sx*sy*sz
+             * x = sx*cy*cz + cx*sy*sz
+             * y = cx*sy*cz - sx*cy*sz
+             * z = cx*cy*sz + sx*sy*cz
+             */
+            float sx, cx, sy, cy, sz, cz;
+            maths_util::sincos(_euler_angles.x_ * 0.5f, sx, cx);
+            maths_util::sincos(_euler_angles.y_ * 0.5f, sy, cy);
+            maths_util::sincos(_euler_angles.z_ * 0.5f, sz, cz);
+            return quaternion{cx * cy * cz - sx * sy * sz,
+                              sx * cy * cz + cx * sy * sz,
+                              cx * sy * cz - sx * cy * sz,
+                              cx * cy * sz + sx * sy * cz};
+        }
+
+        inline vector3 quaternion_to_euler(const quaternion& _q) {
+            /**
+             * R = Rx * Ry * Rz
+             * | cy*cz              -cy*sz              sy     |
+             * | cx*sz + sx*sy*cz   cx*cz - sx*sy*sz   -sx*cy  |
+             * | sx*sz - cx*sy*cz   sx*cz + cx*sy*sz    cx*cy  |
+             *
+             * Thus,
+             * y = asin(R02)
+             * x = atan2(-R12, R22)
+             * z = atan2(-R01, R00)
+             *
+             * When cy = 0, R12, R22, R01 and R00 are all 0, and only x ± z can be found, from R21 and R11.
+             * Writing the matrix elements in terms of the quaternion:
+             * R02 = 2(xz + wy), R12 = 2(yz - wx), R22 = 1 - 2(x² + y²), R01 = 2(xy - wz), R00 = 1 - 2(y² + z²),
+             * R21 = 2(yz + wx), R11 = 1 - 2(x² + z²)
+             */
+            const float sin_y = 2.0f * (_q.x_ * _q.z_ + _q.w_ * _q.y_);
+            if (std::fabs(sin_y) >= 0.9999999f) {
+                const float x = std::atan2(2.0f * (_q.y_ * _q.z_ + _q.w_ * _q.x_), 1.0f - 2.0f * (_q.x_ * _q.x_ + _q.z_ * _q.z_));
+                return vector3{x, std::copysign(maths_util::pi * 0.5f, sin_y), 0.0f};
+            }
+            return vector3{std::atan2(2.0f * (_q.w_ * _q.x_ - _q.y_ * _q.z_), 1.0f - 2.0f * (_q.x_ * _q.x_ + _q.y_ * _q.y_)),
+                           std::asin(sin_y),
+                           std::atan2(2.0f * (_q.w_ * _q.z_ - _q.x_ * _q.y_), 1.0f - 2.0f * (_q.y_ * _q.y_ + _q.z_ * _q.z_))};
+        }
+    }
+
+    quaternion quaternion::from_euler_angles(const vector3& _euler_angles) {
+        return euler_to_quaternion(_euler_angles);
+    }
+
+    void quaternion::from_euler_angles(std::span<const vector3> _euler_angles, std::span<quaternion> _result) {
+        for (size_t i = 0; i < _euler_angles.size(); ++i) {
+            _result[i] = euler_to_quaternion(_euler_angles[i]);
+        }
+    }
+
+    void quaternion::to_euler_angles(std::span<const quaternion> _rotations, std::span<vector3> _result) {
+        for (size_t i = 0; i < _rotations.size(); ++i) {
+            _result[i] = quaternion_to_euler(_rotations[i]);
+        }
+    }
+
+    namespace {
+        /**
+         * The loop of quaternion::integrate. Renormalising is a template parameter rather than a branch in the loop, so
+         * that the loop can be vectorised.
+         */
+        template<bool Renormalise>
+        void integrate_first_order(float* __restrict _w, float* __restrict _x, float* __restrict _y, float* __restrict _z,
+                                   const float* __restrict _wx, const float* __restrict _wy, const float* __restrict _wz,
+                                   size_t _count, float _half_dt) {
+            for (size_t i = 0; i < _count; ++i) {
+                const float ax = _wx[i] * _half_dt, ay = _wy[i] * _half_dt, az = _wz[i] * _half_dt;
+                float qw = _w[i] - (ax * _x[i] + ay * _y[i] + az * _z[i]);
+                float qx = _x[i] + (ax * _w[i] + ay * _z[i] - az * _y[i]);
+                float qy = _y[i] + (ay * _w[i] + az * _x[i] - ax * _z[i]);
+                float qz = _z[i] + (az * _w[i] + ax * _y[i] - ay * _x[i]);
+                if constexpr (Renormalise) {
+                    const float scale = 1.5f - 0.5f * (qw * qw + qx * qx + qy * qy + qz * qz);
+                    qw *= scale, qx *= scale, qy *= scale, qz *= scale;
+                }
+                _w[i] = qw, _x[i] = qx, _y[i] = qy, _z[i] = qz;
+            }
+        }
+
+        /// The loop of quaternion::integrate_exponential.
+        void integrate_exponential_map(float* __restrict _w, float* __restrict _x, float* __restrict _y, float* __restrict _z,
+                                       const float* __restrict _wx, const float* __restrict _wy, const float* __restrict _wz,
+                                       size_t _count, float _half_dt) {
+            for (size_t i = 0; i < _count; ++i) {
+                const float vx = _wx[i] * _half_dt, vy = _wy[i] * _half_dt, vz = _wz[i] * _half_dt;
+                const float angle_squared = vx * vx + vy * vy + vz * vz;
+                float rw = 4.77947733e-14f;
+                rw = rw * angle_squared - 1.14707456e-11f;
+                rw = rw * angle_squared + 2.08767570e-9f;
+                rw = rw * angle_squared - 2.75573192e-7f;
+                rw = rw * angle_squared + 2.48015873e-5f;
+                rw = rw * angle_squared - 1.38888889e-3f;
+                rw = rw * angle_squared + 4.16666667e-2f;
+                rw = rw * angle_squared - 0.5f;
+                rw = rw * angle_squared + 1.0f;
+                float sinc = 2.81145725e-15f;
+                sinc = sinc * angle_squared - 7.64716373e-13f;
+                sinc = sinc * angle_squared + 1.60590438e-10f;
+                sinc = sinc * angle_squared - 2.50521084e-8f;
+                sinc = sinc * angle_squared + 2.75573192e-6f;
+                sinc = sinc * angle_squared - 1.98412698e-4f;
+                sinc = sinc * angle_squared + 8.33333333e-3f;
+                sinc = sinc * angle_squared - 1.66666667e-1f;
+                sinc = sinc * angle_squared + 1.0f;
+                const float rx = vx * sinc, ry = vy * sinc, rz = vz * sinc;
+
+                const float qw = rw * _w[i] - rx * _x[i] - ry * _y[i] - rz * _z[i];
+                const float qx = rw * _x[i] + rx * _w[i] + ry * _z[i] - rz * _y[i];
+                const float qy = rw * _y[i] - rx * _z[i] + ry * _w[i] + rz * _x[i];
+                const float qz = rw * _z[i] + rx * _y[i] - ry * _x[i] + rz * _w[i];
+                _w[i] = qw, _x[i] = qx, _y[i] = qy, _z[i] = qz;
+            }
+        }
+    }
+
+    void quaternion::integrate(std::span<float> _w, std::span<float> _x, std::span<float> _y, std::span<float> _z,
+                               std::span<const float> _angular_velocity_x,
+                               std::span<const float> _angular_velocity_y,
+                               std::span<const float> _angular_velocity_z,
+                               float _delta_time, bool _renormalise) {
+        /**
+         * The derivative of an orientation q with world space angular velocity ω is dq/dt = 0.5 * (0,ω) * q.
+         * (0,ω) * (qw,qv) = (-ω•qv, qw*ω + ω×qv)
+         *
+         * The renormalisation uses the first order Taylor expansion of 1/√s around s = 1, which is (3 - s) / 2.
+         */
+        const float half_dt = 0.5f * _delta_time;
+        if (_renormalise) {
+            integrate_first_order<true>(_w.data(), _x.data(), _y.data(), _z.data(), _angular_velocity_x.data(),
+                                        _angular_velocity_y.data(), _angular_velocity_z.data(), _w.size(), half_dt);
+        } else {
+            integrate_first_order<false>(_w.data(), _x.data(), _y.data(), _z.data(), _angular_velocity_x.data(),
+                                         _angular_velocity_y.data(), _angular_velocity_z.data(), _w.size(), half_dt);
+        }
+    }
+
+    void quaternion::integrate_exponential(std::span<float> _w, std::span<float> _x, std::span<float> _y, std::span<float> _z,
+                                           std::span<const float> _angular_velocity_x,
+                                           std::span<const float> _angular_velocity_y,
+                                           std::span<const float> _angular_velocity_z,
+                                           float _delta_time) {
+        /**
+         * exp((0,v)) = (cos|v|, sin|v| * v/|v|), where v = 0.5 * Δt * ω.
+         * q' = exp((0,v)) * q
+         *
+         * cos|v| and sin|v|/|v| are both even functions of |v|, so they are found as polynomials in |v|², which needs no
+         * square root, and no special case for |v| = 0. Unlike std::sin and std::cos, the loop has no calls or branches,
+         * so it can be vectorised. The polynomials are their Taylor series up to |v|^16.
+         * cos|v| = Σ (-1)^n |v|^2n / (2n)!
+         * sin|v| / |v| = Σ (-1)^n |v|^2n / (2n + 1)!
+         * For |v| <= π, the absolute error of each in float is less than 6e-7.
+         */
+        integrate_exponential_map(_w.data(), _x.data(), _y.data(), _z.data(), _angular_velocity_x.data(),
+                                  _angular_velocity_y.data(), _angular_velocity_z.data(), _w.size(), 0.5f * _delta_time);
+    }
+
+    vector3 quaternion::to_euler_angles() const {
+        return quaternion_to_euler(*this);
+    }
+
     matrix4x4 quaternion::to_rotation_matrix() const {
         return matrix4x4{{1.0f - 2.0f * y_ * y_ - 2.0f * z_ * z_, 2.0f * x_ * y_ + 2.0f * w_ * z_, 2.0f * x_ * z_ - 2.0f * w_ * y_, 0.0f,
                           2.0f * x_ * y_ - 2.0f * w_ * z_, 1.0f - 2.0f * x_ * x_ - 2.0f * z_ * z_, 2.0f * y_ * z_ + 2.0f * w_ * x_, 0.0f,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include "maths/vector3.h"
 #include "maths/matrix.h"
 
@@ -67,6 +68,30 @@ namespace mkr {
          */
         [[nodiscard]] static vector3 rotate(const vector3& _point, const quaternion& _rotation);
 
+        /**
+         * Rotate an array of points by the same rotation.
+         * The points are stored as a structure of arrays, and are rotated in place.
+         * @param _x The x components of the points.
+         * @param _y The y components of the points.
+         * @param _z The z components of the points.
+         * @param _rotation The unit rotation.
+         * @warning _x, _y and _z must be the same size.
+         * @warning _rotation must be a rotational quaternion.
+         */
+        static void rotate(std::span<float> _x, std::span<float> _y, std::span<float> _z, const quaternion& _rotation);
+
+        /**
+         * Rotate an array of points, each by its own rotation.
+         * The points are stored as a structure of arrays, and are rotated in place.
+         * @param _x The x components of the points.
+         * @param _y The y components of the points.
+         * @param _z The z components of the points.
+         * @param _rotations The unit rotations. The i-th point is rotated by the i-th rotation.
+         * @warning _x, _y, _z and _rotations must be the same size.
+         * @warning _rotations must be rotational quaternions.
+         */
+        static void rotate(std::span<float> _x, std::span<float> _y, std::span<float> _z, std::span<const quaternion> _rotations);
+
         /**
          * Spherical Linear Interpolation between 2 rotational quaternions.
          * @param _start The start rotation.
@@ -78,6 +103,169 @@ namespace mkr {
          */
         [[nodiscard]] static quaternion slerp(const quaternion& _start, const quaternion& _end, float _ratio, bool _clamp_ratio = false);
 
+        /**
+         * Normalised Linear Interpolation between 2 rotational quaternions, taking the shortest path.
+         * Much cheaper than slerp, but the angular velocity is not constant over the interpolation.
+         * @param _start The start rotation.
+         * @param _end The end rotation.
+         * @param _ratio The ratio to interpolate between _start and _end. A value of 0 will return _start, and a value of 1 will return _end.
+         * @param _clamp_ratio If set to true, the _ratio is clamped to between 0 and 1. The default value is false.
+         * @return The interpolated rotation.
+         * @warning _start and _end must be rotational quaternions.
+         */
+        [[nodiscard]] static quaternion nlerp(const quaternion& _start, const quaternion& _end, float _ratio, bool _clamp_ratio = false);
+
+        /**
+         * Spherical Linear Interpolation between 2 rotational quaternions, taking the shortest path.
+         * Uses a polynomial approximation of the slerp coefficients instead of trigonometric functions.
+         * The maximum error of each component compared to an exact slerp is 3e-5, and is largest when the rotations are
+         * close to 180 degrees apart. For rotations less than 90 degrees apart, the error is within 1e-6.
+         * @param _start The start rotation.
+         * @param _end The end rotation.
+         * @param _ratio The ratio to interpolate between _start and _end. The ratio is clamped to between 0 and 1.
+         * @return The interpolated rotation.
+         * @warning _start and _end must be rotational quaternions.
+         */
+        [[nodiscard]] static quaternion fast_slerp(const quaternion& _start, const quaternion& _end, float _ratio);
+
+        /**
+         * Normalised Linear Interpolation between 2 arrays of rotational quaternions, taking the shortest path.
+         * @param _start The start rotations.
+         * @param _end The end rotations.
+         * @param _ratio The ratio to interpolate between _start and _end. A value of 0 will return _start, and a value of 1 will return _end.
+         * @param _result The interpolated rotations.
+         * @warning _start, _end and _result must be the same size.
+         * @warning _start and _end must be rotational quaternions.
+         */
+        static void nlerp(std::span<const quaternion> _start, std::span<const quaternion> _end, float _ratio, std::span<quaternion> _result);
+
+        /**
+         * Spherical Linear Interpolation between 2 arrays of rotational quaternions, taking the shortest path.
+         * Has the same accuracy as the non-batched fast_slerp.
+         * @param _start The start rotations.
+         * @param _end The end rotations.
+         * @param _ratio The ratio to interpolate between _start and _end. The ratio is clamped to between 0 and 1.
+         * @param _result The interpolated rotations.
+         * @warning _start, _end and _result must be the same size.
+         * @warning _start and _end must be rotational quaternions.
+         */
+        static void fast_slerp(std::span<const quaternion> _start, std::span<const quaternion> _end, float _ratio, std::span<quaternion> _result);
+
+        /**
+         * Get the rotation of a rotation matrix as a quaternion.
+         * Uses Shepperd's method, which is numerically stable for all rotations.
+         * @param _matrix The rotation matrix.
+         * @return The rotation as a unit quaternion.
+         * @warning _matrix must be a pure rotation matrix, with no scale or shear.
+         */
+        [[nodiscard]] static quaternion from_rotation_matrix(const matrix3x3& _matrix);
+
+        /**
+         * Get the rotation of a matrix4x4 rotation matrix as a quaternion.
+         * Uses Shepperd's method, which is numerically stable for all rotations.
+         * The translation of the matrix is ignored.
+         * @param _matrix The rotation matrix.
+         * @return The rotation as a unit quaternion.
+         * @warning The upper 3x3 part of _matrix must be a pure rotation matrix, with no scale or shear.
+         */
+        [[nodiscard]] static quaternion from_rotation_matrix(const matrix4x4& _matrix);
+
+        /**
+         * Get an array of matrix4x4 rotation matrices as quaternions.
+         * Uses Shepperd's method, the same as the single matrix overload. The matrices are converted in blocks, with a
+         * loop that selects Shepperd's equation instead of branching on it, so that the compiler can vectorise it.
+         * @param _matrices The rotation matrices.
+         * @param _result The rotations as unit quaternions.
+         * @warning _matrices and _result must be the same size.
+         * @warning The upper 3x3 part of each matrix must be a pure rotation matrix, with no scale or shear.
+         */
+        static void from_rotation_matrix(std::span<const matrix4x4> _matrices, std::span<quaternion> _result);
+
+        /**
+         * Get an array of quaternions as matrix4x4 rotation matrices.
+         * The loop has no branches, so the compiler vectorises it as it is.
+         * @param _rotations The rotations.
+         * @param _result The rotation matrices.
+         * @warning _rotations and _result must be the same size.
+         * @warning _rotations must be rotational (unit) quaternions.
+         */
+        static void to_rotation_matrix(std::span<const quaternion> _rotations, std::span<matrix4x4> _result);
+
+        /**
+         * Get a rotation given in euler angles as a quaternion.
+         * The rotation is the same as matrix_util::rotation_matrix(_euler_angles), which is a rotation around the Z-axis,
+         * then the Y-axis, then the X-axis.
+         * @param _euler_angles The rotation around the X, Y and Z axes in radians.
+         * @return The rotation as a unit quaternion.
+         */
+        [[nodiscard]] static quaternion from_euler_angles(const vector3& _euler_angles);
+
+        /**
+         * Get an array of rotations given in euler angles as quaternions.
+         * @param _euler_angles The rotations around the X, Y and Z axes in radians.
+         * @param _result The rotations as unit quaternions.
+         * @warning _euler_angles and _result must be the same size.
+         */
+        static void from_euler_angles(std::span<const vector3> _euler_angles, std::span<quaternion> _result);
+
+        /**
+         * Get an array of quaternions as euler angles.
+         * @param _rotations The rotations.
+         * @param _result The rotations around the X, Y and Z axes in radians.
+         * @warning _rotations and _result must be the same size.
+         * @warning _rotations must be rotational (unit) quaternions.
+         */
+        static void to_euler_angles(std::span<const quaternion> _rotations, std::span<vector3> _result);
+
+        /**
+         * Integrate an array of orientations by their angular velocities over a time step.
+         * The orientations are stored as a structure of arrays, and are updated in place.
+         *
+         * Uses the first order derivative q' = q + 0.5 * Δt * ω * q, which is accurate for small rotations per step.
+         * This does not keep the orientations unit length, so every few steps they should be renormalised by passing
+         * _renormalise as true. The renormalisation uses a cheap approximation of 1/length without a square root,
+         * which is accurate as long as the orientations have not drifted far from unit length.
+         * @param _w The W components of the orientations.
+         * @param _x The X components of the orientations.
+         * @param _y The Y components of the orientations.
+         * @param _z The Z components of the orientations.
+         * @param _angular_velocity_x The x components of the angular velocities, in radians per second.
+         * @param _angular_velocity_y The y components of the angular velocities, in radians per second.
+         * @param _angular_velocity_z The z components of the angular velocities, in radians per second.
+         * @param _delta_time The time step, in seconds.
+         * @param _renormalise If set to true, the orientations are renormalised after integrating.
+         * @warning All of the arrays must be the same size.
+         */
+        static void integrate(std::span<float> _w, std::span<float> _x, std::span<float> _y, std::span<float> _z,
+                              std::span<const float> _angular_velocity_x,
+                              std::span<const float> _angular_velocity_y,
+                              std::span<const float> _angular_velocity_z,
+                              float _delta_time, bool _renormalise);
+
+        /**
+         * Integrate an array of orientations by their angular velocities over a time step, using the exponential map.
+         * The orientations are stored as a structure of arrays, and are updated in place.
+         *
+         * Each orientation is rotated by exp(0.5 * Δt * ω), which is exact for constant angular velocity over the step,
+         * and stays unit length. It is more expensive than integrate, but suitable for large or fast rotations.
+         * The sine and cosine are found with polynomials, in a loop that the compiler can vectorise.
+         * @param _w The W components of the orientations.
+         * @param _x The X components of the orientations.
+         * @param _y The Y components of the orientations.
+         * @param _z The Z components of the orientations.
+         * @param _angular_velocity_x The x components of the angular velocities, in radians per second.
+         * @param _angular_velocity_y The y components of the angular velocities, in radians per second.
+         * @param _angular_velocity_z The z components of the angular velocities, in radians per second.
+         * @param _delta_time The time step, in seconds.
+         * @warning All of the arrays must be the same size, and no orientation may rotate by more than a full turn in a
+         * step (|ω| * Δt <= 2π), beyond which the polynomials are not accurate.
+         */
+        static void integrate_exponential(std::span<float> _w, std::span<float> _x, std::span<float> _y, std::span<float> _z,
+                                          std::span<const float> _angular_velocity_x,
+                                          std::span<const float> _angular_velocity_y,
+                                          std::span<const float> _angular_velocity_z,
+                                          float _delta_time);
+
         /**
          * Constructs a quaternion.
          * @param _w The W component of the quaternion. It is the scalar component.
@@ -206,6 +394,15 @@ namespace mkr {
          */
         void to_axis_angle(vector3& _rotation_axis, float& _angle) const;
 
+        /**
+         * Get this quaternion as euler angles, in the same order as from_euler_angles.
+         * The X and Z angles are in the range [-π, π], and the Y angle is in the range [-π/2, π/2].
+         * When the Y angle is ±π/2 (gimbal lock), the X and Z rotations are around the same axis, and the Z angle is 0.
+         * @return The rotation around the X, Y and Z axes in radians.
+         * @warning This quaternion must be a rotational (unit) quaternion.
+         */
+        [[nodiscard]] vector3 to_euler_angles() const;
+
         /**
          * Get this quaternion as a matrix4x4 rotation matrix.
          * @return This quaternion as a matrix4x4 rotation matrix.
@@ -0,0 +1,219 @@
+#include <limits>
+#include "maths/quaternion_soa.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace mkr {
+    namespace {
+        /**
+         * Quaternion Multiplication Formula:
+         * (sa,va) * (sb,vb) = (sa*sb-va•vb, va×vb + sa*vb + sb*va)
+         */
+        inline void multiply_one(float _aw, float _ax, float _ay, float _az, float _bw, float _bx, float _by, float _bz,
+                                 float& _w, float& _x, float& _y, float& _z) {
+            _w = _aw * _bw - _ax * _bx - _ay * _by - _az * _bz;
+            _x = _aw * _bx + _ax * _bw + _ay * _bz - _az * _by;
+            _y = _aw * _by - _ax * _bz + _ay * _bw + _az * _bx;
+            _z = _aw * _bz + _ax * _by - _ay * _bx + _az * _bw;
+        }
+
+        /// The 9 elements of the upper 3x3 part of a rotation matrix, in column-major order.
+        inline void rotation_elements(float _w, float _x, float _y, float _z, float* _elements) {
+            _elements[0] = 1.0f - 2.0f * (_y * _y + _z * _z);
+            _elements[1] = 2.0f * (_x * _y + _w * _z);
+            _elements[2] = 2.0f * (_x * _z - _w * _y);
+            _elements[3] = 2.0f * (_x * _y - _w * _z);
+            _elements[4] = 1.0f - 2.0f * (_x * _x + _z * _z);
+            _elements[5] = 2.0f * (_y * _z + _w * _x);
+            _elements[6] = 2.0f * (_x * _z + _w * _y);
+            _elements[7] = 2.0f * (_y * _z - _w * _x);
+            _elements[8] = 1.0f - 2.0f * (_x * _x + _y * _y);
+        }
+
+        inline void write_rotation_matrix(const float* _elements, matrix4x4& _matrix) {
+            float* columns = _matrix[0];
+            columns[0] = _elements[0], columns[1] = _elements[1], columns[2] = _elements[2], columns[3] = 0.0f;
+            columns[4] = _elements[3], columns[5] = _elements[4], columns[6] = _elements[5], columns[7] = 0.0f;
+            columns[8] = _elements[6], columns[9] = _elements[7], columns[10] = _elements[8], columns[11] = 0.0f;
+            columns[12] = 0.0f, columns[13] = 0.0f, columns[14] = 0.0f, columns[15] = 1.0f;
+        }
+    }
+
+    quaternion_soa::quaternion_soa(size_t _size) {
+        resize(_size);
+    }
+
+    quaternion_soa::quaternion_soa(std::span<const quaternion> _quaternions) {
+        resize(_quaternions.size());
+        for (size_t i = 0; i < _quaternions.size(); ++i) {
+            set(i, _quaternions[i]);
+        }
+    }
+
+    void quaternion_soa::multiply(const quaternion_soa& _lhs, const quaternion_soa& _rhs, quaternion_soa& _result) {
+        const size_t size = _lhs.size();
+        _result.resize(size);
+
+        // Each element is only read before it is written, so _result may alias _lhs or _rhs.
+        const float* aw = _lhs.w_.data(), * ax = _lhs.x_.data(), * ay = _lhs.y_.data(), * az = _lhs.z_.data();
+        const float* bw = _rhs.w_.data(), * bx = _rhs.x_.data(), * by = _rhs.y_.data(), * bz = _rhs.z_.data();
+        float* rw = _result.w_.data(), * rx = _result.x_.data(), * ry = _result.y_.data(), * rz = _result.z_.data();
+
+        size_t i = 0;
+#if defined(__AVX__)
+        for (; i + 8 <= size; i += 8) {
+            const __m256 a_w = _mm256_loadu_ps(aw + i), a_x = _mm256_loadu_ps(ax + i), a_y = _mm256_loadu_ps(ay + i), a_z = _mm256_loadu_ps(az + i);
+            const __m256 b_w = _mm256_loadu_ps(bw + i), b_x = _mm256_loadu_ps(bx + i), b_y = _mm256_loadu_ps(by + i), b_z = _mm256_loadu_ps(bz + i);
+
+            const __m256 w = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(a_w, b_w), _mm256_mul_ps(a_x, b_x)),
+                                           _mm256_add_ps(_mm256_mul_ps(a_y, b_y), _mm256_mul_ps(a_z, b_z)));
+            const __m256 x = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a_w, b_x), _mm256_mul_ps(a_x, b_w)),
+                                           _mm256_sub_ps(_mm256_mul_ps(a_y, b_z), _mm256_mul_ps(a_z, b_y)));
+            const __m256 y = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(a_w, b_y), _mm256_mul_ps(a_x, b_z)),
+                                           _mm256_add_ps(_mm256_mul_ps(a_y, b_w), _mm256_mul_ps(a_z, b_x)));
+            const __m256 z = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a_w, b_z), _mm256_mul_ps(a_x, b_y)),
+                                           _mm256_sub_ps(_mm256_mul_ps(a_z, b_w), _mm256_mul_ps(a_y, b_x)));
+
+            _mm256_storeu_ps(rw + i, w);
+            _mm256_storeu_ps(rx + i, x);
+            _mm256_storeu_ps(ry + i, y);
+            _mm256_storeu_ps(rz + i, z);
+        }
+#endif
+        for (; i < size; ++i) {
+            multiply_one(aw[i], ax[i], ay[i], az[i], bw[i], bx[i], by[i], bz[i], rw[i], rx[i], ry[i], rz[i]);
+        }
+    }
+
+    void quaternion_soa::dot(const quaternion_soa& _lhs, const quaternion_soa& _rhs, std::span<float> _result) {
+        const size_t size = _lhs.size();
+        const float* aw = _lhs.w_.data(), * ax = _lhs.x_.data(), * ay = _lhs.y_.data(), * az = _lhs.z_.data();
+        const float* bw = _rhs.w_.data(), * bx = _rhs.x_.data(), * by = _rhs.y_.data(), * bz = _rhs.z_.data();
+        float* result = _result.data();
+
+        size_t i = 0;
+#if defined(__AVX__)
+        for (; i + 8 <= size; i += 8) {
+            const __m256 ww = _mm256_mul_ps(_mm256_loadu_ps(aw + i), _mm256_loadu_ps(bw + i));
+            const __m256 xx = _mm256_mul_ps(_mm256_loadu_ps(ax + i), _mm256_loadu_ps(bx + i));
+            const __m256 yy = _mm256_mul_ps(_mm256_loadu_ps(ay + i), _mm256_loadu_ps(by + i));
+            const __m256 zz = _mm256_mul_ps(_mm256_loadu_ps(az + i), _mm256_loadu_ps(bz + i));
+            _mm256_storeu_ps(result + i, _mm256_add_ps(_mm256_add_ps(ww, xx), _mm256_add_ps(yy, zz)));
+        }
+#endif
+        for (; i < size; ++i) {
+            result[i] = (aw[i] * bw[i] + ax[i] * bx[i]) + (ay[i] * by[i] + az[i] * bz[i]);
+        }
+    }
+
+    void quaternion_soa::resize(size_t _size) {
+        w_.resize(_size, 1.0f);
+        x_.resize(_size, 0.0f);
+        y_.resize(_size, 0.0f);
+        z_.resize(_size, 0.0f);
+    }
+
+    quaternion quaternion_soa::get(size_t _index) const {
+        return quaternion{w_[_index], x_[_index], y_[_index], z_[_index]};
+    }
+
+    void quaternion_soa::set(size_t _index, const quaternion& _quaternion) {
+        w_[_index] = _quaternion.w_;
+        x_[_index] = _quaternion.x_;
+        y_[_index] = _quaternion.y_;
+        z_[_index] = _quaternion.z_;
+    }
+
+    void quaternion_soa::conjugate() {
+        size_t i = 0;
+#if defined(__AVX__)
+        const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+        for (; i + 8 <= size(); i += 8) {
+            _mm256_storeu_ps(&x_[i], _mm256_xor_ps(_mm256_loadu_ps(&x_[i]), sign_mask));
+            _mm256_storeu_ps(&y_[i], _mm256_xor_ps(_mm256_loadu_ps(&y_[i]), sign_mask));
+            _mm256_storeu_ps(&z_[i], _mm256_xor_ps(_mm256_loadu_ps(&z_[i]), sign_mask));
+        }
+#endif
+        for (; i < size(); ++i) {
+            x_[i] = -x_[i];
+            y_[i] = -y_[i];
+            z_[i] = -z_[i];
+        }
+    }
+
+    void quaternion_soa::normalise() {
+        // Same behaviour as quaternion::normalise, quaternions with an (approximately) zero length become zero quaternions.
+        constexpr float epsilon = std::numeric_limits<float>::epsilon();
+        size_t i = 0;
+#if defined(__AVX__)
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 min_length = _mm256_set1_ps(epsilon);
+        for (; i + 8 <= size(); i += 8) {
+            const __m256 w = _mm256_loadu_ps(&w_[i]), x = _mm256_loadu_ps(&x_[i]), y = _mm256_loadu_ps(&y_[i]), z = _mm256_loadu_ps(&z_[i]);
+            const __m256 length_squared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(w, w), _mm256_mul_ps(x, x)),
+                                                        _mm256_add_ps(_mm256_mul_ps(y, y), _mm256_mul_ps(z, z)));
+            const __m256 length = _mm256_sqrt_ps(length_squared);
+            const __m256 valid = _mm256_cmp_ps(length, min_length, _CMP_GT_OQ);
+            const __m256 inv_length = _mm256_and_ps(_mm256_div_ps(one, length), valid);
+            _mm256_storeu_ps(&w_[i], _mm256_mul_ps(w, inv_length));
+            _mm256_storeu_ps(&x_[i], _mm256_mul_ps(x, inv_length));
+            _mm256_storeu_ps(&y_[i], _mm256_mul_ps(y, inv_length));
+            _mm256_storeu_ps(&z_[i], _mm256_mul_ps(z, inv_length));
+        }
+#endif
+        for (; i < size(); ++i) {
+            const float length = std::sqrt((w_[i] * w_[i] + x_[i] * x_[i]) + (y_[i] * y_[i] + z_[i] * z_[i]));
+            const float inv_length = (length > epsilon) ? 1.0f / length : 0.0f;
+            w_[i] *= inv_length;
+            x_[i] *= inv_length;
+            y_[i] *= inv_length;
+            z_[i] *= inv_length;
+        }
+    }
+
+    void quaternion_soa::to_rotation_matrix(std::span<matrix4x4> _result) const {
+        size_t i = 0;
+#if defined(__AVX__)
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 two = _mm256_set1_ps(2.0f);
+        alignas(32) float elements[9][8];
+        for (; i + 8 <= size(); i += 8) {
+            const __m256 w = _mm256_loadu_ps(&w_[i]), x = _mm256_loadu_ps(&x_[i]), y = _mm256_loadu_ps(&y_[i]), z = _mm256_loadu_ps(&z_[i]);
+            const __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+            const __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+            const __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+            _mm256_store_ps(elements[0], _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))));
+            _mm256_store_ps(elements[1], _mm256_mul_ps(two, _mm256_add_ps(xy, wz)));
+            _mm256_store_ps(elements[2], _mm256_mul_ps(two, _mm256_sub_ps(xz, wy)));
+            _mm256_store_ps(elements[3], _mm256_mul_ps(two, _mm256_sub_ps(xy, wz)));
+            _mm256_store_ps(elements[4], _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))));
+            _mm256_store_ps(elements[5], _mm256_mul_ps(two, _mm256_add_ps(yz, wx)));
+            _mm256_store_ps(elements[6], _mm256_mul_ps(two, _mm256_add_ps(xz, wy)));
+            _mm256_store_ps(elements[7], _mm256_mul_ps(two, _mm256_sub_ps(yz, wx)));
+            _mm256_store_ps(elements[8], _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))));
+
+            // Scatter the 8 results into their matrices.
+            for (size_t j = 0; j < 8; ++j) {
+                const float matrix_elements[9] = {elements[0][j], elements[1][j], elements[2][j],
+                                                  elements[3][j], elements[4][j], elements[5][j],
+                                                  elements[6][j], elements[7][j], elements[8][j]};
+                write_rotation_matrix(matrix_elements, _result[i + j]);
+            }
+        }
+#endif
+        for (; i < size(); ++i) {
+            float matrix_elements[9];
+            rotation_elements(w_[i], x_[i], y_[i], z_[i], matrix_elements);
+            write_rotation_matrix(matrix_elements, _result[i]);
+        }
+    }
+
+    void quaternion_soa::to_quaternions(std::span<quaternion> _result) const {
+        for (size_t i = 0; i < size(); ++i) {
+            _result[i] = get(i);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include "maths/quaternion.h"
+
+namespace mkr {
+    /**
+     * An array of quaternions stored as a structure of arrays (one array per component), so that operations on the
+     * whole array can be vectorised. When the library is compiled with AVX enabled, the kernels process 8 quaternions
+     * per iteration.
+     *
+     * The component arrays can be passed directly to the batched structure of arrays functions in quaternion,
+     * such as quaternion::rotate and quaternion::integrate.
+     */
+    class quaternion_soa {
+    private:
+        std::vector<float> w_;
+        std::vector<float> x_;
+        std::vector<float> y_;
+        std::vector<float> z_;
+
+    public:
+        /**
+         * Constructs an empty array.
+         */
+        quaternion_soa() = default;
+
+        /**
+         * Constructs an array of identity quaternions.
+         * @param _size The number of quaternions.
+         */
+        explicit quaternion_soa(size_t _size);
+
+        /**
+         * Constructs an array from an array of quaternions.
+         * @param _quaternions The quaternions.
+         */
+        explicit quaternion_soa(std::span<const quaternion> _quaternions);
+
+        /**
+         * Multiply 2 arrays of quaternions element-wise, _result[i] = _lhs[i] * _rhs[i].
+         * @param _lhs The left hand side quaternions.
+         * @param _rhs The right hand side quaternions.
+         * @param _result The products. It is resized to the size of _lhs, and may be the same array as _lhs or _rhs.
+         * @warning _lhs and _rhs must be the same size.
+         */
+        static void multiply(const quaternion_soa& _lhs, const quaternion_soa& _rhs, quaternion_soa& _result);
+
+        /**
+         * Get the dot products of 2 arrays of quaternions element-wise.
+         * @param _lhs The first quaternions.
+         * @param _rhs The second quaternions.
+         * @param _result The dot products.
+         * @warning _lhs, _rhs and _result must be the same size.
+         */
+        static void dot(const quaternion_soa& _lhs, const quaternion_soa& _rhs, std::span<float> _result);
+
+        /**
+         * Returns the number of quaternions.
+         * @return The number of quaternions.
+         */
+        [[nodiscard]] size_t size() const { return w_.size(); }
+
+        /**
+         * Resizes the array. New quaternions are identity quaternions.
+         * @param _size The new number of quaternions.
+         */
+        void resize(size_t _size);
+
+        /**
+         * Get a quaternion.
+         * @param _index The index of the quaternion.
+         * @return The quaternion.
+         */
+        [[nodiscard]] quaternion get(size_t _index) const;
+
+        /**
+         * Set a quaternion.
+         * @param _index The index of the quaternion.
+         * @param _quaternion The quaternion.
+         */
+        void set(size_t _index, const quaternion& _quaternion);
+
+        [[nodiscard]] std::span<float> w() { return w_; }
+
+        [[nodiscard]] std::span<float> x() { return x_; }
+
+        [[nodiscard]] std::span<float> y() { return y_; }
+
+        [[nodiscard]] std::span<float> z() { return z_; }
+
+        [[nodiscard]] std::span<const float> w() const { return w_; }
+
+        [[nodiscard]] std::span<const float> x() const { return x_; }
+
+        [[nodiscard]] std::span<const float> y() const { return y_; }
+
+        [[nodiscard]] std::span<const float> z() const { return z_; }
+
+        /**
+         * Conjugate every quaternion.
+         */
+        void conjugate();
+
+        /**
+         * Normalise every quaternion. Quaternions with a length of 0 are set to zero quaternions.
+         */
+        void normalise();
+
+        /**
+         * Get every quaternion as a matrix4x4 rotation matrix.
+         * @param _result The rotation matrices.
+         * @warning _result must be the same size as this array.
+         * @warning The quaternions must be rotational (unit) quaternions.
+         */
+        void to_rotation_matrix(std::span<matrix4x4> _result) const;
+
+        /**
+         * Copy the quaternions into an array of quaternions.
+         * @param _result The quaternions.
+         * @warning _result must be the same size as this array.
+         */
+        void to_quaternions(std::span<quaternion> _result) const;
+    };
+}
@@ -0,0 +1,271 @@
+#include <limits>
+#include "maths/rotation_track.h"
+
+namespace mkr {
+    namespace {
+        /// The number of tracks sample_pose decodes before interpolating them together.
+        constexpr size_t sample_batch_size = 64;
+
+        inline std::array<float, 4> to_array(const quaternion& _q) {
+            return {_q.w_, _q.x_, _q.y_, _q.z_};
+        }
+
+        inline size_t largest_component(const std::array<float, 4>& _q) {
+            size_t largest = 0;
+            for (size_t i = 1; i < 4; ++i) {
+                if (std::fabs(_q[i]) > std::fabs(_q[largest])) { largest = i; }
+            }
+            return largest;
+        }
+
+        constexpr std::uint32_t component_bits(rotation_encoding _encoding) {
+            return (_encoding == rotation_encoding::smallest_three_48) ? 15u : 10u;
+        }
+
+        /**
+         * Returns the bits of a packed key from bit Shift up, where the key is given as its low and high 32 bits.
+         * The shift is a template parameter, so that every shift is by a constant, which SSE2 can vectorise.
+         */
+        template<std::uint32_t Shift>
+        inline std::uint32_t packed_bits(std::uint32_t _low, std::uint32_t _high) {
+            if constexpr (Shift == 0) {
+                return _low;
+            } else if constexpr (Shift >= 32) {
+                return _high >> (Shift - 32);
+            } else {
+                return (_low >> Shift) | (_high << (32 - Shift));
+            }
+        }
+
+        /// The fields of a packed key, from the lowest bits up: the 3 stored components and the index of the largest.
+        template<rotation_encoding Encoding>
+        inline void unpack_fields(std::uint32_t _low, std::uint32_t _high, std::uint32_t& _field0, std::uint32_t& _field1,
+                                  std::uint32_t& _field2, std::uint32_t& _largest) {
+            constexpr std::uint32_t bits = component_bits(Encoding);
+            constexpr std::uint32_t mask = (1u << bits) - 1u;
+            _field0 = packed_bits<0>(_low, _high) & mask;
+            _field1 = packed_bits<bits>(_low, _high) & mask;
+            _field2 = packed_bits<2 * bits>(_low, _high) & mask;
+            _largest = packed_bits<3 * bits>(_low, _high) & 3u;
+        }
+
+        /// The encoding and component ranges of a batch of tracks, stored as a structure of arrays.
+        struct track_batch {
+            std::uint32_t is_48_[sample_batch_size];
+            float range_min_[4][sample_batch_size];
+            float range_extent_[4][sample_batch_size];
+        };
+
+        /**
+         * Decodes a batch of packed keys, one from each track of _tracks. This is the same as rotation_track::key, but
+         * without branches, so that the loops can be vectorised.
+         *
+         * The fields are unpacked for both encodings, and those of the track's encoding are selected.
+         * The components were packed from w to z, skipping the largest, so field 2 holds the first component which is
+         * stored, and field 0 the last. Component i is therefore in field 2 - i if it comes before the largest, or in
+         * field 3 - i if it comes after it.
+         *
+         * The fields are unpacked with integer operations in one loop, and dequantised in another. When a float loop
+         * selects on the index of the largest component, GCC knows that the comparisons are exclusive, and turns them back
+         * into branches, so the first loop writes a flag for each component instead.
+         */
+        void decode_keys(const track_batch& _tracks, const std::uint32_t* __restrict _low, const std::uint32_t* __restrict _high,
+                         size_t _count, float* __restrict _w, float* __restrict _x, float* __restrict _y, float* __restrict _z) {
+            std::int32_t quantised[4][sample_batch_size];
+            // 1 for the largest component of each key, else 0.
+            std::int32_t is_largest[4][sample_batch_size];
+            for (size_t i = 0; i < _count; ++i) {
+                std::uint32_t a0, a1, a2, a_largest, b0, b1, b2, b_largest;
+                unpack_fields<rotation_encoding::smallest_three_48>(_low[i], _high[i], a0, a1, a2, a_largest);
+                unpack_fields<rotation_encoding::smallest_three_32>(_low[i], _high[i], b0, b1, b2, b_largest);
+
+                // Select with masks, since the fields are integers.
+                const auto select = [](std::uint32_t _condition, std::uint32_t _a, std::uint32_t _b) {
+                    const std::uint32_t mask = 0u - _condition;
+                    return (_a & mask) | (_b & ~mask);
+                };
+                const std::uint32_t is_48 = _tracks.is_48_[i];
+                const std::uint32_t field0 = select(is_48, a0, b0), field1 = select(is_48, a1, b1), field2 = select(is_48, a2, b2);
+                const std::uint32_t index = select(is_48, a_largest, b_largest);
+
+                // The fields are less than 2^15, so they are stored as signed integers, which convert to float faster.
+                quantised[0][i] = static_cast<std::int32_t>(field2);
+                quantised[1][i] = static_cast<std::int32_t>(select(index < 1, field2, field1));
+                quantised[2][i] = static_cast<std::int32_t>(select(index < 2, field1, field0));
+                quantised[3][i] = static_cast<std::int32_t>(field0);
+                for (std::uint32_t c = 0; c < 4; ++c) {
+                    is_largest[c][i] = static_cast<std::int32_t>(index == c);
+                }
+            }
+
+            constexpr float scale_48 = 1.0f / static_cast<float>((1u << component_bits(rotation_encoding::smallest_three_48)) - 1u);
+            constexpr float scale_32 = 1.0f / static_cast<float>((1u << component_bits(rotation_encoding::smallest_three_32)) - 1u);
+            for (size_t i = 0; i < _count; ++i) {
+                const float scale = (_tracks.is_48_[i] != 0) ? scale_48 : scale_32;
+                float q[4];
+                for (size_t c = 0; c < 4; ++c) {
+                    q[c] = _tracks.range_min_[c][i] + static_cast<float>(quantised[c][i]) * scale * _tracks.range_extent_[c][i];
+                }
+
+                // Summed from z to w, the same order as rotation_track::key. The largest component is weighted by 0
+                // instead of being skipped, which gives the same sum.
+                float sum_squares = 0.0f;
+                for (size_t c = 4; c-- > 0;) {
+                    sum_squares += q[c] * q[c] * static_cast<float>(1 - is_largest[c][i]);
+                }
+                const float rebuilt = std::sqrt(maths_util::max(0.0f, 1.0f - sum_squares));
+                _w[i] = (is_largest[0][i] != 0) ? rebuilt : q[0];
+                _x[i] = (is_largest[1][i] != 0) ? rebuilt : q[1];
+                _y[i] = (is_largest[2][i] != 0) ? rebuilt : q[2];
+                _z[i] = (is_largest[3][i] != 0) ? rebuilt : q[3];
+            }
+        }
+    }
+
+    size_t rotation_track::words_per_key() const {
+        return (encoding_ == rotation_encoding::smallest_three_48) ? 3 : 2;
+    }
+
+    rotation_track::rotation_track(std::span<const quaternion> _keys, float _sample_rate, rotation_encoding _encoding)
+            : encoding_(_encoding), sample_rate_(_sample_rate), num_keys_(_keys.size()), range_min_{}, range_extent_{} {
+        // Make the largest component of every key positive, so that its sign does not need to be stored.
+        std::vector<std::array<float, 4>> keys;
+        std::vector<size_t> largest;
+        keys.reserve(num_keys_);
+        largest.reserve(num_keys_);
+        for (const auto& key: _keys) {
+            std::array<float, 4> q = to_array(key.normalised());
+            const size_t index = largest_component(q);
+            if (q[index] < 0.0f) {
+                for (auto& component: q) { component = -component; }
+            }
+            keys.push_back(q);
+            largest.push_back(index);
+        }
+
+        // Find the range of each component, ignoring the keys where that component is the one which is not stored.
+        std::array<float, 4> range_max{};
+        range_min_.fill(std::numeric_limits<float>::max());
+        range_max.fill(std::numeric_limits<float>::lowest());
+        for (size_t k = 0; k < num_keys_; ++k) {
+            for (size_t i = 0; i < 4; ++i) {
+                if (i == largest[k]) { continue; }
+                range_min_[i] = maths_util::min(range_min_[i], keys[k][i]);
+                range_max[i] = maths_util::max(range_max[i], keys[k][i]);
+            }
+        }
+        for (size_t i = 0; i < 4; ++i) {
+            if (range_max[i] < range_min_[i]) { range_min_[i] = range_max[i] = 0.0f; }
+            range_extent_[i] = range_max[i] - range_min_[i];
+        }
+
+        // Quantise and pack the keys.
+        const std::uint32_t bits = component_bits(encoding_);
+        const float max_quantised = static_cast<float>((1u << bits) - 1u);
+        data_.reserve(num_keys_ * words_per_key());
+        for (size_t k = 0; k < num_keys_; ++k) {
+            std::uint64_t packed = largest[k];
+            for (size_t i = 0; i < 4; ++i) {
+                if (i == largest[k]) { continue; }
+                const float normalised = (range_extent_[i] > 0.0f) ? (keys[k][i] - range_min_[i]) / range_extent_[i] : 0.0f;
+                const auto quantised = static_cast<std::uint64_t>(std::lround(maths_util::clamp(normalised, 0.0f, 1.0f) * max_quantised));
+                packed = (packed << bits) | quantised;
+            }
+            for (size_t w = 0; w < words_per_key(); ++w) {
+                data_.push_back(static_cast<std::uint16_t>(packed >> (16 * w)));
+            }
+        }
+    }
+
+    size_t rotation_track::size_in_bytes() const {
+        return data_.size() * sizeof(std::uint16_t) + sizeof(range_min_) + sizeof(range_extent_);
+    }
+
+    quaternion rotation_track::key(size_t _index) const {
+        const std::uint32_t bits = component_bits(encoding_);
+        const std::uint64_t mask = (1u << bits) - 1u;
+        const float scale = 1.0f / static_cast<float>(mask);
+
+        const size_t words = words_per_key();
+        const std::uint16_t* key_data = &data_[_index * words];
+        std::uint64_t packed = 0;
+        for (size_t w = 0; w < words; ++w) {
+            packed |= static_cast<std::uint64_t>(key_data[w]) << (16 * w);
+        }
+
+        // The components were packed from w to z, so they are unpacked from z to w.
+        const auto largest = static_cast<size_t>(packed >> (3 * bits));
+        std::array<float, 4> q{};
+        float sum_squares = 0.0f;
+        for (size_t i = 4; i-- > 0;) {
+            if (i == largest) { continue; }
+            q[i] = range_min_[i] + static_cast<float>(packed & mask) * scale * range_extent_[i];
+            sum_squares += q[i] * q[i];
+            packed >>= bits;
+        }
+        q[largest] = std::sqrt(maths_util::max(0.0f, 1.0f - sum_squares));
+        return quaternion{q[0], q[1], q[2], q[3]};
+    }
+
+    quaternion rotation_track::sample(float _time) const {
+        quaternion result;
+        sample_pose(std::span<const rotation_track>{this, 1}, _time, std::span<quaternion>{&result, 1});
+        return result;
+    }
+
+    void rotation_track::sample_pose(std::span<const rotation_track> _tracks, float _time, std::span<quaternion> _pose) {
+        // Read the packed keys and the ranges of the tracks into a structure of arrays in batches, so that the keys can be
+        // decoded and interpolated with vectorised loops.
+        track_batch tracks;
+        std::uint32_t start_low[sample_batch_size], start_high[sample_batch_size], end_low[sample_batch_size], end_high[sample_batch_size];
+        float start_w[sample_batch_size], start_x[sample_batch_size], start_y[sample_batch_size], start_z[sample_batch_size];
+        float end_w[sample_batch_size], end_x[sample_batch_size], end_y[sample_batch_size], end_z[sample_batch_size];
+        float ratio[sample_batch_size];
+
+        for (size_t batch_start = 0; batch_start < _tracks.size(); batch_start += sample_batch_size) {
+            const size_t batch_size = maths_util::min(sample_batch_size, _tracks.size() - batch_start);
+
+            for (size_t i = 0; i < batch_size; ++i) {
+                const rotation_track& track = _tracks[batch_start + i];
+                const float key_time = maths_util::clamp(_time * track.sample_rate_, 0.0f, static_cast<float>(track.num_keys_ - 1));
+                const size_t start_key = maths_util::min(static_cast<size_t>(key_time), track.num_keys_ - 1);
+                const size_t end_key = maths_util::min(start_key + 1, track.num_keys_ - 1);
+                ratio[i] = key_time - static_cast<float>(start_key);
+
+                const size_t words = track.words_per_key();
+                const std::uint16_t* start_data = &track.data_[start_key * words];
+                const std::uint16_t* end_data = &track.data_[end_key * words];
+                start_low[i] = static_cast<std::uint32_t>(start_data[0]) | (static_cast<std::uint32_t>(start_data[1]) << 16);
+                end_low[i] = static_cast<std::uint32_t>(end_data[0]) | (static_cast<std::uint32_t>(end_data[1]) << 16);
+                start_high[i] = (words > 2) ? start_data[2] : 0u;
+                end_high[i] = (words > 2) ? end_data[2] : 0u;
+
+                tracks.is_48_[i] = track.encoding_ == rotation_encoding::smallest_three_48;
+                for (size_t c = 0; c < 4; ++c) {
+                    tracks.range_min_[c][i] = track.range_min_[c];
+                    tracks.range_extent_[c][i] = track.range_extent_[c];
+                }
+            }
+
+            decode_keys(tracks, start_low, start_high, batch_size, start_w, start_x, start_y, start_z);
+            decode_keys(tracks, end_low, end_high, batch_size, end_w, end_x, end_y, end_z);
+
+            // Shortest path nlerp. Neighbouring keys are close together, so nlerp is as good as slerp here.
+            quaternion* pose = &_pose[batch_start];
+            for (size_t i = 0; i < batch_size; ++i) {
+                const float dot = start_w[i] * end_w[i] + start_x[i] * end_x[i] + start_y[i] * end_y[i] + start_z[i] * end_z[i];
+                const float end_ratio = (dot < 0.0f) ? -ratio[i] : ratio[i];
+                const float start_ratio = 1.0f - ratio[i];
+                const float w = start_ratio * start_w[i] + end_ratio * end_w[i];
+                const float x = start_ratio * start_x[i] + end_ratio * end_x[i];
+                const float y = start_ratio * start_y[i] + end_ratio * end_y[i];
+                const float z = start_ratio * start_z[i] + end_ratio * end_z[i];
+                const float inv_length = 1.0f / std::sqrt(w * w + x * x + y * y + z * z);
+                pose[i].w_ = w * inv_length;
+                pose[i].x_ = x * inv_length;
+                pose[i].y_ = y * inv_length;
+                pose[i].z_ = z * inv_length;
+            }
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "maths/quaternion.h"
+
+namespace mkr {
+    /**
+     * The compressed formats a rotation_track can store its keys in.
+     *
+     * Both use the smallest three encoding: the largest component (by magnitude) of a unit quaternion can be rebuilt from
+     * the other three, so only its index (2 bits) and the other three components are stored.
+     */
+    enum class rotation_encoding {
+        /// 2 bits for the index of the largest component, and 15 bits for each of the other components. 6 bytes per key.
+        smallest_three_48,
+        /// 2 bits for the index of the largest component, and 10 bits for each of the other components. 4 bytes per key.
+        smallest_three_32,
+    };
+
+    /**
+     * A track of rotation keys, sampled at a fixed rate, stored in a compressed format.
+     *
+     * The 3 stored components of each key are quantised within the range of values that component takes over the whole
+     * track, rather than the full range of [-1/√2, 1/√2]. Tracks which only rotate a little get much better precision.
+     */
+    class rotation_track {
+    private:
+        rotation_encoding encoding_;
+        float sample_rate_;
+        size_t num_keys_;
+        /// The minimum value of each component (w, x, y, z) over the track.
+        std::array<float, 4> range_min_;
+        /// The range of values of each component (w, x, y, z) over the track.
+        std::array<float, 4> range_extent_;
+        /// The packed keys. Each key uses 3 (48 bit encoding) or 2 (32 bit encoding) words.
+        std::vector<std::uint16_t> data_;
+
+        [[nodiscard]] size_t words_per_key() const;
+
+    public:
+        /**
+         * Compresses a sequence of rotations into a track.
+         * @param _keys The rotation at each key. The first key is at time 0.
+         * @param _sample_rate The number of keys per second.
+         * @param _encoding The compressed format to store the keys in.
+         * @warning _keys must not be empty, and must be rotational quaternions.
+         * @warning _sample_rate must be greater than 0.
+         */
+        rotation_track(std::span<const quaternion> _keys, float _sample_rate,
+                       rotation_encoding _encoding = rotation_encoding::smallest_three_48);
+
+        /**
+         * Samples the rotation of many tracks at the same time, such as all the bones of a skeleton.
+         * The keys on either side of _time are decoded, interpolated and renormalised.
+         * The packed keys are read from each track in turn, and then decoded, interpolated and renormalised in batches,
+         * with loops that the compiler can vectorise.
+         * @param _tracks The tracks to sample.
+         * @param _time The time to sample the tracks at, in seconds. It is clamped to the duration of each track.
+         * @param _pose The sampled rotation of each track.
+         * @warning _tracks and _pose must be the same size.
+         */
+        static void sample_pose(std::span<const rotation_track> _tracks, float _time, std::span<quaternion> _pose);
+
+        /**
+         * Returns the encoding of the keys.
+         * @return The encoding of the keys.
+         */
+        [[nodiscard]] rotation_encoding encoding() const { return encoding_; }
+
+        /**
+         * Returns the number of keys per second.
+         * @return The number of keys per second.
+         */
+        [[nodiscard]] float sample_rate() const { return sample_rate_; }
+
+        /**
+         * Returns the number of keys.
+         * @return The number of keys.
+         */
+        [[nodiscard]] size_t num_keys() const { return num_keys_; }
+
+        /**
+         * Returns the time of the last key, in seconds.
+         * @return The time of the last key, in seconds.
+         */
+        [[nodiscard]] float duration() const { return static_cast<float>(num_keys_ - 1) / sample_rate_; }
+
+        /**
+         * Returns the memory used by the keys and their ranges, in bytes.
+         * @return The memory used by the keys and their ranges, in bytes.
+         */
+        [[nodiscard]] size_t size_in_bytes() const;
+
+        /**
+         * Decodes a key.
+         * @param _index The index of the key.
+         * @return The rotation of the key.
+         */
+        [[nodiscard]] quaternion key(size_t _index) const;
+
+        /**
+         * Samples the rotation of this track.
+         * @param _time The time to sample the track at, in seconds. It is clamped to the duration of the track.
+         * @return The rotation at _time.
+         */
+        [[nodiscard]] quaternion sample(float _time) const;
+    };
+}
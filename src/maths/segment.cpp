@@ -0,0 +1,101 @@
+#include "maths/segment.h"
+#include "maths/vector3_block.h"
+
+namespace mkr {
+    segment::segment(const vector3& _start, const vector3& _end)
+            : start_(_start), end_(_end) {}
+
+    vector3 segment::direction() const {
+        return end_ - start_;
+    }
+
+    float segment::length() const {
+        return direction().length();
+    }
+
+    line segment::to_line() const {
+        return line{start_, direction()};
+    }
+
+    vector3 segment::point_at(float _t) const {
+        return start_ + direction() * _t;
+    }
+
+    vector3 segment::closest_point(const vector3& _point) const {
+        // Same as line::closest_point, with the result clamped to the ends of the segment.
+        const vector3 d = direction();
+        const float length_squared = d.length_squared();
+        if (length_squared <= std::numeric_limits<float>::epsilon()) {
+            return start_;
+        }
+        return point_at(maths_util::clamp(d.dot(_point - start_) / length_squared, 0.0f, 1.0f));
+    }
+
+    std::pair<vector3, vector3> segment::closest_points(const segment& _segment) const {
+        float s, t, distance_squared;
+        closest_points(std::span<const segment>{&_segment, 1}, std::span<float>{&s, 1}, std::span<float>{&t, 1},
+                       std::span<float>{&distance_squared, 1});
+        return std::make_pair(point_at(s), _segment.point_at(t));
+    }
+
+    void segment::closest_points(std::span<const segment> _segments, std::span<float> _s, std::span<float> _t,
+                                 std::span<float> _distance_squared) const {
+        /**
+         * Let the segments be P + sD and Q + tE, where 0 <= s, t <= 1, and R = P - Q.
+         * Let a = D·D, b = D·E, c = D·R, e = E·E and f = E·R.
+         * [Real-Time Collision Detection, Christer Ericson 2005, 5.1.9]
+         *
+         * As in line::closest_points, the closest points of the infinite lines are at
+         * s = (bf - ce) / (ae - b²), clamped to [0, 1].
+         *
+         * For a fixed s, the closest point on the other segment is at t = (bs + f) / e, clamped to [0, 1].
+         * For a fixed t, the closest point on this segment is at s = (bt - c) / a, clamped to [0, 1].
+         *
+         * The squared distance is a convex function of s and t, so after clamping t, recalculating s gives the closest
+         * points. If t did not need clamping, recalculating s gives the same s.
+         *
+         * Degenerate segments (a or e is 0) and parallel segments (ae - b² is 0) use s = 0 or t = 0 instead of dividing
+         * by 0. Every case is a select rather than a branch, so that the loop can be vectorised.
+         */
+        constexpr float epsilon = std::numeric_limits<float>::epsilon();
+        const float px = start_.x_, py = start_.y_, pz = start_.z_;
+        const float dx = end_.x_ - px, dy = end_.y_ - py, dz = end_.z_ - pz;
+        const float a = dx * dx + dy * dy + dz * dz;
+        const float inv_a = (a > epsilon) ? 1.0f / a : 0.0f;
+
+        vector3_block starts, directions;
+        vector3_block::for_each_block(_segments.size(), [&](size_t _block_start, size_t _block_size) {
+            for (size_t i = 0; i < _block_size; ++i) {
+                const segment& other = _segments[_block_start + i];
+                starts.set(i, other.start_);
+                directions.set(i, other.end_.x_ - other.start_.x_, other.end_.y_ - other.start_.y_, other.end_.z_ - other.start_.z_);
+            }
+
+            float* __restrict s_out = &_s[_block_start];
+            float* __restrict t_out = &_t[_block_start];
+            float* __restrict distance_squared_out = &_distance_squared[_block_start];
+            for (size_t i = 0; i < _block_size; ++i) {
+                const float ex = directions.x_[i], ey = directions.y_[i], ez = directions.z_[i];
+                const float rx = px - starts.x_[i], ry = py - starts.y_[i], rz = pz - starts.z_[i];
+                const float b = dx * ex + dy * ey + dz * ez;
+                const float c = dx * rx + dy * ry + dz * rz;
+                const float e = ex * ex + ey * ey + ez * ez;
+                const float f = ex * rx + ey * ry + ez * rz;
+                const float denominator = a * e - b * b;
+
+                // Dividing by 1 instead of 0 and then selecting 0 keeps the divisions unconditional.
+                const bool is_parallel = denominator <= epsilon * a * e;
+                float s = maths_util::clamp((b * f - c * e) / (is_parallel ? 1.0f : denominator), 0.0f, 1.0f);
+                s = is_parallel ? 0.0f : s;
+                float t = maths_util::clamp((b * s + f) / ((e > epsilon) ? e : 1.0f), 0.0f, 1.0f);
+                t = (e > epsilon) ? t : 0.0f;
+                s = maths_util::clamp((b * t - c) * inv_a, 0.0f, 1.0f);
+
+                const float x = rx + dx * s - ex * t, y = ry + dy * s - ey * t, z = rz + dz * s - ez * t;
+                s_out[i] = s;
+                t_out[i] = t;
+                distance_squared_out[i] = x * x + y * y + z * z;
+            }
+        });
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <span>
+#include <utility>
+#include "maths/line.h"
+
+namespace mkr {
+    /**
+     * A line segment between 2 points, represented by the formula start + t(end - start), where 0 <= t <= 1.
+     */
+    class segment {
+    public:
+        /// The start point of the segment.
+        vector3 start_;
+        /// The end point of the segment.
+        vector3 end_;
+
+        /**
+         * Constructs the segment.
+         * @param _start The start point of the segment.
+         * @param _end The end point of the segment.
+         */
+        segment(const vector3& _start = vector3::zero(), const vector3& _end = vector3::zero());
+
+        /**
+         * Returns the vector from the start to the end of the segment.
+         * @return The vector from the start to the end of the segment.
+         */
+        [[nodiscard]] vector3 direction() const;
+
+        /**
+         * Returns the length of the segment.
+         * @return The length of the segment.
+         */
+        [[nodiscard]] float length() const;
+
+        /**
+         * Returns the line which the segment lies on.
+         * @return The line which the segment lies on.
+         */
+        [[nodiscard]] line to_line() const;
+
+        /**
+         * Returns the point of the segment at t.
+         * @param _t The value of t in the segment formula.
+         * @return The point start + t(end - start).
+         */
+        [[nodiscard]] vector3 point_at(float _t) const;
+
+        /**
+         * Returns the point on this segment closest to a given point.
+         * @param _point The given point.
+         * @return The point on this segment closest to a given point.
+         */
+        [[nodiscard]] vector3 closest_point(const vector3& _point) const;
+
+        /**
+         * Returns the closest points between 2 segments.
+         * If the segments are parallel and overlap, one of the pairs of closest points is returned.
+         * @param _segment The other segment.
+         * @return The point on this segment, and the point on _segment, which are closest to each other.
+         */
+        [[nodiscard]] std::pair<vector3, vector3> closest_points(const segment& _segment) const;
+
+        /**
+         * Finds the closest points between this segment and many segments, such as a capsule against many capsules.
+         * @param _segments The other segments.
+         * @param _s The value of t on this segment for each segment.
+         * @param _t The value of t on the other segment for each segment.
+         * @param _distance_squared The squared distance between the closest points for each segment.
+         * @warning _segments, _s, _t and _distance_squared must be the same size.
+         */
+        void closest_points(std::span<const segment> _segments, std::span<float> _s, std::span<float> _t,
+                            std::span<float> _distance_squared) const;
+    };
+}
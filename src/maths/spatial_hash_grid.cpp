@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <future>
+#include <thread>
+#include "maths/spatial_hash_grid.h"
+
+namespace mkr {
+    namespace {
+        /// Each thread of a parallel build handles at least this many points.
+        constexpr size_t parallel_threshold = 65536;
+        /// Queries which cover up to this many cells skip repeated buckets with a fixed size list, instead of sorting the results.
+        constexpr size_t max_tracked_buckets = 64;
+        /**
+         * Cell coordinates are clamped to [-max_cell, max_cell], so that converting them to an integer is defined for any
+         * coordinate and cell size, and the number of cells between two of them fits in an int64. Clamping keeps the cells
+         * in order, so a point within the radius of a query is still in one of the cells the query searches.
+         */
+        constexpr float max_cell = 1073741824.0f; // 2^30
+
+        /// Calls _function(i) for i in [0, _count), each on its own thread, and waits for them to finish.
+        template<typename Function>
+        void parallel_for(size_t _count, Function _function) {
+            std::vector<std::future<void>> futures;
+            futures.reserve(_count);
+            for (size_t i = 1; i < _count; ++i) {
+                futures.push_back(std::async(std::launch::async, _function, i));
+            }
+            _function(0);
+            for (auto& future: futures) {
+                future.get();
+            }
+        }
+    }
+
+    spatial_hash_grid::spatial_hash_grid(float _cell_size)
+            : cell_size_(_cell_size), inv_cell_size_(1.0f / _cell_size) {}
+
+    std::uint32_t spatial_hash_grid::bucket(std::int32_t _x, std::int32_t _y, std::int32_t _z) const {
+        // [Optimized Spatial Hashing for Collision Detection of Deformable Objects, Teschner et al. 2003]
+        const std::uint32_t hash = (static_cast<std::uint32_t>(_x) * 73856093u) ^
+                                   (static_cast<std::uint32_t>(_y) * 19349663u) ^
+                                   (static_cast<std::uint32_t>(_z) * 83492791u);
+        // The number of buckets is a power of 2.
+        return hash & static_cast<std::uint32_t>(bucket_starts_.size() - 2);
+    }
+
+    std::int32_t spatial_hash_grid::cell(float _coordinate) const {
+        float cell = std::floor(_coordinate * inv_cell_size_);
+        // NaN becomes -max_cell.
+        cell = (cell > -max_cell) ? cell : -max_cell;
+        cell = (cell < max_cell) ? cell : max_cell;
+        return static_cast<std::int32_t>(cell);
+    }
+
+    void spatial_hash_grid::build(std::span<const vector3> _points) {
+        /**
+         * Counting sort.
+         * 1. Find the bucket of every point, and count the points in each bucket.
+         * 2. The start of each bucket is the sum of the counts of the buckets before it.
+         * 3. Copy each point to the next free slot of its bucket.
+         *
+         * For a parallel build, the points are split into one chunk per thread, and each thread counts its chunk
+         * separately. In step 2, each bucket is then split into one range per thread, in chunk order, so that in step 3
+         * every thread copies its points into its own ranges, and the points of each bucket stay in their original order.
+         */
+        const size_t num_points = _points.size();
+        const size_t num_buckets = std::bit_ceil(maths_util::max<size_t>(64, num_points * 2));
+        const size_t num_threads = maths_util::max<size_t>(1, maths_util::min<size_t>(std::thread::hardware_concurrency(), num_points / parallel_threshold));
+
+        bucket_starts_.resize(num_buckets + 1);
+        sorted_points_.resize(num_points);
+        sorted_indices_.resize(num_points);
+        point_buckets_.resize(num_points);
+        thread_counts_.assign(num_threads * num_buckets, 0);
+
+        const auto chunk_begin = [&](size_t _thread) { return _thread * num_points / num_threads; };
+
+        parallel_for(num_threads, [&](size_t _thread) {
+            std::uint32_t* counts = &thread_counts_[_thread * num_buckets];
+            for (size_t i = chunk_begin(_thread); i < chunk_begin(_thread + 1); ++i) {
+                const std::uint32_t b = bucket(cell(_points[i].x_), cell(_points[i].y_), cell(_points[i].z_));
+                point_buckets_[i] = b;
+                ++counts[b];
+            }
+        });
+
+        // Turn the counts into the index each thread writes the next point of each bucket to.
+        std::uint32_t offset = 0;
+        for (size_t b = 0; b < num_buckets; ++b) {
+            bucket_starts_[b] = offset;
+            for (size_t thread = 0; thread < num_threads; ++thread) {
+                const std::uint32_t count = thread_counts_[thread * num_buckets + b];
+                thread_counts_[thread * num_buckets + b] = offset;
+                offset += count;
+            }
+        }
+        bucket_starts_[num_buckets] = offset;
+
+        parallel_for(num_threads, [&](size_t _thread) {
+            std::uint32_t* next = &thread_counts_[_thread * num_buckets];
+            for (size_t i = chunk_begin(_thread); i < chunk_begin(_thread + 1); ++i) {
+                const std::uint32_t destination = next[point_buckets_[i]]++;
+                sorted_points_[destination] = _points[i];
+                sorted_indices_[destination] = static_cast<std::uint32_t>(i);
+            }
+        });
+    }
+
+    void spatial_hash_grid::query(const vector3& _centre, float _radius, std::vector<std::uint32_t>& _result) const {
+        if (sorted_points_.empty()) { return; }
+
+        const std::int32_t min_x = cell(_centre.x_ - _radius), max_x = cell(_centre.x_ + _radius);
+        const std::int32_t min_y = cell(_centre.y_ - _radius), max_y = cell(_centre.y_ + _radius);
+        const std::int32_t min_z = cell(_centre.z_ - _radius), max_z = cell(_centre.z_ + _radius);
+        const auto extent = [](std::int32_t _min, std::int32_t _max) { return static_cast<std::int64_t>(_max) - _min + 1; };
+        // Found as a double, since the product can overflow any integer.
+        const double num_cells = static_cast<double>(extent(min_x, max_x)) * static_cast<double>(extent(min_y, max_y)) *
+                                 static_cast<double>(extent(min_z, max_z));
+        const float radius_squared = _radius * _radius;
+
+        // Each cell maps to a bucket, so a query covering more cells than there are buckets searches every bucket anyway,
+        // and is faster done by searching every point once.
+        if (num_cells > static_cast<double>(bucket_starts_.size() - 1)) {
+            for (size_t i = 0; i < sorted_points_.size(); ++i) {
+                const vector3& point = sorted_points_[i];
+                const float dx = point.x_ - _centre.x_, dy = point.y_ - _centre.y_, dz = point.z_ - _centre.z_;
+                if (dx * dx + dy * dy + dz * dz <= radius_squared) {
+                    _result.push_back(sorted_indices_[i]);
+                }
+            }
+            return;
+        }
+
+        // Different cells can hash to the same bucket, and each bucket must only be searched once.
+        const bool track_buckets = num_cells <= static_cast<double>(max_tracked_buckets);
+        std::array<std::uint32_t, max_tracked_buckets> searched;
+        size_t num_searched = 0;
+        const size_t result_start = _result.size();
+
+        for (std::int32_t z = min_z; z <= max_z; ++z) {
+            for (std::int32_t y = min_y; y <= max_y; ++y) {
+                for (std::int32_t x = min_x; x <= max_x; ++x) {
+                    const std::uint32_t b = bucket(x, y, z);
+                    if (track_buckets) {
+                        if (std::find(searched.begin(), searched.begin() + num_searched, b) != searched.begin() + num_searched) { continue; }
+                        searched[num_searched++] = b;
+                    }
+
+                    for (std::uint32_t i = bucket_starts_[b]; i < bucket_starts_[b + 1]; ++i) {
+                        const vector3& point = sorted_points_[i];
+                        const float dx = point.x_ - _centre.x_, dy = point.y_ - _centre.y_, dz = point.z_ - _centre.z_;
+                        if (dx * dx + dy * dy + dz * dz <= radius_squared) {
+                            _result.push_back(sorted_indices_[i]);
+                        }
+                    }
+                }
+            }
+        }
+
+        if (!track_buckets) {
+            std::sort(_result.begin() + static_cast<std::ptrdiff_t>(result_start), _result.end());
+            _result.erase(std::unique(_result.begin() + static_cast<std::ptrdiff_t>(result_start), _result.end()), _result.end());
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "maths/vector3.h"
+
+namespace mkr {
+    /**
+     * A uniform grid of cells over unbounded space, for finding the points near a position.
+     *
+     * Cells are mapped to a fixed number of buckets by hashing their integer coordinates, so the grid needs no bounds.
+     * The points are sorted into their buckets with a counting sort, so each bucket is a contiguous range of one array
+     * and rebuilding the grid allocates nothing once its arrays are large enough. Large point sets are counted and
+     * scattered in parallel.
+     */
+    class spatial_hash_grid {
+    private:
+        float cell_size_;
+        float inv_cell_size_;
+        /// bucket_starts_[i] is the index of the first point of bucket i in sorted_points_, and bucket_starts_[i + 1] is the end.
+        std::vector<std::uint32_t> bucket_starts_;
+        /// The points, sorted by bucket.
+        std::vector<vector3> sorted_points_;
+        /// The index of each point of sorted_points_ in the points the grid was built from.
+        std::vector<std::uint32_t> sorted_indices_;
+        /// The bucket of each point, in the order the points were given to build.
+        std::vector<std::uint32_t> point_buckets_;
+        /// The per thread bucket counts of a parallel build.
+        std::vector<std::uint32_t> thread_counts_;
+
+        [[nodiscard]] std::uint32_t bucket(std::int32_t _x, std::int32_t _y, std::int32_t _z) const;
+
+        [[nodiscard]] std::int32_t cell(float _coordinate) const;
+
+    public:
+        /**
+         * Constructs an empty grid.
+         * @param _cell_size The size of each cell. Queries are fastest when the radius is about the size of a cell.
+         * @warning _cell_size must be greater than 0.
+         */
+        explicit spatial_hash_grid(float _cell_size);
+
+        /**
+         * Returns the size of each cell.
+         * @return The size of each cell.
+         */
+        [[nodiscard]] float cell_size() const { return cell_size_; }
+
+        /**
+         * Returns the number of points in the grid.
+         * @return The number of points in the grid.
+         */
+        [[nodiscard]] size_t size() const { return sorted_points_.size(); }
+
+        /**
+         * Rebuilds the grid from a set of points, replacing the previous points.
+         * @param _points The points.
+         */
+        void build(std::span<const vector3> _points);
+
+        /**
+         * Finds every point within a distance of a position.
+         * @param _centre The position.
+         * @param _radius The distance.
+         * @param _result The indices of the points, in the span given to build, are appended to _result.
+         */
+        void query(const vector3& _centre, float _radius, std::vector<std::uint32_t>& _result) const;
+    };
+}
@@ -0,0 +1,220 @@
+#include <array>
+#include "maths/sphere.h"
+
+namespace mkr {
+    namespace {
+        /// The relative tolerance used when checking if a point lies in a sphere while building it, to absorb rounding errors.
+        constexpr float build_tolerance = 1e-5f;
+
+        inline float distance_squared(const vector3& _a, const vector3& _b) {
+            const float x = _a.x_ - _b.x_, y = _a.y_ - _b.y_, z = _a.z_ - _b.z_;
+            return x * x + y * y + z * z;
+        }
+
+        inline bool contains_loose(const sphere& _sphere, const vector3& _point) {
+            return distance_squared(_sphere.centre_, _point) <= _sphere.radius_ * _sphere.radius_ * (1.0f + build_tolerance);
+        }
+
+        /// The smallest sphere with 2 points on its surface.
+        sphere circumsphere(const vector3& _a, const vector3& _b) {
+            return sphere{(_a + _b) * 0.5f, std::sqrt(distance_squared(_a, _b)) * 0.5f};
+        }
+
+        /// The smallest sphere with 3 points on its surface.
+        sphere circumsphere(const vector3& _a, const vector3& _b, const vector3& _c) {
+            /**
+             * Let AB = B - A, AC = C - A and N = AB ✕ AC.
+             * The centre lies on the plane of the triangle, at
+             * A + (|AC|²(N ✕ AB) + |AB|²(AC ✕ N)) / 2|N|²
+             */
+            const vector3 ab = _b - _a;
+            const vector3 ac = _c - _a;
+            const vector3 n = ab.cross(ac);
+            const float denominator = 2.0f * n.length_squared();
+
+            // The points are in a line, so the sphere is around the 2 furthest points.
+            if (denominator <= std::numeric_limits<float>::epsilon() * ab.length_squared() * ac.length_squared()) {
+                const sphere candidates[3] = {circumsphere(_a, _b), circumsphere(_a, _c), circumsphere(_b, _c)};
+                const sphere* largest = &candidates[0];
+                for (const auto& candidate: candidates) {
+                    if (candidate.radius_ > largest->radius_) { largest = &candidate; }
+                }
+                return *largest;
+            }
+
+            const vector3 offset = (n.cross(ab) * ac.length_squared() + ac.cross(n) * ab.length_squared()) * (1.0f / denominator);
+            return sphere{_a + offset, offset.length()};
+        }
+
+        /// The smallest sphere with 4 points on its surface.
+        sphere circumsphere(const vector3& _a, const vector3& _b, const vector3& _c, const vector3& _d) {
+            /**
+             * Let AB = B - A, AC = C - A and AD = D - A.
+             * The centre is at
+             * A + (|AD|²(AB ✕ AC) + |AC|²(AD ✕ AB) + |AB|²(AC ✕ AD)) / 2(AB · (AC ✕ AD))
+             */
+            const vector3 ab = _b - _a;
+            const vector3 ac = _c - _a;
+            const vector3 ad = _d - _a;
+            const float denominator = 2.0f * ab.dot(ac.cross(ad));
+
+            // The points are on a plane, so use the smallest sphere through 3 of them which contains the 4th.
+            if (std::fabs(denominator) <= std::numeric_limits<float>::epsilon() * ab.length() * ac.length() * ad.length()) {
+                const std::array<sphere, 4> candidates = {circumsphere(_a, _b, _c), circumsphere(_a, _b, _d),
+                                                          circumsphere(_a, _c, _d), circumsphere(_b, _c, _d)};
+                const vector3 opposite[4] = {_d, _c, _b, _a};
+                const sphere* best = nullptr;
+                for (size_t i = 0; i < candidates.size(); ++i) {
+                    if (contains_loose(candidates[i], opposite[i]) && (!best || candidates[i].radius_ < best->radius_)) {
+                        best = &candidates[i];
+                    }
+                }
+                return best ? *best : candidates[0];
+            }
+
+            const vector3 offset = (ab.cross(ac) * ad.length_squared() + ad.cross(ab) * ac.length_squared() +
+                                    ac.cross(ad) * ab.length_squared()) * (1.0f / denominator);
+            return sphere{_a + offset, offset.length()};
+        }
+    }
+
+    sphere::sphere(const vector3& _centre, float _radius)
+            : centre_(_centre), radius_(_radius) {}
+
+    sphere sphere::from_points_ritter(std::span<const vector3> _points) {
+        /**
+         * Ritter's algorithm.
+         * [Graphics Gems, "An Efficient Bounding Sphere", Jack Ritter 1990]
+         *
+         * 1. Find the points with the smallest and largest x, y and z. Start with the sphere around the pair which is
+         *    furthest apart.
+         * 2. For each point outside the sphere, grow the sphere just enough to contain both the old sphere and the point.
+         *    The new sphere touches the point, and the side of the old sphere furthest from the point.
+         */
+        std::array<size_t, 3> min_index{}, max_index{};
+        for (size_t i = 1; i < _points.size(); ++i) {
+            const vector3& point = _points[i];
+            if (point.x_ < _points[min_index[0]].x_) { min_index[0] = i; }
+            if (point.y_ < _points[min_index[1]].y_) { min_index[1] = i; }
+            if (point.z_ < _points[min_index[2]].z_) { min_index[2] = i; }
+            if (point.x_ > _points[max_index[0]].x_) { max_index[0] = i; }
+            if (point.y_ > _points[max_index[1]].y_) { max_index[1] = i; }
+            if (point.z_ > _points[max_index[2]].z_) { max_index[2] = i; }
+        }
+
+        size_t widest_axis = 0;
+        float widest = -1.0f;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            const float span = distance_squared(_points[min_index[axis]], _points[max_index[axis]]);
+            if (span > widest) {
+                widest = span;
+                widest_axis = axis;
+            }
+        }
+
+        sphere result = circumsphere(_points[min_index[widest_axis]], _points[max_index[widest_axis]]);
+        float cx = result.centre_.x_, cy = result.centre_.y_, cz = result.centre_.z_;
+        float radius = result.radius_;
+        for (const auto& point: _points) {
+            const float dx = point.x_ - cx, dy = point.y_ - cy, dz = point.z_ - cz;
+            const float length_squared = dx * dx + dy * dy + dz * dz;
+            if (length_squared <= radius * radius) { continue; }
+
+            const float length = std::sqrt(length_squared);
+            const float new_radius = (radius + length) * 0.5f;
+            const float shift = (new_radius - radius) / length;
+            cx += dx * shift;
+            cy += dy * shift;
+            cz += dz * shift;
+            radius = new_radius;
+        }
+        return sphere{vector3{cx, cy, cz}, radius};
+    }
+
+    sphere sphere::from_points_welzl(std::span<const vector3> _points) {
+        /**
+         * Welzl's algorithm.
+         * [Emo Welzl 1991, "Smallest enclosing disks (balls and ellipsoids)"]
+         *
+         * The smallest sphere is defined by at most 4 points on its surface. Points are added one at a time. If a point
+         * is outside the current sphere, it must be on the surface of the smallest sphere of the points so far, so the
+         * sphere is rebuilt from the previous points with that point fixed on the surface. Each level of the recursion
+         * fixes one more point, and there are at most 4, so the recursion can be written as 4 nested loops.
+         */
+        sphere result{_points[0], 0.0f};
+        for (size_t i = 1; i < _points.size(); ++i) {
+            if (contains_loose(result, _points[i])) { continue; }
+
+            result = sphere{_points[i], 0.0f};
+            for (size_t j = 0; j < i; ++j) {
+                if (contains_loose(result, _points[j])) { continue; }
+
+                result = circumsphere(_points[i], _points[j]);
+                for (size_t k = 0; k < j; ++k) {
+                    if (contains_loose(result, _points[k])) { continue; }
+
+                    result = circumsphere(_points[i], _points[j], _points[k]);
+                    for (size_t l = 0; l < k; ++l) {
+                        if (contains_loose(result, _points[l])) { continue; }
+
+                        result = circumsphere(_points[i], _points[j], _points[k], _points[l]);
+                    }
+                }
+            }
+        }
+
+        // Grow the sphere by the tolerance, so that every point is inside it.
+        result.radius_ *= 1.0f + build_tolerance;
+        return result;
+    }
+
+    vector3 sphere::support(const vector3& _direction) const {
+        const float length = _direction.length();
+        return (length > std::numeric_limits<float>::epsilon()) ? centre_ + _direction * (radius_ / length) : centre_;
+    }
+
+    vector3 sphere::core_support(const vector3&) const {
+        return centre_;
+    }
+
+    bool sphere::contains(const vector3& _point) const {
+        return distance_squared(centre_, _point) <= radius_ * radius_;
+    }
+
+    bool sphere::overlaps(const sphere& _sphere) const {
+        const float radii = radius_ + _sphere.radius_;
+        return distance_squared(centre_, _sphere.centre_) <= radii * radii;
+    }
+
+    bool sphere::intersects(const plane& _plane) const {
+        return std::fabs(_plane.distance_to(centre_)) <= radius_;
+    }
+
+    bool sphere::is_behind(const plane& _plane) const {
+        return _plane.distance_to(centre_) < -radius_;
+    }
+
+    std::optional<std::pair<float, float>> sphere::intersect(const line& _line) const {
+        /**
+         * Let the line be P + λD, and the sphere have the centre C and radius r.
+         * Let M = P - C.
+         * The line is on the surface of the sphere where |M + λD|² = r².
+         * (D·D)λ² + 2(M·D)λ + (M·M - r²) = 0
+         *
+         * Let a = D·D, b = M·D and c = M·M - r².
+         * λ = (-b ± √(b² - ac)) / a
+         * The line misses the sphere if b² - ac < 0.
+         */
+        const vector3 m = _line.point_ - centre_;
+        const float a = _line.direction_.length_squared();
+        const float b = m.dot(_line.direction_);
+        const float c = m.length_squared() - radius_ * radius_;
+        const float discriminant = b * b - a * c;
+        if (discriminant < 0.0f || a == 0.0f) {
+            return std::nullopt;
+        }
+
+        const float root = std::sqrt(discriminant);
+        return std::make_pair((-b - root) / a, (-b + root) / a);
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <utility>
+#include "maths/plane.h"
+
+namespace mkr {
+    /**
+     * A sphere with a centre and a radius.
+     */
+    class sphere {
+    public:
+        /// The centre of the sphere.
+        vector3 centre_;
+        /// The radius of the sphere.
+        float radius_;
+
+        /**
+         * Constructs the sphere.
+         * @param _centre The centre of the sphere.
+         * @param _radius The radius of the sphere.
+         */
+        sphere(const vector3& _centre = vector3::zero(), float _radius = 0.0f);
+
+        /**
+         * Returns a sphere containing all the points, using Ritter's algorithm.
+         * The sphere is found in 2 passes over the points without allocating, and is usually 5% to 20% larger than the
+         * smallest sphere.
+         * @param _points The points.
+         * @return A sphere containing all the points.
+         * @warning _points must not be empty.
+         */
+        [[nodiscard]] static sphere from_points_ritter(std::span<const vector3> _points);
+
+        /**
+         * Returns the smallest sphere containing all the points, using Welzl's algorithm.
+         * The recursion is unrolled into nested loops, so nothing is allocated. The expected time is linear if the points
+         * are in a random order. Points which are sorted (such as a scanned grid) should be shuffled first.
+         * @param _points The points.
+         * @return The smallest sphere containing all the points.
+         * @warning _points must not be empty.
+         */
+        [[nodiscard]] static sphere from_points_welzl(std::span<const vector3> _points);
+
+        /**
+         * Returns the point of the sphere furthest along a direction.
+         * @param _direction The direction.
+         * @return The point of the sphere furthest along the direction.
+         */
+        [[nodiscard]] vector3 support(const vector3& _direction) const;
+
+        /**
+         * Returns the point of the core of the sphere furthest along a direction, for use with gjk.
+         * The core of a sphere is its centre.
+         * @param _direction The direction.
+         * @return The centre of the sphere.
+         */
+        [[nodiscard]] vector3 core_support(const vector3& _direction) const;
+
+        /**
+         * Checks if a point lies in the sphere.
+         * @param _point The point.
+         * @return Returns true if the point lies in or on the sphere, else returns false.
+         */
+        [[nodiscard]] bool contains(const vector3& _point) const;
+
+        /**
+         * Checks if 2 spheres overlap.
+         * @param _sphere The other sphere.
+         * @return Returns true if the spheres overlap or touch, else returns false.
+         */
+        [[nodiscard]] bool overlaps(const sphere& _sphere) const;
+
+        /**
+         * Checks if the sphere intersects a plane.
+         * @param _plane The plane.
+         * @return Returns true if the sphere intersects or touches the plane, else returns false.
+         */
+        [[nodiscard]] bool intersects(const plane& _plane) const;
+
+        /**
+         * Checks if the sphere is completely behind a plane (on the opposite side to the normal).
+         * @param _plane The plane.
+         * @return Returns true if the sphere is completely behind the plane, else returns false.
+         */
+        [[nodiscard]] bool is_behind(const plane& _plane) const;
+
+        /**
+         * Returns the range of λ in the line formula p + λd for which the line is inside the sphere.
+         * @param _line The line.
+         * @return The values of λ at which the line enters and leaves the sphere.
+         * @attention Returns std::nullopt if the line does not intersect the sphere.
+         */
+        [[nodiscard]] std::optional<std::pair<float, float>> intersect(const line& _line) const;
+    };
+}
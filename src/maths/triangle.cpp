@@ -0,0 +1,163 @@
+#include <cmath>
+#include <limits>
+#include "maths/triangle.h"
+
+namespace mkr {
+    namespace {
+        /**
+         * Möller–Trumbore ray-triangle intersection.
+         * [https://www.graphics.cornell.edu/pubs/1997/MT97.pdf]
+         *
+         * Let the line be P + λD.
+         * Let the triangle have the vertices A, B and C, with the edges E1 = B - A and E2 = C - A.
+         * A point of the triangle can be written in barycentric coordinates as A + uE1 + vE2, where u >= 0, v >= 0 and u + v <= 1.
+         *
+         * At the intersection point,
+         * P + λD = A + uE1 + vE2
+         * -λD + uE1 + vE2 = P - A
+         *
+         * Let S = P - A. Solving the 3x3 system using Cramer's rule, with Q = S ✕ E1 and R = D ✕ E2,
+         * det = E1·R
+         * u = S·R / det
+         * v = D·Q / det
+         * λ = E2·Q / det
+         *
+         * If det is 0, the line is parallel to the triangle, or the triangle is degenerate.
+         * det = D·(E2 ✕ E1) scales with |D|, |E1| and |E2|, so it is compared with epsilon scaled by |D||E1||E2|, the
+         * same as plane::intersect_point. A fixed epsilon would reject every hit on a small triangle.
+         *
+         * Every pair of the packets is tested without branches, so that the loop can be vectorised.
+         */
+        template<size_t N>
+        triangle_hits<N> intersect_packets(const line_packet<N>& _lines, const triangle_packet<N>& _triangles) {
+            constexpr float epsilon = std::numeric_limits<float>::epsilon();
+            triangle_hits<N> result{};
+            std::array<std::uint32_t, N> hit{};
+
+            for (size_t i = 0; i < N; ++i) {
+                const float r_x = _lines.direction_y_[i] * _triangles.edge_ac_z_[i] - _lines.direction_z_[i] * _triangles.edge_ac_y_[i];
+                const float r_y = _lines.direction_z_[i] * _triangles.edge_ac_x_[i] - _lines.direction_x_[i] * _triangles.edge_ac_z_[i];
+                const float r_z = _lines.direction_x_[i] * _triangles.edge_ac_y_[i] - _lines.direction_y_[i] * _triangles.edge_ac_x_[i];
+                const float det = _triangles.edge_ab_x_[i] * r_x + _triangles.edge_ab_y_[i] * r_y + _triangles.edge_ab_z_[i] * r_z;
+                const float direction_length = std::sqrt(_lines.direction_x_[i] * _lines.direction_x_[i] + _lines.direction_y_[i] * _lines.direction_y_[i] +
+                                                         _lines.direction_z_[i] * _lines.direction_z_[i]);
+                const float edge_ab_length = std::sqrt(_triangles.edge_ab_x_[i] * _triangles.edge_ab_x_[i] + _triangles.edge_ab_y_[i] * _triangles.edge_ab_y_[i] +
+                                                       _triangles.edge_ab_z_[i] * _triangles.edge_ab_z_[i]);
+                const float edge_ac_length = std::sqrt(_triangles.edge_ac_x_[i] * _triangles.edge_ac_x_[i] + _triangles.edge_ac_y_[i] * _triangles.edge_ac_y_[i] +
+                                                       _triangles.edge_ac_z_[i] * _triangles.edge_ac_z_[i]);
+                const bool intersects = std::fabs(det) > epsilon * direction_length * edge_ab_length * edge_ac_length;
+                const float inv_det = 1.0f / (intersects ? det : 1.0f);
+
+                const float s_x = _lines.point_x_[i] - _triangles.vertex_x_[i];
+                const float s_y = _lines.point_y_[i] - _triangles.vertex_y_[i];
+                const float s_z = _lines.point_z_[i] - _triangles.vertex_z_[i];
+                const float u = (s_x * r_x + s_y * r_y + s_z * r_z) * inv_det;
+
+                const float q_x = s_y * _triangles.edge_ab_z_[i] - s_z * _triangles.edge_ab_y_[i];
+                const float q_y = s_z * _triangles.edge_ab_x_[i] - s_x * _triangles.edge_ab_z_[i];
+                const float q_z = s_x * _triangles.edge_ab_y_[i] - s_y * _triangles.edge_ab_x_[i];
+                const float v = (_lines.direction_x_[i] * q_x + _lines.direction_y_[i] * q_y + _lines.direction_z_[i] * q_z) * inv_det;
+                const float distance = (_triangles.edge_ac_x_[i] * q_x + _triangles.edge_ac_y_[i] * q_y + _triangles.edge_ac_z_[i] * q_z) * inv_det;
+
+                result.distance_[i] = distance;
+                result.u_[i] = u;
+                result.v_[i] = v;
+                hit[i] = static_cast<std::uint32_t>(intersects) & static_cast<std::uint32_t>(u >= 0.0f) &
+                         static_cast<std::uint32_t>(v >= 0.0f) & static_cast<std::uint32_t>(u + v <= 1.0f) &
+                         static_cast<std::uint32_t>(distance >= 0.0f);
+            }
+
+            for (size_t i = 0; i < N; ++i) {
+                result.mask_ |= hit[i] << i;
+            }
+            return result;
+        }
+    }
+
+    triangle::triangle(const vector3& _vertex_a, const vector3& _vertex_b, const vector3& _vertex_c)
+            : vertex_a_(_vertex_a), vertex_b_(_vertex_b), vertex_c_(_vertex_c) {}
+
+    plane triangle::to_plane() const {
+        return plane{vertex_a_, vertex_b_, vertex_c_};
+    }
+
+    vector3 triangle::point_at(float _u, float _v) const {
+        return vertex_a_ + (vertex_b_ - vertex_a_) * _u + (vertex_c_ - vertex_a_) * _v;
+    }
+
+    std::optional<triangle_hit> triangle::intersect(const line& _line) const {
+        // See intersect_packets for the derivation.
+        const vector3 edge_ab = vertex_b_ - vertex_a_;
+        const vector3 edge_ac = vertex_c_ - vertex_a_;
+        const vector3 r = _line.direction_.cross(edge_ac);
+        const float det = edge_ab.dot(r);
+        const float scale = _line.direction_.length() * edge_ab.length() * edge_ac.length();
+        if (std::fabs(det) <= std::numeric_limits<float>::epsilon() * scale) {
+            return std::nullopt;
+        }
+
+        const float inv_det = 1.0f / det;
+        const vector3 s = _line.point_ - vertex_a_;
+        const float u = s.dot(r) * inv_det;
+        if (u < 0.0f || u > 1.0f) {
+            return std::nullopt;
+        }
+
+        const vector3 q = s.cross(edge_ab);
+        const float v = _line.direction_.dot(q) * inv_det;
+        if (v < 0.0f || u + v > 1.0f) {
+            return std::nullopt;
+        }
+
+        const float distance = edge_ac.dot(q) * inv_det;
+        if (distance < 0.0f) {
+            return std::nullopt;
+        }
+        return triangle_hit{distance, u, v};
+    }
+
+    template<size_t N>
+    triangle_hits<N> triangle::intersect(const line_packet<N>& _lines) const {
+        triangle_packet<N> triangles;
+        for (size_t i = 0; i < N; ++i) {
+            triangles.set(i, *this);
+        }
+        return intersect_packets(_lines, triangles);
+    }
+
+    template<size_t N>
+    triangle_packet<N>::triangle_packet(std::span<const triangle> _triangles) {
+        for (size_t i = 0; i < _triangles.size(); ++i) {
+            set(i, _triangles[i]);
+        }
+    }
+
+    template<size_t N>
+    void triangle_packet<N>::set(size_t _index, const triangle& _triangle) {
+        const vector3 edge_ab = _triangle.vertex_b_ - _triangle.vertex_a_;
+        const vector3 edge_ac = _triangle.vertex_c_ - _triangle.vertex_a_;
+        vertex_x_[_index] = _triangle.vertex_a_.x_;
+        vertex_y_[_index] = _triangle.vertex_a_.y_;
+        vertex_z_[_index] = _triangle.vertex_a_.z_;
+        edge_ab_x_[_index] = edge_ab.x_;
+        edge_ab_y_[_index] = edge_ab.y_;
+        edge_ab_z_[_index] = edge_ab.z_;
+        edge_ac_x_[_index] = edge_ac.x_;
+        edge_ac_y_[_index] = edge_ac.y_;
+        edge_ac_z_[_index] = edge_ac.z_;
+    }
+
+    template<size_t N>
+    triangle_hits<N> triangle_packet<N>::intersect(const line& _line) const {
+        line_packet<N> lines;
+        for (size_t i = 0; i < N; ++i) {
+            lines.set(i, _line);
+        }
+        return intersect_packets(lines, *this);
+    }
+
+    template class triangle_packet<4>;
+    template class triangle_packet<8>;
+    template triangle_hits<4> triangle::intersect<4>(const line_packet<4>& _lines) const;
+    template triangle_hits<8> triangle::intersect<8>(const line_packet<8>& _lines) const;
+}
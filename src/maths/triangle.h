@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include "maths/plane.h"
+
+namespace mkr {
+    /**
+     * The intersection of a line with a triangle.
+     */
+    struct triangle_hit {
+        /// The value of λ in the line formula p + λd at the intersection point.
+        float distance_;
+        /// The barycentric coordinate (weight) of vertex b at the intersection point.
+        float u_;
+        /// The barycentric coordinate (weight) of vertex c at the intersection point.
+        float v_;
+    };
+
+    /**
+     * The intersections of a packet of N lines with a triangle, or a line with a packet of N triangles.
+     * Bit i of mask_ is set if pair i intersects. The distance and barycentric coordinates of pairs which do not
+     * intersect are unspecified.
+     */
+    template<size_t N>
+    struct triangle_hits {
+        std::uint32_t mask_;
+        std::array<float, N> distance_;
+        std::array<float, N> u_;
+        std::array<float, N> v_;
+    };
+
+    template<size_t N>
+    class triangle_packet;
+
+    /**
+     * A triangle with the vertices a, b and c.
+     */
+    class triangle {
+    public:
+        vector3 vertex_a_;
+        vector3 vertex_b_;
+        vector3 vertex_c_;
+
+        /**
+         * Constructs a triangle.
+         * @param _vertex_a The first vertex.
+         * @param _vertex_b The second vertex.
+         * @param _vertex_c The third vertex.
+         */
+        triangle(const vector3& _vertex_a = vector3::zero(), const vector3& _vertex_b = vector3::zero(),
+                 const vector3& _vertex_c = vector3::zero());
+
+        /**
+         * Returns the plane of the triangle. The vertices go around anti-clockwise as you look down on the top surface of
+         * the plane.
+         * @return The plane of the triangle.
+         */
+        [[nodiscard]] plane to_plane() const;
+
+        /**
+         * Returns the point of the triangle at the given barycentric coordinates.
+         * @param _u The weight of vertex b.
+         * @param _v The weight of vertex c.
+         * @return The point a + u(b - a) + v(c - a).
+         */
+        [[nodiscard]] vector3 point_at(float _u, float _v) const;
+
+        /**
+         * Intersects a line with the triangle using the Möller–Trumbore algorithm.
+         * The line is treated as a ray, only intersections where λ >= 0 are returned. Both faces of the triangle can be hit.
+         * @param _line The line.
+         * @return The intersection of the line with the triangle.
+         * @attention Returns std::nullopt if the line does not intersect the triangle, is parallel to it, or the triangle
+         *            is degenerate.
+         */
+        [[nodiscard]] std::optional<triangle_hit> intersect(const line& _line) const;
+
+        /**
+         * Intersects a packet of lines with the triangle.
+         * @param _lines The lines.
+         * @return The intersection of each line with the triangle.
+         * @warning N must be 4 or 8.
+         */
+        template<size_t N>
+        [[nodiscard]] triangle_hits<N> intersect(const line_packet<N>& _lines) const;
+    };
+
+    /**
+     * A packet of N triangles stored as a structure of arrays, so that a line can be tested against all of them together.
+     * The edges of each triangle are precalculated.
+     * @warning N must be 4 or 8.
+     */
+    template<size_t N>
+    class triangle_packet {
+    public:
+        /// The number of triangles in a packet.
+        static constexpr size_t width = N;
+
+        std::array<float, N> vertex_x_{};
+        std::array<float, N> vertex_y_{};
+        std::array<float, N> vertex_z_{};
+        /// The edge from vertex a to vertex b.
+        std::array<float, N> edge_ab_x_{};
+        std::array<float, N> edge_ab_y_{};
+        std::array<float, N> edge_ab_z_{};
+        /// The edge from vertex a to vertex c.
+        std::array<float, N> edge_ac_x_{};
+        std::array<float, N> edge_ac_y_{};
+        std::array<float, N> edge_ac_z_{};
+
+        /**
+         * Constructs a packet of degenerate triangles, which are never intersected.
+         */
+        triangle_packet() = default;
+
+        /**
+         * Constructs a packet of triangles. If there are fewer than N triangles, the remaining triangles are degenerate.
+         * @param _triangles The triangles.
+         * @warning _triangles must not have more than N triangles.
+         */
+        explicit triangle_packet(std::span<const triangle> _triangles);
+
+        /**
+         * Set a triangle of the packet.
+         * @param _index The index of the triangle.
+         * @param _triangle The triangle.
+         */
+        void set(size_t _index, const triangle& _triangle);
+
+        /**
+         * Intersects a line with every triangle in the packet.
+         * @param _line The line.
+         * @return The intersection of the line with each triangle.
+         */
+        [[nodiscard]] triangle_hits<N> intersect(const line& _line) const;
+    };
+
+    extern template class triangle_packet<4>;
+    extern template class triangle_packet<8>;
+    extern template triangle_hits<4> triangle::intersect<4>(const line_packet<4>& _lines) const;
+    extern template triangle_hits<8> triangle::intersect<8>(const line_packet<8>& _lines) const;
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "maths/maths_util.h"
+#include "maths/vector3.h"
+
+namespace mkr {
+    /**
+     * A fixed size block of vectors, stored as a structure of arrays.
+     *
+     * The compiler cannot vectorise a loop which reads vector3s, or types made of them, from an array, since each
+     * component is loaded with a stride of 3 or more floats. Batch kernels instead copy their inputs into blocks, and
+     * run the vectorised loop over each block, where every component is contiguous.
+     */
+    struct vector3_block {
+        /// The number of vectors in a block. A kernel's blocks should fit in the L1 cache together.
+        static constexpr size_t capacity = 64;
+
+        float x_[capacity];
+        float y_[capacity];
+        float z_[capacity];
+
+        void set(size_t _index, float _x, float _y, float _z) {
+            x_[_index] = _x;
+            y_[_index] = _y;
+            z_[_index] = _z;
+        }
+
+        void set(size_t _index, const vector3& _vector) { set(_index, _vector.x_, _vector.y_, _vector.z_); }
+
+        /**
+         * Splits a range of items into blocks, in order.
+         * @param _count The number of items.
+         * @param _function Called as _function(block_start, block_size) for each block, where block_size is at most capacity.
+         */
+        template<typename Function>
+        static void for_each_block(size_t _count, Function _function) {
+            for (size_t block_start = 0; block_start < _count; block_start += capacity) {
+                _function(block_start, maths_util::min(capacity, _count - block_start));
+            }
+        }
+    };
+}
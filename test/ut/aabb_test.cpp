@@ -0,0 +1,109 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/aabb.h"
+#include "maths/matrix_util.h"
+
+using namespace mkr;
+
+TEST(aabb_test, bounds) {
+    EXPECT_TRUE(aabb::empty().is_empty());
+
+    const std::vector<vector3> points{vector3{1.0f, -2.0f, 3.0f}, vector3{-1.0f, 4.0f, 0.0f}, vector3{0.0f, 0.0f, 5.0f}};
+    const aabb box = aabb::from_points(points);
+    EXPECT_FALSE(box.is_empty());
+    EXPECT_EQ(box.min_, (vector3{-1.0f, -2.0f, 0.0f}));
+    EXPECT_EQ(box.max_, (vector3{1.0f, 4.0f, 5.0f}));
+    EXPECT_EQ(box.centre(), (vector3{0.0f, 1.0f, 2.5f}));
+    EXPECT_EQ(box.extents(), (vector3{1.0f, 3.0f, 2.5f}));
+    EXPECT_FLOAT_EQ(box.surface_area(), 2.0f * (2.0f * 6.0f + 6.0f * 5.0f + 5.0f * 2.0f));
+    for (const auto& point: points) {
+        EXPECT_TRUE(box.contains(point));
+    }
+    EXPECT_FALSE(box.contains(vector3{0.0f, 0.0f, 6.0f}));
+
+    EXPECT_TRUE(box.overlaps(aabb{vector3{1.0f, 4.0f, 5.0f}, vector3{2.0f, 5.0f, 6.0f}}));
+    EXPECT_FALSE(box.overlaps(aabb{vector3{1.1f, 0.0f, 0.0f}, vector3{2.0f, 1.0f, 1.0f}}));
+    EXPECT_EQ(box.merged(aabb{vector3{2.0f, 2.0f, 2.0f}, vector3{3.0f, 3.0f, 3.0f}}).max_, (vector3{3.0f, 4.0f, 5.0f}));
+}
+
+TEST(aabb_test, intersect) {
+    const aabb box{vector3{-1.0f, -1.0f, -1.0f}, vector3{1.0f, 1.0f, 1.0f}};
+
+    const auto range = box.intersect(line{vector3{-3.0f, 0.5f, 0.0f}, vector3{2.0f, 0.0f, 0.0f}});
+    ASSERT_TRUE(range.has_value());
+    EXPECT_FLOAT_EQ(range->first, 1.0f);
+    EXPECT_FLOAT_EQ(range->second, 2.0f);
+
+    EXPECT_FALSE(box.intersect(line{vector3{-3.0f, 1.5f, 0.0f}, vector3{1.0f, 0.0f, 0.0f}}).has_value());
+    EXPECT_FALSE(box.intersect(line{vector3{-3.0f, 0.0f, 0.0f}, vector3{1.0f, 2.0f, 0.0f}}).has_value());
+    EXPECT_TRUE(box.intersect(line{vector3{-3.0f, 1.0f, 0.0f}, vector3{1.0f, 0.0f, 0.0f}}).has_value());
+}
+
+TEST(aabb_test, packet) {
+    std::vector<aabb> boxes;
+    for (size_t i = 0; i < 75; ++i) {
+        const auto f = static_cast<float>(i);
+        const vector3 centre{std::sin(f) * 5.0f, std::cos(f * 1.7f) * 5.0f, std::sin(f * 0.3f) * 5.0f};
+        boxes.emplace_back(centre - vector3{1.0f, 1.0f, 1.0f}, centre + vector3{1.0f, 0.5f, 2.0f});
+    }
+    const aabb query{vector3{-2.0f, -3.0f, -1.0f}, vector3{3.0f, 1.0f, 2.0f}};
+
+    const aabb_packet<4> packet4{std::span<const aabb>{boxes}.first(3)};
+    const aabb_packet<8> packet8{std::span<const aabb>{boxes}.first(8)};
+    const std::uint32_t overlap4 = packet4.overlaps(query);
+    const std::uint32_t overlap8 = packet8.overlaps(query);
+    const std::uint32_t contains8 = packet8.contains(vector3::zero());
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(((overlap8 >> i) & 1u) != 0, boxes[i].overlaps(query));
+        EXPECT_EQ(((contains8 >> i) & 1u) != 0, boxes[i].contains(vector3::zero()));
+        if (i < 3) { EXPECT_EQ(((overlap4 >> i) & 1u) != 0, boxes[i].overlaps(query)); }
+    }
+    EXPECT_EQ(overlap4 >> 3, 0u); // The padding boxes are empty.
+
+    std::vector<std::uint64_t> mask(2, ~0ull);
+    query.overlaps(boxes, mask);
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        EXPECT_EQ(((mask[i / 64] >> (i % 64)) & 1u) != 0, boxes[i].overlaps(query));
+    }
+    EXPECT_EQ(mask[1] >> (75 - 64), 0u);
+}
+
+TEST(aabb_test, transform) {
+    const std::vector<aabb> boxes{
+            aabb{vector3{-1.0f, -2.0f, -3.0f}, vector3{1.0f, 2.0f, 3.0f}},
+            aabb{vector3{2.0f, 0.5f, -1.0f}, vector3{4.0f, 1.5f, 7.0f}},
+            aabb{vector3{0.0f, 0.0f, 0.0f}, vector3{0.0f, 0.0f, 0.0f}},
+    };
+    const matrix4x4 matrix = matrix_util::model_matrix(vector3{5.0f, -3.0f, 2.0f}, vector3{0.3f, -1.2f, 2.0f}, vector3{2.0f, 0.5f, -1.5f});
+
+    std::vector<aabb> result(boxes.size());
+    aabb::transform(boxes, matrix, result);
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        // The bounds of the 8 transformed corners.
+        aabb expected = aabb::empty();
+        for (size_t corner = 0; corner < 8; ++corner) {
+            const vector3 point{(corner & 1) ? boxes[i].max_.x_ : boxes[i].min_.x_,
+                                (corner & 2) ? boxes[i].max_.y_ : boxes[i].min_.y_,
+                                (corner & 4) ? boxes[i].max_.z_ : boxes[i].min_.z_};
+            expected.expand(matrix * point);
+        }
+        EXPECT_NEAR(result[i].min_.x_, expected.min_.x_, 1e-4f);
+        EXPECT_NEAR(result[i].min_.y_, expected.min_.y_, 1e-4f);
+        EXPECT_NEAR(result[i].min_.z_, expected.min_.z_, 1e-4f);
+        EXPECT_NEAR(result[i].max_.x_, expected.max_.x_, 1e-4f);
+        EXPECT_NEAR(result[i].max_.y_, expected.max_.y_, 1e-4f);
+        EXPECT_NEAR(result[i].max_.z_, expected.max_.z_, 1e-4f);
+    }
+
+    const aabb single = boxes[1].transformed(matrix);
+    EXPECT_EQ(single.min_, result[1].min_);
+    EXPECT_EQ(single.max_, result[1].max_);
+}
+
+TEST(aabb_test, is_behind) {
+    const aabb box{vector3{-1.0f, -1.0f, -1.0f}, vector3{1.0f, 1.0f, 1.0f}};
+    EXPECT_TRUE(box.is_behind(plane{vector3{0.0f, 1.0f, 0.0f}, -1.5f}));
+    EXPECT_FALSE(box.is_behind(plane{vector3{0.0f, 1.0f, 0.0f}, -0.5f}));
+    EXPECT_TRUE(box.is_behind(plane{vector3{1.0f, -1.0f, 0.0f}, -2.5f}));
+    EXPECT_FALSE(box.is_behind(plane{vector3{1.0f, -1.0f, 0.0f}, -1.5f}));
+}
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/bvh.h"
+
+using namespace mkr;
+
+namespace {
+    // A bumpy grid of triangles, large enough for the upper levels to be built in parallel.
+    std::vector<triangle> make_mesh(size_t _resolution) {
+        const auto height = [](size_t _x, size_t _z) {
+            return std::sin(static_cast<float>(_x) * 0.3f) * std::cos(static_cast<float>(_z) * 0.2f);
+        };
+        std::vector<triangle> triangles;
+        for (size_t z = 0; z < _resolution; ++z) {
+            for (size_t x = 0; x < _resolution; ++x) {
+                const vector3 a{static_cast<float>(x), height(x, z), static_cast<float>(z)};
+                const vector3 b{static_cast<float>(x + 1), height(x + 1, z), static_cast<float>(z)};
+                const vector3 c{static_cast<float>(x), height(x, z + 1), static_cast<float>(z + 1)};
+                const vector3 d{static_cast<float>(x + 1), height(x + 1, z + 1), static_cast<float>(z + 1)};
+                triangles.emplace_back(a, b, c);
+                triangles.emplace_back(b, d, c);
+            }
+        }
+        return triangles;
+    }
+}
+
+TEST(bvh_test, build) {
+    const std::vector<triangle> triangles = make_mesh(100);
+    const bvh tree{triangles};
+
+    // Every primitive is in exactly one leaf, and every node contains its children.
+    std::vector<std::uint32_t> indices(tree.primitive_indices().begin(), tree.primitive_indices().end());
+    std::sort(indices.begin(), indices.end());
+    ASSERT_EQ(indices.size(), triangles.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        EXPECT_EQ(indices[i], i);
+    }
+
+    size_t leaf_primitives = 0;
+    const auto nodes = tree.nodes();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].is_leaf()) {
+            EXPECT_LE(nodes[i].count_, bvh::max_leaf_size);
+            leaf_primitives += nodes[i].count_;
+            continue;
+        }
+        ASSERT_LT(nodes[i].offset_, nodes.size());
+        EXPECT_GT(nodes[i].offset_, i + 1);
+        for (const size_t child: {i + 1, static_cast<size_t>(nodes[i].offset_)}) {
+            EXPECT_TRUE(nodes[i].bounds_.contains(nodes[child].bounds_.min_));
+            EXPECT_TRUE(nodes[i].bounds_.contains(nodes[child].bounds_.max_));
+        }
+    }
+    EXPECT_EQ(leaf_primitives, triangles.size());
+
+    EXPECT_TRUE(bvh{}.nodes().empty());
+    EXPECT_FALSE(bvh{}.intersect(line{}, triangles).has_value());
+}
+
+TEST(bvh_test, intersect) {
+    const std::vector<triangle> triangles = make_mesh(100);
+    const bvh tree{triangles};
+
+    for (size_t i = 0; i < 50; ++i) {
+        const auto f = static_cast<float>(i);
+        const line ray{vector3{f * 1.7f + 3.0f, 5.0f, f * 1.3f + 10.0f}, vector3{std::sin(f) * 0.5f, -1.0f, std::cos(f) * 0.5f}};
+
+        // Brute force.
+        std::optional<triangle_hit> expected;
+        for (const auto& t: triangles) {
+            const std::optional<triangle_hit> hit = t.intersect(ray);
+            if (hit && (!expected || hit->distance_ < expected->distance_)) { expected = hit; }
+        }
+
+        const std::optional<bvh_hit> hit = tree.intersect(ray, triangles);
+        ASSERT_EQ(hit.has_value(), expected.has_value());
+        if (hit) {
+            EXPECT_NEAR(hit->hit_.distance_, expected->distance_, 1e-5f);
+            EXPECT_TRUE(triangles[hit->primitive_].intersect(ray).has_value());
+        }
+
+        // Every triangle the ray hits is one of the candidates.
+        std::vector<std::uint32_t> candidates;
+        tree.query(ray, candidates);
+        if (hit) {
+            EXPECT_NE(std::find(candidates.begin(), candidates.end(), hit->primitive_), candidates.end());
+        }
+    }
+
+    // Pointing away from the mesh.
+    EXPECT_FALSE(tree.intersect(line{vector3{50.0f, 5.0f, 50.0f}, vector3::y_axis()}, triangles).has_value());
+}
+
+TEST(bvh_test, query_box) {
+    std::vector<aabb> boxes;
+    for (size_t i = 0; i < 1000; ++i) {
+        const auto f = static_cast<float>(i);
+        const vector3 centre{std::sin(f) * 20.0f, std::cos(f * 1.3f) * 20.0f, std::sin(f * 0.7f) * 20.0f};
+        boxes.emplace_back(centre - vector3{0.5f, 0.5f, 0.5f}, centre + vector3{0.5f, 1.0f, 1.5f});
+    }
+    const bvh tree{boxes};
+
+    const aabb query{vector3{-10.0f, -12.0f, -10.0f}, vector3{12.0f, 6.0f, 9.0f}};
+    std::vector<std::uint32_t> result;
+    tree.query(query, result);
+    std::sort(result.begin(), result.end());
+
+    std::vector<std::uint32_t> expected;
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        if (boxes[i].overlaps(query)) { expected.push_back(static_cast<std::uint32_t>(i)); }
+    }
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(result, expected);
+}
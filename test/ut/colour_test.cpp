@@ -0,0 +1,53 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/colour.h"
+
+using namespace mkr;
+
+TEST(colour_test, srgb) {
+    const colour srgb{0.5f, 0.04045f, 1.0f, 0.3f};
+    const colour linear = srgb.to_linear();
+    EXPECT_NEAR(linear.r_, 0.214041144f, 1e-6f);
+    EXPECT_NEAR(linear.g_, 0.04045f / 12.92f, 1e-7f);
+    EXPECT_NEAR(linear.b_, 1.0f, 1e-6f);
+    EXPECT_EQ(linear.a_, 0.3f);
+    EXPECT_TRUE(linear.to_srgb() == srgb);
+    EXPECT_NEAR(colour(0.001f, 0.0f, 0.0f).to_srgb().r_, 0.01292f, 1e-7f);
+}
+
+TEST(colour_test, srgb_batch) {
+    // 1001 values from 0 to 1, with the thresholds of both curves among them, and a count which is not a multiple of the vector width.
+    std::vector<colour> colours;
+    for (size_t i = 0; i <= 1000; ++i) {
+        const float f = static_cast<float>(i) / 1000.0f;
+        colours.emplace_back(f, f * f, 1.0f - f, f);
+    }
+    colours.emplace_back(0.04045f, 0.0031308f, 0.04046f, 0.5f);
+
+    std::vector<colour> linear(colours.size()), srgb(colours.size());
+    colour::srgb_to_linear(colours, linear);
+    colour::linear_to_srgb(colours, srgb);
+    const auto expect_near = [](float _value, float _expected, float _tolerance) {
+        EXPECT_NEAR(_value, _expected, _tolerance * _expected + 1e-9f);
+    };
+    for (size_t i = 0; i < colours.size(); ++i) {
+        const colour exact_linear = colours[i].to_linear();
+        const colour exact_srgb = colours[i].to_srgb();
+        expect_near(linear[i].r_, exact_linear.r_, 4e-6f);
+        expect_near(linear[i].g_, exact_linear.g_, 4e-6f);
+        expect_near(linear[i].b_, exact_linear.b_, 4e-6f);
+        expect_near(srgb[i].r_, exact_srgb.r_, 2e-6f);
+        expect_near(srgb[i].g_, exact_srgb.g_, 2e-6f);
+        expect_near(srgb[i].b_, exact_srgb.b_, 2e-6f);
+        EXPECT_EQ(linear[i].a_, colours[i].a_);
+        EXPECT_EQ(srgb[i].a_, colours[i].a_);
+    }
+
+    // Converting in place, and back again.
+    colour::linear_to_srgb(linear, linear);
+    for (size_t i = 0; i < colours.size(); ++i) {
+        EXPECT_NEAR(linear[i].r_, colours[i].r_, 1e-5f);
+        EXPECT_NEAR(linear[i].g_, colours[i].g_, 1e-5f);
+        EXPECT_NEAR(linear[i].b_, colours[i].b_, 1e-5f);
+    }
+}
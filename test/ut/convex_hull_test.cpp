@@ -0,0 +1,92 @@
+#include <map>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/convex_hull.h"
+#include "test_points.h"
+
+using namespace mkr;
+
+namespace {
+    /// Checks that every edge of the hull is shared by exactly 2 faces in opposite directions, and every point is inside.
+    void check_hull(const convex_hull& _hull, const std::vector<vector3>& _points) {
+        ASSERT_EQ(_hull.faces_.size(), _hull.planes_.size());
+        std::map<std::pair<std::uint32_t, std::uint32_t>, int> edges;
+        for (const auto& face: _hull.faces_) {
+            for (size_t i = 0; i < 3; ++i) {
+                ++edges[{face[i], face[(i + 1) % 3]}];
+            }
+        }
+        for (const auto& [edge, count]: edges) {
+            EXPECT_EQ(count, 1);
+            EXPECT_EQ(edges.count({edge.second, edge.first}), 1u);
+        }
+        // Euler's formula for a closed mesh of triangles.
+        EXPECT_EQ(_hull.vertices_.size() + _hull.faces_.size(), edges.size() / 2 + 2);
+
+        for (size_t i = 0; i < _hull.faces_.size(); ++i) {
+            for (const auto& point: _points) {
+                EXPECT_LE(_hull.planes_[i].signed_distance(point), 1e-4f);
+            }
+            for (const std::uint32_t vertex: _hull.faces_[i]) {
+                EXPECT_NEAR(_hull.planes_[i].signed_distance(_hull.vertices_[vertex]), 0.0f, 1e-4f);
+            }
+        }
+    }
+}
+
+TEST(convex_hull_test, from_points) {
+    // The corners of a cube, with points inside it and on its faces.
+    std::vector<vector3> cube;
+    for (size_t i = 0; i < 8; ++i) {
+        cube.emplace_back((i & 1) ? 1.0f : -1.0f, (i & 2) ? 2.0f : -2.0f, (i & 4) ? 3.0f : -3.0f);
+    }
+    for (size_t i = 0; i < 100; ++i) {
+        const vector3 p = test_util::scattered_point(i);
+        cube.emplace_back(p.x_, p.y_ * 2.0f, (i % 3 == 0) ? 3.0f : p.z_ * 3.0f);
+    }
+    const auto cube_hull = convex_hull::from_points(cube);
+    ASSERT_TRUE(cube_hull.has_value());
+    EXPECT_EQ(cube_hull->vertices_.size(), 8u);
+    EXPECT_EQ(cube_hull->faces_.size(), 12u);
+    check_hull(*cube_hull, cube);
+
+    // Points on and inside a sphere.
+    std::vector<vector3> ball;
+    for (size_t i = 0; i < 2000; ++i) {
+        const vector3 direction = test_util::scattered_point(i).normalised();
+        ball.push_back(direction * ((i % 4 == 0) ? 5.0f : 4.0f) + vector3{10.0f, -3.0f, 1.0f});
+    }
+    const auto ball_hull = convex_hull::from_points(ball);
+    ASSERT_TRUE(ball_hull.has_value());
+    // Only the points on the outer sphere can be vertices, and some of them are too close together to be distinct.
+    EXPECT_LE(ball_hull->vertices_.size(), 500u);
+    EXPECT_GE(ball_hull->vertices_.size(), 490u);
+    check_hull(*ball_hull, ball);
+}
+
+TEST(convex_hull_test, nearly_coplanar) {
+    // Many of these points are within float precision of the planes through the points near the faces of the cube, which
+    // makes the hull concave unless the side of each face a point is on is found accurately.
+    const std::vector<vector3> points = test_util::make_points(20000);
+    const auto hull = convex_hull::from_points(points);
+    ASSERT_TRUE(hull.has_value());
+
+    float max_distance = 0.0f;
+    for (const auto& p: hull->planes_) {
+        for (const auto& point: points) {
+            max_distance = maths_util::max(max_distance, p.signed_distance(point));
+        }
+    }
+    EXPECT_LE(max_distance, 1e-5f);
+}
+
+TEST(convex_hull_test, degenerate) {
+    EXPECT_FALSE(convex_hull::from_points({}).has_value());
+    const std::vector<vector3> triangle{vector3{0.0f, 0.0f, 0.0f}, vector3{1.0f, 0.0f, 0.0f}, vector3{0.0f, 1.0f, 0.0f}};
+    EXPECT_FALSE(convex_hull::from_points(triangle).has_value());
+    const std::vector<vector3> square{vector3{0.0f, 0.0f, 0.0f}, vector3{1.0f, 0.0f, 0.0f}, vector3{0.0f, 1.0f, 0.0f}, vector3{1.0f, 1.0f, 0.0f}};
+    EXPECT_FALSE(convex_hull::from_points(square).has_value());
+    const std::vector<vector3> line{vector3{0.0f, 0.0f, 0.0f}, vector3{1.0f, 1.0f, 1.0f}, vector3{2.0f, 2.0f, 2.0f}, vector3{3.0f, 3.0f, 3.0f}};
+    EXPECT_FALSE(convex_hull::from_points(line).has_value());
+}
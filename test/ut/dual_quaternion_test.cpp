@@ -0,0 +1,88 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/dual_quaternion.h"
+#include "maths/matrix_util.h"
+
+using namespace mkr;
+
+namespace {
+    void expect_near(const vector3& _a, const vector3& _b, float _tolerance = 0.0001f) {
+        EXPECT_NEAR(_a.x_, _b.x_, _tolerance);
+        EXPECT_NEAR(_a.y_, _b.y_, _tolerance);
+        EXPECT_NEAR(_a.z_, _b.z_, _tolerance);
+    }
+
+    void expect_near(const matrix4x4& _a, const matrix4x4& _b, float _tolerance = 0.0001f) {
+        for (size_t i = 0; i < matrix4x4::size(); ++i) {
+            EXPECT_NEAR(_a[0][i], _b[0][i], _tolerance);
+        }
+    }
+}
+
+TEST(dual_quaternion_test, transform) {
+    const quaternion rotation_a{vector3{1.0f, 2.0f, -1.0f}.normalised(), 40.0f * maths_util::deg2rad};
+    const quaternion rotation_b{vector3{0.0f, 1.0f, 3.0f}.normalised(), -110.0f * maths_util::deg2rad};
+    const vector3 translation_a{1.0f, -2.0f, 5.0f};
+    const vector3 translation_b{-4.0f, 0.5f, 2.0f};
+    const dual_quaternion a{rotation_a, translation_a};
+    const dual_quaternion b{rotation_b, translation_b};
+    const vector3 point{3.0f, 1.0f, -2.0f};
+
+    {
+        const matrix4x4 m = matrix_util::translation_matrix(translation_a) * rotation_a.to_rotation_matrix();
+        expect_near(a.to_matrix(), m);
+        expect_near(a.translation(), translation_a);
+        expect_near(a.transform_point(point), m * point);
+        expect_near(dual_quaternion::from_matrix(m).to_matrix(), m);
+    }
+
+    {
+        const dual_quaternion ab = a * b;
+        const matrix4x4 m = a.to_matrix() * b.to_matrix();
+        expect_near(ab.transform_point(point), m * point);
+        expect_near(ab.transform_point(point), a.transform_point(b.transform_point(point)));
+    }
+
+    {
+        expect_near(a.inversed().transform_point(a.transform_point(point)), point);
+        expect_near(a.conjugated().transform_point(a.transform_point(point)), point);
+        const dual_quaternion identity = a * a.inversed();
+        EXPECT_NEAR(identity.real_.w_, 1.0f, 0.0001f);
+        EXPECT_NEAR(identity.dual_.length(), 0.0f, 0.0001f);
+    }
+
+    {
+        const dual_quaternion n = (a * 3.0f).normalised();
+        EXPECT_NEAR(n.real_.length(), 1.0f, 0.0001f);
+        EXPECT_NEAR(n.real_.dot(n.dual_), 0.0f, 0.0001f);
+        expect_near(n.transform_point(point), a.transform_point(point));
+    }
+}
+
+TEST(dual_quaternion_test, blend) {
+    const std::vector<dual_quaternion> bones{
+            dual_quaternion{quaternion{vector3::y_axis(), 30.0f * maths_util::deg2rad}, vector3{1.0f, 0.0f, 0.0f}},
+            dual_quaternion{quaternion{vector3::y_axis(), 90.0f * maths_util::deg2rad} * -1.0f, vector3{1.0f, 0.0f, 0.0f}},
+            dual_quaternion{quaternion{vector3::x_axis(), 45.0f * maths_util::deg2rad}, vector3{0.0f, 2.0f, 0.0f}},
+    };
+    const std::vector<std::array<std::uint32_t, 4>> indices{{0, 0, 0, 0}, {1, 2, 0, 0}, {0, 1, 0, 0}};
+    const std::vector<std::array<float, 4>> weights{{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f}, {0.5f, 0.5f, 0.0f, 0.0f}};
+    const std::vector<vector3> positions{{1.0f, 2.0f, 3.0f}, {-1.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}};
+
+    std::vector<dual_quaternion> blended(positions.size());
+    std::vector<vector3> skinned(positions.size());
+    dual_quaternion::blend(bones, indices, weights, blended);
+    dual_quaternion::skin(bones, indices, weights, positions, skinned);
+
+    // A single influence gives back the bone's transform.
+    expect_near(skinned[0], bones[0].transform_point(positions[0]));
+    expect_near(skinned[1], bones[2].transform_point(positions[1]));
+
+    // Blending 2 bones with the same translation and rotation axis, but the second bone in the opposite hemisphere,
+    // must take the shortest path (60 degrees) rather than the long way around.
+    const dual_quaternion expected{quaternion{vector3::y_axis(), 60.0f * maths_util::deg2rad}, vector3{1.0f, 0.0f, 0.0f}};
+    expect_near(skinned[2], expected.transform_point(positions[2]));
+    for (size_t i = 0; i < positions.size(); ++i) {
+        expect_near(blended[i].transform_point(positions[i]), skinned[i]);
+    }
+}
@@ -0,0 +1,123 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/aabb.h"
+#include "maths/capsule.h"
+#include "maths/convex_hull.h"
+#include "maths/gjk.h"
+#include "maths/sphere.h"
+
+using namespace mkr;
+
+TEST(gjk_test, distance) {
+    const sphere a{vector3{1.0f, 2.0f, 3.0f}, 1.0f};
+    const sphere b{vector3{5.0f, 2.0f, 3.0f}, 0.5f};
+    const gjk_result spheres = gjk::distance(a, b);
+    EXPECT_FALSE(spheres.intersects_);
+    EXPECT_NEAR(spheres.distance_, 2.5f, 1e-3f);
+    EXPECT_NEAR(spheres.point_a_.x_, 2.0f, 1e-3f);
+    EXPECT_NEAR(spheres.point_b_.x_, 4.5f, 1e-3f);
+
+    // The closest points are the end of the capsule and the corner of the box.
+    const capsule c{segment{vector3{0.0f, 0.0f, 0.0f}, vector3{0.0f, 4.0f, 0.0f}}, 0.5f};
+    const aabb box{vector3{2.0f, 6.0f, -1.0f}, vector3{3.0f, 7.0f, 1.0f}};
+    const gjk_result capsule_box = gjk::distance(c, box);
+    EXPECT_FALSE(capsule_box.intersects_);
+    EXPECT_NEAR(capsule_box.distance_, std::sqrt(8.0f) - 0.5f, 1e-3f);
+    EXPECT_NEAR(capsule_box.point_b_.x_, 2.0f, 1e-3f);
+    EXPECT_NEAR(capsule_box.point_b_.y_, 6.0f, 1e-3f);
+    EXPECT_NEAR(capsule_box.point_b_.z_, 0.0f, 1e-3f);
+
+    // A hull and a set of points, with the closest points on 2 faces.
+    std::vector<vector3> corners;
+    for (size_t i = 0; i < 8; ++i) {
+        corners.emplace_back((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f);
+    }
+    const auto cube = convex_hull::from_points(corners);
+    ASSERT_TRUE(cube.has_value());
+    const std::vector<vector3> triangle{vector3{3.0f, -0.5f, -0.5f}, vector3{3.0f, 0.5f, -0.5f}, vector3{3.0f, 0.0f, 0.5f}};
+    const gjk_result hull_points = gjk::distance(*cube, convex_points{triangle});
+    EXPECT_FALSE(hull_points.intersects_);
+    EXPECT_NEAR(hull_points.distance_, 2.0f, 1e-4f);
+
+    EXPECT_TRUE(gjk::distance(*cube, sphere{vector3{1.5f, 1.5f, 0.0f}, 0.75f}).intersects_);
+    EXPECT_FALSE(gjk::distance(*cube, sphere{vector3{1.5f, 1.5f, 0.0f}, 0.7f}).intersects_);
+    EXPECT_TRUE(gjk::distance(*cube, aabb{vector3{0.5f, 0.5f, 0.5f}, vector3{3.0f, 3.0f, 3.0f}}).intersects_);
+}
+
+TEST(gjk_test, warm_start) {
+    const aabb box{vector3{-1.0f, -1.0f, -1.0f}, vector3{1.0f, 1.0f, 1.0f}};
+    gjk_simplex simplex;
+    const gjk_result cold = gjk::distance(box, capsule{segment{vector3{3.0f, -2.0f, 0.5f}, vector3{4.0f, 2.0f, 0.2f}}, 0.5f}, simplex);
+    EXPECT_FALSE(cold.intersects_);
+
+    // Move the capsule a little each frame. The warm started queries agree with cold queries, and take fewer iterations.
+    for (size_t frame = 1; frame < 20; ++frame) {
+        const float offset = static_cast<float>(frame) * 0.02f;
+        const capsule moved{segment{vector3{3.0f - offset, -2.0f, 0.5f + offset}, vector3{4.0f - offset, 2.0f, 0.2f}}, 0.5f};
+        const gjk_result warm = gjk::distance(box, moved, simplex);
+        const gjk_result reference = gjk::distance(box, moved);
+        EXPECT_FALSE(warm.intersects_);
+        EXPECT_NEAR(warm.distance_, reference.distance_, 1e-4f);
+        EXPECT_LE(warm.iterations_, 2u);
+    }
+
+    // Overlapping shapes stay overlapping. When the cores overlap and have not moved, the rebuilt tetrahedron already contains the origin.
+    ASSERT_TRUE(gjk::distance(box, sphere{vector3{1.2f, 0.0f, 0.0f}, 0.5f}, simplex).intersects_);
+    EXPECT_LE(gjk::distance(box, sphere{vector3{1.19f, 0.0f, 0.0f}, 0.5f}, simplex).iterations_, 2u);
+    const aabb other{vector3{0.5f, 0.5f, 0.5f}, vector3{2.0f, 2.0f, 2.0f}};
+    ASSERT_TRUE(gjk::distance(box, other, simplex).intersects_);
+    EXPECT_EQ(gjk::distance(box, other, simplex).iterations_, 0u);
+    const gjk_result overlap = gjk::distance(box, aabb{vector3{0.6f, 0.5f, 0.4f}, vector3{2.1f, 2.0f, 1.9f}}, simplex);
+    EXPECT_TRUE(overlap.intersects_);
+    EXPECT_LE(overlap.iterations_, 2u);
+}
+
+TEST(gjk_test, penetration) {
+    const sphere a{vector3{0.0f, 0.0f, 0.0f}, 1.0f};
+    const sphere b{vector3{1.5f, 0.0f, 0.0f}, 1.0f};
+    gjk_simplex simplex;
+    ASSERT_TRUE(gjk::distance(a, b, simplex).intersects_);
+    const auto spheres = gjk::penetration(a, b, simplex);
+    ASSERT_TRUE(spheres.has_value());
+    EXPECT_NEAR(spheres->depth_, 0.5f, 1e-2f);
+    EXPECT_NEAR(spheres->normal_.x_, 1.0f, 1e-2f);
+    EXPECT_NEAR(spheres->point_a_.x_, 1.0f, 1e-2f);
+    EXPECT_NEAR(spheres->point_b_.x_, 0.5f, 1e-2f);
+
+    // Boxes separate along the axis of least overlap.
+    const aabb box_a{vector3{-1.0f, -1.0f, -1.0f}, vector3{1.0f, 1.0f, 1.0f}};
+    const aabb box_b{vector3{0.5f, -3.0f, 0.8f}, vector3{2.0f, 0.9f, 3.0f}};
+    ASSERT_TRUE(gjk::distance(box_a, box_b, simplex).intersects_);
+    const auto boxes = gjk::penetration(box_a, box_b, simplex);
+    ASSERT_TRUE(boxes.has_value());
+    EXPECT_NEAR(boxes->depth_, 0.2f, 1e-4f);
+    EXPECT_NEAR(boxes->normal_.z_, 1.0f, 1e-4f);
+
+    // Shapes which only touch, so that the simplex is not a tetrahedron.
+    const aabb touching{vector3{1.0f, -0.5f, -0.5f}, vector3{2.0f, 0.5f, 0.5f}};
+    ASSERT_TRUE(gjk::distance(box_a, touching, simplex).intersects_);
+    const auto touch = gjk::penetration(box_a, touching, simplex);
+    ASSERT_TRUE(touch.has_value());
+    EXPECT_NEAR(touch->depth_, 0.0f, 1e-4f);
+
+    // Spheres with the same centre, and capsules whose segments cross, have cores which touch without overlapping.
+    const auto same_centre = gjk::penetration(a, sphere{vector3::zero(), 0.5f});
+    ASSERT_TRUE(same_centre.has_value());
+    EXPECT_NEAR(same_centre->depth_, 1.5f, 1e-4f);
+    const capsule c{segment{vector3{-2.0f, 0.0f, 0.0f}, vector3{2.0f, 0.0f, 0.0f}}, 0.25f};
+    const capsule d{segment{vector3{0.0f, 0.0f, -2.0f}, vector3{0.0f, 0.0f, 2.0f}}, 0.5f};
+    const auto crossing = gjk::penetration(c, d);
+    ASSERT_TRUE(crossing.has_value());
+    EXPECT_NEAR(crossing->depth_, 0.75f, 1e-4f);
+    EXPECT_NEAR(std::fabs(crossing->normal_.y_), 1.0f, 1e-4f);
+    EXPECT_NEAR(crossing->point_a_.y_, crossing->normal_.y_ * 0.25f, 1e-4f);
+
+    // A capsule whose segment passes through a box.
+    const auto capsule_box = gjk::penetration(box_a, capsule{segment{vector3{-3.0f, 0.8f, 0.0f}, vector3{3.0f, 0.8f, 0.0f}}, 0.5f});
+    ASSERT_TRUE(capsule_box.has_value());
+    EXPECT_NEAR(capsule_box->depth_, 0.7f, 1e-4f);
+    EXPECT_NEAR(capsule_box->normal_.y_, 1.0f, 1e-4f);
+
+    EXPECT_FALSE(gjk::penetration(a, sphere{vector3{2.1f, 0.0f, 0.0f}, 1.0f}).has_value());
+    EXPECT_FALSE(gjk::penetration(box_a, aabb{vector3{1.5f, -3.0f, 0.8f}, vector3{2.0f, 0.9f, 3.0f}}).has_value());
+}
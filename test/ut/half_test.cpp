@@ -0,0 +1,83 @@
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/half.h"
+
+using namespace mkr;
+
+TEST(half_test, conversion) {
+    EXPECT_EQ(half{0.0f}.bits_, 0x0000);
+    EXPECT_EQ(half{-0.0f}.bits_, 0x8000);
+    EXPECT_EQ(half{1.0f}.bits_, 0x3C00);
+    EXPECT_EQ(half{-2.0f}.bits_, 0xC000);
+    EXPECT_EQ(half{65504.0f}.bits_, 0x7BFF);
+    EXPECT_EQ(half{65520.0f}.bits_, 0x7C00); // Rounds up to infinity.
+    EXPECT_EQ(half{std::numeric_limits<float>::infinity()}.bits_, 0x7C00);
+    EXPECT_EQ(half{std::ldexp(1.0f, -24)}.bits_, 0x0001); // Smallest subnormal.
+    EXPECT_EQ(half{std::ldexp(1.0f, -26)}.bits_, 0x0000); // Rounds down to zero.
+    EXPECT_EQ(half{1.0f + std::ldexp(1.0f, -11)}.bits_, 0x3C00); // Tie rounds to even.
+    EXPECT_EQ(half{1.0f + 3.0f * std::ldexp(1.0f, -11)}.bits_, 0x3C02); // Tie rounds to even.
+    EXPECT_TRUE(std::isnan(half{std::numeric_limits<float>::quiet_NaN()}.to_float()));
+
+    // Every finite half must survive a round trip through float.
+    for (std::uint32_t bits = 0; bits < 0x10000; ++bits) {
+        const half h = half::from_bits(static_cast<std::uint16_t>(bits));
+        if ((bits & 0x7C00) == 0x7C00 && (bits & 0x03FF) != 0) { continue; } // NaN
+        EXPECT_EQ(half{h.to_float()}.bits_, h.bits_);
+    }
+}
+
+TEST(half_test, batch) {
+    {
+        std::vector<float> floats(37);
+        for (size_t i = 0; i < floats.size(); ++i) { floats[i] = static_cast<float>(i) * 0.37f - 5.0f; }
+        std::vector<half> halves(floats.size());
+        std::vector<float> result(floats.size());
+        half_util::to_half(floats, halves);
+        half_util::to_float(halves, result);
+        for (size_t i = 0; i < floats.size(); ++i) {
+            EXPECT_EQ(halves[i], half{floats[i]});
+            EXPECT_EQ(result[i], halves[i].to_float());
+        }
+    }
+
+    {
+        std::vector<vector3> vectors{{1.0f, 2.0f, 3.0f}, {-0.5f, 0.25f, 1024.0f}, {0.0f, -1.0f, 8.0f}};
+        std::vector<vector3_half> halves(vectors.size());
+        std::vector<vector3> result(vectors.size());
+        half_util::to_half(vectors, halves);
+        half_util::to_float(halves, result);
+        for (size_t i = 0; i < vectors.size(); ++i) {
+            EXPECT_TRUE(vectors[i] == result[i]);
+            EXPECT_TRUE(vectors[i] == halves[i].to_vector3());
+        }
+    }
+
+    {
+        std::vector<colour> colours{colour::red(), colour::cyan(), colour{0.5f, 0.25f, 0.125f, 0.0f}};
+        std::vector<colour_half> halves(colours.size());
+        std::vector<colour> result(colours.size());
+        half_util::to_half(colours, halves);
+        half_util::to_float(halves, result);
+        for (size_t i = 0; i < colours.size(); ++i) {
+            EXPECT_TRUE(colours[i] == result[i]);
+            EXPECT_TRUE(colours[i] == halves[i].to_colour());
+        }
+    }
+
+    {
+        std::vector<matrix4x4> matrices{matrix4x4::identity(), matrix4x4{{1.0f, 2.0f, 3.0f, 4.0f,
+                                                                          5.0f, 6.0f, 7.0f, 8.0f,
+                                                                          9.0f, 10.0f, 11.0f, 12.0f,
+                                                                          13.0f, 14.0f, 15.0f, 16.0f}}};
+        std::vector<matrix4x4_half> halves(matrices.size());
+        std::vector<matrix4x4> result(matrices.size());
+        half_util::to_half(matrices, halves);
+        half_util::to_float(halves, result);
+        for (size_t i = 0; i < matrices.size(); ++i) {
+            EXPECT_TRUE(matrices[i] == result[i]);
+            EXPECT_TRUE(matrices[i] == halves[i].to_matrix4x4());
+            EXPECT_TRUE(matrices[i] == matrix4x4_half{matrices[i]}.to_matrix4x4());
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/kd_tree.h"
+#include "test_points.h"
+
+using namespace mkr;
+
+namespace {
+    std::vector<kd_tree_neighbour> brute_force(const std::vector<vector3>& _points, const vector3& _position) {
+        std::vector<kd_tree_neighbour> neighbours;
+        for (size_t i = 0; i < _points.size(); ++i) {
+            neighbours.push_back({static_cast<std::uint32_t>(i), (_points[i] - _position).length_squared()});
+        }
+        std::stable_sort(neighbours.begin(), neighbours.end(), [](const auto& _a, const auto& _b) { return _a.distance_squared_ < _b.distance_squared_; });
+        return neighbours;
+    }
+}
+
+TEST(kd_tree_test, nearest) {
+    EXPECT_FALSE(kd_tree{}.nearest(vector3::zero()).has_value());
+
+    for (size_t size: {1u, 5u, 75u, 40000u}) {
+        const std::vector<vector3> points = test_util::make_points(size, vector3{10.0f, 5.0f, 20.0f});
+        const kd_tree tree{points};
+        EXPECT_EQ(tree.size(), size);
+
+        std::vector<vector3> positions;
+        for (size_t i = 0; i < 20; ++i) {
+            const auto f = static_cast<float>(i);
+            positions.emplace_back(std::cos(f * 3.1f) * 12.0f, std::cos(f * 1.7f) * 6.0f, f - 10.0f);
+        }
+        std::vector<kd_tree_neighbour> batch(positions.size());
+        tree.nearest(positions, batch);
+
+        std::vector<kd_tree_neighbour> k_nearest;
+        for (size_t i = 0; i < positions.size(); ++i) {
+            const std::vector<kd_tree_neighbour> expected = brute_force(points, positions[i]);
+            const auto nearest = tree.nearest(positions[i]);
+            ASSERT_TRUE(nearest.has_value());
+            EXPECT_FLOAT_EQ(nearest->distance_squared_, expected[0].distance_squared_);
+            EXPECT_FLOAT_EQ((points[nearest->index_] - positions[i]).length_squared(), expected[0].distance_squared_);
+            EXPECT_FLOAT_EQ(batch[i].distance_squared_, expected[0].distance_squared_);
+
+            tree.nearest(positions[i], 10, k_nearest);
+            ASSERT_EQ(k_nearest.size(), std::min<size_t>(10, size));
+            for (size_t j = 0; j < k_nearest.size(); ++j) {
+                EXPECT_FLOAT_EQ(k_nearest[j].distance_squared_, expected[j].distance_squared_);
+            }
+        }
+    }
+}
+
+TEST(kd_tree_test, query) {
+    const std::vector<vector3> points = test_util::make_points(5000, vector3{10.0f, 5.0f, 20.0f});
+    const kd_tree tree{points};
+    std::vector<std::uint32_t> result;
+    for (float radius: {0.0f, 1.0f, 4.0f}) {
+        for (size_t i = 0; i < 10; ++i) {
+            const vector3& centre = points[i * 37];
+            result.clear();
+            tree.query(centre, radius, result);
+            std::sort(result.begin(), result.end());
+
+            std::vector<std::uint32_t> expected;
+            for (const auto& neighbour: brute_force(points, centre)) {
+                if (neighbour.distance_squared_ <= radius * radius) { expected.push_back(neighbour.index_); }
+            }
+            std::sort(expected.begin(), expected.end());
+            EXPECT_EQ(result, expected);
+        }
+    }
+}
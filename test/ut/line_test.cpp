@@ -0,0 +1,35 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/line.h"
+
+using namespace mkr;
+
+TEST(line_test, closest_point) {
+    const line l{vector3{1.0f, 0.0f, 0.0f}, vector3{2.0f, 0.0f, 0.0f}};
+    EXPECT_EQ(l.closest_point(vector3{5.0f, 1.0f, -2.0f}), (vector3{5.0f, 0.0f, 0.0f}));
+    EXPECT_EQ(l.closest_point(vector3{-3.0f, 0.0f, 4.0f}), (vector3{-3.0f, 0.0f, 0.0f}));
+}
+
+TEST(line_test, closest_points) {
+    const line l{vector3{0.0f, 0.0f, 0.0f}, vector3{1.0f, 0.0f, 0.0f}};
+    const auto points = l.closest_points(line{vector3{3.0f, 1.0f, 5.0f}, vector3{0.0f, 0.0f, 2.0f}});
+    ASSERT_TRUE(points.has_value());
+    EXPECT_EQ(points->first, (vector3{3.0f, 0.0f, 0.0f}));
+    EXPECT_EQ(points->second, (vector3{3.0f, 1.0f, 0.0f}));
+    EXPECT_FALSE(l.closest_points(line{vector3{0.0f, 1.0f, 0.0f}, vector3{-2.0f, 0.0f, 0.0f}}).has_value());
+
+    // The line between the closest points is perpendicular to both lines.
+    const line a{vector3{1.0f, 2.0f, 3.0f}, vector3{0.3f, -1.0f, 0.5f}};
+    std::vector<line> lines;
+    for (size_t i = 0; i < 70; ++i) {
+        const auto f = static_cast<float>(i);
+        lines.emplace_back(vector3{std::sin(f), f * 0.1f, std::cos(f * 3.0f)}, vector3{std::cos(f), 1.0f, std::sin(f * 0.5f)});
+    }
+    std::vector<float> lambda(lines.size()), mu(lines.size());
+    a.closest_points(lines, lambda, mu);
+    for (size_t i = 0; i < lines.size(); ++i) {
+        const vector3 between = (lines[i].point_ + lines[i].direction_ * mu[i]) - (a.point_ + a.direction_ * lambda[i]);
+        EXPECT_NEAR(between.dot(a.direction_), 0.0f, 1e-4f);
+        EXPECT_NEAR(between.dot(lines[i].direction_), 0.0f, 1e-4f);
+    }
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/loose_octree.h"
+#include "test_points.h"
+
+using namespace mkr;
+
+namespace {
+    aabb make_box(size_t _i, float _offset) {
+        const vector3 p = test_util::scattered_point(_i);
+        const vector3 centre{p.x_ * 60.0f + _offset, p.y_ * 60.0f, p.z_ * 60.0f};
+        const float size = 0.1f + std::fabs(std::sin(static_cast<float>(_i) * 3.7f)) * ((_i % 10 == 0) ? 20.0f : 2.0f);
+        return aabb{centre - vector3{size, size, size}, centre + vector3{size, size, size}};
+    }
+
+    template<typename Query, typename Test>
+    void check(const loose_octree& _tree, const std::vector<std::uint32_t>& _handles, Query _query, Test _test) {
+        std::vector<std::uint32_t> result;
+        _query(result);
+        std::sort(result.begin(), result.end());
+
+        std::vector<std::uint32_t> expected;
+        for (const std::uint32_t handle: _handles) {
+            if (_test(_tree.bounds(handle))) { expected.push_back(handle); }
+        }
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(result, expected);
+    }
+}
+
+TEST(loose_octree_test, update) {
+    loose_octree tree{aabb{vector3{-50.0f, -50.0f, -50.0f}, vector3{50.0f, 50.0f, 50.0f}}, 6};
+    std::vector<std::uint32_t> handles;
+    for (size_t i = 0; i < 500; ++i) {
+        handles.push_back(tree.insert(make_box(i, 0.0f)));
+    }
+    EXPECT_EQ(tree.size(), 500u);
+
+    // Move every object, some of them out of their nodes and some of them out of the tree.
+    for (size_t i = 0; i < handles.size(); ++i) {
+        tree.update(handles[i], make_box(i, (i % 2) ? 0.3f : 15.0f));
+    }
+
+    // Removed handles are reused.
+    for (size_t i = 0; i < 100; ++i) {
+        tree.remove(handles[i]);
+    }
+    EXPECT_EQ(tree.size(), 400u);
+    const std::uint32_t reused = tree.insert(make_box(1000, 0.0f));
+    EXPECT_LT(reused, 100u);
+    handles.erase(handles.begin(), handles.begin() + 100);
+    handles.push_back(reused);
+
+    const aabb box{vector3{-20.0f, -10.0f, -30.0f}, vector3{25.0f, 40.0f, 5.0f}};
+    check(tree, handles, [&](auto& _result) { tree.query(box, _result); }, [&](const aabb& _bounds) { return box.overlaps(_bounds); });
+
+    const line ray{vector3{-80.0f, 1.0f, 2.0f}, vector3{1.0f, 0.1f, -0.05f}};
+    check(tree, handles, [&](auto& _result) { tree.query(ray, _result); }, [&](const aabb& _bounds) {
+        const auto range = _bounds.intersect(ray);
+        return range && range->second >= 0.0f;
+    });
+
+    // A box shaped frustum with inward facing normals.
+    const std::vector<plane> planes{plane{vector3{1.0f, 0.0f, 0.0f}, 30.0f}, plane{vector3{-1.0f, 0.0f, 0.0f}, 10.0f},
+                                    plane{vector3{0.0f, 1.0f, 0.0f}, 30.0f}, plane{vector3{0.0f, -1.0f, 0.0f}, 30.0f},
+                                    plane{vector3{0.0f, 0.0f, 1.0f}, 45.0f}, plane{vector3{0.0f, 0.0f, -1.0f}, 45.0f}};
+    check(tree, handles, [&](auto& _result) { tree.query(planes, _result); }, [&](const aabb& _bounds) {
+        return std::none_of(planes.begin(), planes.end(), [&](const plane& _plane) { return _bounds.is_behind(_plane); });
+    });
+
+    for (const std::uint32_t handle: handles) {
+        tree.remove(handle);
+    }
+    EXPECT_EQ(tree.size(), 0u);
+    std::vector<std::uint32_t> result;
+    tree.query(box, result);
+    EXPECT_TRUE(result.empty());
+}
@@ -0,0 +1,95 @@
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/packed_colour.h"
+
+using namespace mkr;
+
+TEST(packed_colour_test, conversion) {
+    EXPECT_EQ(colour_rgba8{colour::red()}, (colour_rgba8{255, 0, 0, 255}));
+    EXPECT_EQ(colour_rgba8{colour(0.5f, 0.25f, 1.0f / 255.0f, 0.0f)}, (colour_rgba8{128, 64, 1, 0}));
+    EXPECT_EQ(colour_rgba8{colour(0.5f / 255.0f, 1.5f / 255.0f, 2.5f / 255.0f, 0.0f)}, (colour_rgba8{0, 2, 2, 0})); // Ties round to even.
+    EXPECT_EQ(colour_rgba8{colour(-1.0f, 2.0f, std::numeric_limits<float>::quiet_NaN(), 1.0f)}, (colour_rgba8{0, 255, 0, 255}));
+
+    const colour_rgb10a2 packed{colour{1.0f, 0.5f, 0.0f, 2.0f / 3.0f}};
+    EXPECT_EQ(packed.r(), 1023u);
+    EXPECT_EQ(packed.g(), 512u);
+    EXPECT_EQ(packed.b(), 0u);
+    EXPECT_EQ(packed.a(), 2u);
+    EXPECT_EQ(packed, (colour_rgb10a2{1023, 512, 0, 2}));
+    EXPECT_EQ(colour_rgb10a2{colour(-1.0f, 2.0f, std::numeric_limits<float>::quiet_NaN(), 5.0f)}, (colour_rgb10a2{0, 1023, 0, 3}));
+
+    // Every value must survive a round trip through float.
+    for (std::uint32_t i = 0; i < 1024; ++i) {
+        const colour_rgba8 rgba8{static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(255 - i % 256), 0, static_cast<std::uint8_t>(i)};
+        EXPECT_EQ(colour_rgba8{rgba8.to_colour()}, rgba8);
+        const colour_rgb10a2 rgb10a2{i, 1023 - i, i / 2, i};
+        EXPECT_EQ(colour_rgb10a2{rgb10a2.to_colour()}, rgb10a2);
+    }
+    EXPECT_EQ((colour_rgba8{255, 0, 0, 255}).to_colour(), colour::red());
+    EXPECT_EQ((colour_rgb10a2{0, 1023, 0, 3}).to_colour(), colour::green());
+}
+
+TEST(packed_colour_test, batch) {
+    // A count which is not a multiple of the vector width, with values outside of [0, 1].
+    std::vector<colour> colours;
+    for (size_t i = 0; i < 1003; ++i) {
+        const float f = static_cast<float>(i) / 1000.0f;
+        colours.emplace_back(f, 1.0f - f, f * 1.2f - 0.1f, (i % 7) / 6.0f);
+    }
+    colours.emplace_back(std::numeric_limits<float>::quiet_NaN(), 0.5f, 0.5f, 0.0f);
+
+    // The batch conversions must give the same results as the scalar conversions.
+    std::vector<colour_rgba8> rgba8(colours.size());
+    std::vector<colour_rgb10a2> rgb10a2(colours.size());
+    std::vector<colour> rgba8_result(colours.size()), rgb10a2_result(colours.size());
+    packed_colour_util::pack(colours, rgba8);
+    packed_colour_util::pack(colours, rgb10a2);
+    packed_colour_util::unpack(rgba8, rgba8_result);
+    packed_colour_util::unpack(rgb10a2, rgb10a2_result);
+    for (size_t i = 0; i < colours.size(); ++i) {
+        EXPECT_EQ(rgba8[i], colour_rgba8{colours[i]});
+        EXPECT_EQ(rgb10a2[i], colour_rgb10a2{colours[i]});
+        EXPECT_EQ(rgba8_result[i], rgba8[i].to_colour());
+        EXPECT_EQ(rgb10a2_result[i], rgb10a2[i].to_colour());
+    }
+
+    // Premultiplying and unpremultiplying.
+    packed_colour_util::pack_premultiplied(colours, rgba8);
+    packed_colour_util::pack_premultiplied(colours, rgb10a2);
+    packed_colour_util::unpack_premultiplied(rgba8, rgba8_result);
+    packed_colour_util::unpack_premultiplied(rgb10a2, rgb10a2_result);
+    const auto saturate = [](float _value) { return (_value > 0.0f) ? ((_value < 1.0f) ? _value : 1.0f) : 0.0f; };
+    const auto expect_round_trip = [](const colour& _result, const colour& _expected, float _stored_alpha, float _max) {
+        EXPECT_EQ(_result.a_, _stored_alpha);
+        if (_stored_alpha == 0.0f) {
+            EXPECT_EQ(_result, colour(0.0f, 0.0f, 0.0f, 0.0f));
+            return;
+        }
+        // The premultiplied components are rounded, and the error is magnified by dividing by alpha.
+        const float tolerance = 0.5f / _max / _stored_alpha + 1e-6f;
+        EXPECT_NEAR(_result.r_, _expected.r_, tolerance);
+        EXPECT_NEAR(_result.g_, _expected.g_, tolerance);
+        EXPECT_NEAR(_result.b_, _expected.b_, tolerance);
+    };
+    for (size_t i = 0; i < colours.size(); ++i) {
+        const colour clamped{saturate(colours[i].r_), saturate(colours[i].g_), saturate(colours[i].b_), saturate(colours[i].a_)};
+        // RGB is multiplied by the alpha after it is rounded to the packed format.
+        const float a8 = colour_rgba8{clamped}.to_colour().a_;
+        const float a10 = colour_rgb10a2{clamped}.to_colour().a_;
+        EXPECT_EQ(rgba8[i], colour_rgba8(colour(clamped.r_ * a8, clamped.g_ * a8, clamped.b_ * a8, clamped.a_)));
+        EXPECT_EQ(rgb10a2[i], colour_rgb10a2(colour(clamped.r_ * a10, clamped.g_ * a10, clamped.b_ * a10, clamped.a_)));
+        expect_round_trip(rgba8_result[i], clamped, a8, 255.0f);
+        expect_round_trip(rgb10a2_result[i], clamped, a10, 1023.0f);
+    }
+
+    // A premultiplied colour must never have RGB greater than alpha.
+    const std::vector<colour> translucent{colour{1.0f, 1.0f, 1.0f, 0.5f}, colour{1.0f, 0.5f, 0.2f, 0.1f}};
+    std::vector<colour_rgb10a2> packed(translucent.size());
+    packed_colour_util::pack_premultiplied(translucent, packed);
+    EXPECT_EQ(packed[0], (colour_rgb10a2{682, 682, 682, 2}));
+    EXPECT_EQ(packed[1], (colour_rgb10a2{0, 0, 0, 0}));
+    std::vector<colour> unpacked(translucent.size());
+    packed_colour_util::unpack_premultiplied(packed, unpacked);
+    EXPECT_EQ(unpacked[0], colour(1.0f, 1.0f, 1.0f, 2.0f / 3.0f));
+}
@@ -0,0 +1,119 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/matrix_util.h"
+#include "maths/plane.h"
+#include "test_points.h"
+
+using namespace mkr;
+
+namespace {
+    bool test_bit(const std::vector<std::uint64_t>& _mask, size_t _index) {
+        return (_mask[_index / 64] >> (_index % 64)) & 1u;
+    }
+}
+
+TEST(plane_test, normalise) {
+    const plane p{vector3{0.0f, 3.0f, 4.0f}, 10.0f};
+    const plane unit = p.normalised();
+    EXPECT_NEAR(unit.normal_.length(), 1.0f, 1e-6f);
+    EXPECT_NEAR(unit.d_, 2.0f, 1e-6f);
+    EXPECT_TRUE(unit == p);
+
+    const vector3 point{1.0f, 2.0f, 3.0f};
+    EXPECT_NEAR(unit.signed_distance(point), p.distance_to(point), 1e-5f);
+}
+
+TEST(plane_test, distances) {
+    const std::vector<vector3> points = test_util::make_points(100, vector3{10.0f, 10.0f, 3.0f});
+    const std::vector<plane> planes{plane{vector3{0.0f, 3.0f, 4.0f}, 10.0f}, plane{vector3{-1.0f, 1.0f, 0.0f}, -2.0f}};
+
+    std::vector<float> result(planes.size() * points.size());
+    plane::distances(planes, points, result);
+    for (size_t i = 0; i < planes.size(); ++i) {
+        for (size_t j = 0; j < points.size(); ++j) {
+            EXPECT_NEAR(result[i * points.size() + j], planes[i].distance_to(points[j]), 1e-5f);
+        }
+    }
+}
+
+TEST(plane_test, classify) {
+    // 130 points, so that the last bitmask word is partly used.
+    std::vector<vector3> points = test_util::make_points(130, vector3{10.0f, 10.0f, 3.0f});
+    // Every 7th point lies on the xy plane.
+    for (size_t i = 3; i < points.size(); i += 7) {
+        points[i].z_ = 0.0f;
+    }
+    const std::vector<plane> planes{plane::xy_plane(), plane{vector3{1.0f, 1.0f, 0.0f}, 1.0f}};
+    const size_t words = plane::mask_size(points.size());
+    EXPECT_EQ(words, 3u);
+
+    std::vector<std::uint64_t> front(planes.size() * words), back(planes.size() * words);
+    plane::classify(planes, points, front, back, 0.001f);
+
+    for (size_t i = 0; i < planes.size(); ++i) {
+        const std::vector<std::uint64_t> plane_front(front.begin() + i * words, front.begin() + (i + 1) * words);
+        const std::vector<std::uint64_t> plane_back(back.begin() + i * words, back.begin() + (i + 1) * words);
+        for (size_t j = 0; j < points.size(); ++j) {
+            const float distance = planes[i].distance_to(points[j]);
+            EXPECT_EQ(test_bit(plane_front, j), distance > 0.001f);
+            EXPECT_EQ(test_bit(plane_back, j), distance < -0.001f);
+        }
+        // The unused bits of the last word are clear.
+        EXPECT_EQ(plane_front[2] >> 2, 0u);
+        EXPECT_EQ(plane_back[2] >> 2, 0u);
+    }
+
+    // Points with z == 0 lie on the xy plane.
+    for (size_t i = 3; i < points.size(); i += 7) {
+        EXPECT_FALSE(test_bit(front, i));
+        EXPECT_FALSE(test_bit(back, i));
+    }
+}
+
+TEST(plane_test, intersect_point) {
+    const plane a{vector3{1.0f, 0.0f, 0.0f}, -2.0f};
+    const plane b{vector3{0.0f, 2.0f, 0.0f}, 6.0f};
+    const plane c{vector3{1.0f, 1.0f, 1.0f}, vector3{0.0f, 0.0f, 5.0f}};
+    const auto point = a.intersect_point(b, c);
+    ASSERT_TRUE(point.has_value());
+    EXPECT_NEAR(point->x_, 2.0f, 1e-5f);
+    EXPECT_NEAR(point->y_, -3.0f, 1e-5f);
+    EXPECT_NEAR(point->z_, 6.0f, 1e-5f);
+
+    // Planes which meet along a line, or not at all.
+    EXPECT_FALSE(a.intersect_point(b, plane{vector3{1.0f, 1.0f, 0.0f}, 0.0f}).has_value());
+    EXPECT_FALSE(a.intersect_point(plane{vector3{2.0f, 0.0f, 0.0f}, 1.0f}, c).has_value());
+}
+
+TEST(plane_test, frustum_corners) {
+    // The corners of 3 cascades of a camera, compared with the corners of the unit cube transformed by the inverse view projection matrix.
+    const matrix4x4 view = matrix_util::view_matrix(vector3{1.0f, 2.0f, 3.0f}, vector3{0.3f, -0.2f, -1.0f}, vector3{0.0f, 1.0f, 0.0f});
+    const std::vector<std::pair<float, float>> cascades{{0.1f, 5.0f}, {5.0f, 20.0f}, {20.0f, 100.0f}};
+
+    std::vector<plane> planes;
+    std::vector<matrix4x4> inverses;
+    for (const auto& [near, far]: cascades) {
+        const matrix4x4 view_projection = matrix_util::perspective_matrix(16.0f / 9.0f, 1.0f, near, far) * view;
+        const std::array<plane, 6> frustum = matrix_util::frustum_planes(view_projection);
+        planes.insert(planes.end(), frustum.begin(), frustum.end());
+        inverses.push_back(*matrix_util::inverse_matrix(view_projection));
+    }
+
+    std::vector<vector3> corners(cascades.size() * 8);
+    plane::frustum_corners(planes, corners);
+    for (size_t i = 0; i < cascades.size(); ++i) {
+        for (size_t j = 0; j < 8; ++j) {
+            const vector3 expected = inverses[i] * vector3{(j & 1) ? 1.0f : -1.0f, (j & 2) ? 1.0f : -1.0f, (j & 4) ? 1.0f : -1.0f};
+            const vector3& corner = corners[i * 8 + j];
+            const float tolerance = 1e-4f * expected.length();
+            EXPECT_NEAR(corner.x_, expected.x_, tolerance);
+            EXPECT_NEAR(corner.y_, expected.y_, tolerance);
+            EXPECT_NEAR(corner.z_, expected.z_, tolerance);
+
+            // Each corner is on 3 of the planes, and inside the other 3.
+            for (size_t k = 0; k < 6; ++k) {
+                EXPECT_GE(planes[i * 6 + k].normalised().signed_distance(corner), -tolerance);
+            }
+        }
+    }
+}
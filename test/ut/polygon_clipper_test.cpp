@@ -0,0 +1,127 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/polygon_clipper.h"
+
+using namespace mkr;
+
+namespace {
+    float area(std::span<const vector3> _polygon) {
+        vector3 sum = vector3::zero();
+        for (size_t i = 2; i < _polygon.size(); ++i) {
+            sum += (_polygon[i - 1] - _polygon[0]).cross(_polygon[i] - _polygon[0]);
+        }
+        return sum.length() * 0.5f;
+    }
+
+    float area(const triangle& _triangle) {
+        return (_triangle.vertex_b_ - _triangle.vertex_a_).cross(_triangle.vertex_c_ - _triangle.vertex_a_).length() * 0.5f;
+    }
+
+    /// The planes of a box, with their normals pointing inwards.
+    std::vector<plane> box_planes(const vector3& _min, const vector3& _max) {
+        return {plane{vector3{1.0f, 0.0f, 0.0f}, -_min.x_}, plane{vector3{-1.0f, 0.0f, 0.0f}, _max.x_},
+                plane{vector3{0.0f, 1.0f, 0.0f}, -_min.y_}, plane{vector3{0.0f, -1.0f, 0.0f}, _max.y_},
+                plane{vector3{0.0f, 0.0f, 1.0f}, -_min.z_}, plane{vector3{0.0f, 0.0f, -1.0f}, _max.z_}};
+    }
+}
+
+TEST(polygon_clipper_test, polygon) {
+    const std::vector<vector3> square{vector3{0.0f, 0.0f, 0.0f}, vector3{1.0f, 0.0f, 0.0f}, vector3{1.0f, 1.0f, 0.0f}, vector3{0.0f, 1.0f, 0.0f}};
+
+    // Cutting a corner off adds a vertex.
+    const std::vector<plane> corner{plane{vector3{-2.0f, -2.0f, 0.0f}, 3.0f}};
+    polygon_clipper clipper{corner};
+    std::vector<vector3> result(clipper.max_vertices(square.size()));
+    size_t count = clipper.clip(square, result);
+    ASSERT_EQ(count, 5u);
+    EXPECT_NEAR(area(std::span<const vector3>{result}.first(count)), 1.0f - 0.125f, 1e-5f);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_GE(corner[0].normalised().signed_distance(result[i]), -1e-5f);
+    }
+
+    // Clipping against the planes of a box leaves a smaller square.
+    polygon_clipper box{box_planes(vector3{0.25f, -1.0f, -1.0f}, vector3{0.75f, 0.5f, 1.0f})};
+    result.resize(box.max_vertices(square.size()));
+    count = box.clip(square, result);
+    ASSERT_EQ(count, 4u);
+    EXPECT_NEAR(area(std::span<const vector3>{result}.first(count)), 0.25f, 1e-5f);
+
+    // A polygon completely inside is unchanged, and one completely outside is removed.
+    polygon_clipper outer{box_planes(vector3{-1.0f, -1.0f, -1.0f}, vector3{2.0f, 2.0f, 1.0f})};
+    result.resize(outer.max_vertices(square.size()));
+    ASSERT_EQ(outer.clip(square, result), 4u);
+    EXPECT_EQ(result[2], square[2]);
+    polygon_clipper away{box_planes(vector3{2.0f, -1.0f, -1.0f}, vector3{3.0f, 2.0f, 1.0f})};
+    result.resize(away.max_vertices(square.size()));
+    EXPECT_EQ(away.clip(square, result), 0u);
+}
+
+TEST(polygon_clipper_test, vertex_on_plane) {
+    // A vertex on the plane is kept once, and is not duplicated by the edges on either side of it.
+    const std::vector<vector3> triangle{vector3{0.0f, 0.0f, 0.0f}, vector3{-1.0f, 1.0f, 0.0f}, vector3{1.0f, 1.0f, 0.0f}};
+    const std::vector<plane> planes{plane{vector3{1.0f, 0.0f, 0.0f}, 0.0f}};
+    polygon_clipper clipper{planes};
+    std::vector<vector3> result(clipper.max_vertices(triangle.size()));
+    ASSERT_EQ(clipper.clip(triangle, result), 3u);
+    EXPECT_EQ(result[0], (vector3{0.0f, 0.0f, 0.0f}));
+    EXPECT_EQ(result[1], (vector3{0.0f, 1.0f, 0.0f}));
+    EXPECT_EQ(result[2], (vector3{1.0f, 1.0f, 0.0f}));
+
+    // A grid of triangles clipped by a box whose planes pass through the vertices of the grid.
+    std::vector<mkr::triangle> triangles;
+    for (int y = -3; y < 3; ++y) {
+        for (int x = -3; x < 3; ++x) {
+            const auto fx = static_cast<float>(x), fy = static_cast<float>(y);
+            triangles.emplace_back(vector3{fx, fy, 0.0f}, vector3{fx + 1.0f, fy, 0.0f}, vector3{fx + 1.0f, fy + 1.0f, 0.0f});
+            triangles.emplace_back(vector3{fx, fy, 0.0f}, vector3{fx + 1.0f, fy + 1.0f, 0.0f}, vector3{fx, fy + 1.0f, 0.0f});
+        }
+    }
+    polygon_clipper box{box_planes(vector3{-1.0f, -1.5f, -1.0f}, vector3{2.0f, 1.0f, 1.0f})};
+    std::vector<mkr::triangle> clipped(box.max_triangles(triangles.size()));
+    std::vector<std::uint32_t> sources(clipped.size());
+    const size_t count = box.clip(triangles, clipped, sources);
+    float total = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_GT(area(clipped[i]), 1e-3f);
+        total += area(clipped[i]);
+    }
+    EXPECT_NEAR(total, 3.0f * 2.5f, 1e-4f);
+}
+
+TEST(polygon_clipper_test, triangles) {
+    // A grid of triangles on the plane z = 0, clipped by a box.
+    std::vector<triangle> triangles;
+    for (int y = -5; y < 5; ++y) {
+        for (int x = -5; x < 5; ++x) {
+            const auto fx = static_cast<float>(x), fy = static_cast<float>(y);
+            triangles.emplace_back(vector3{fx, fy, 0.0f}, vector3{fx + 1.0f, fy, 0.0f}, vector3{fx + 1.0f, fy + 1.0f, 0.0f});
+            triangles.emplace_back(vector3{fx, fy, 0.0f}, vector3{fx + 1.0f, fy + 1.0f, 0.0f}, vector3{fx, fy + 1.0f, 0.0f});
+        }
+    }
+    const std::vector<plane> planes = box_planes(vector3{-1.3f, -0.7f, -1.0f}, vector3{2.1f, 1.9f, 1.0f});
+    polygon_clipper clipper{planes};
+    std::vector<triangle> result(clipper.max_triangles(triangles.size()));
+    std::vector<std::uint32_t> sources(result.size());
+    const size_t count = clipper.clip(triangles, result, sources);
+
+    float total = 0.0f;
+    std::vector<float> source_areas(triangles.size(), 0.0f);
+    for (size_t i = 0; i < count; ++i) {
+        total += area(result[i]);
+        source_areas[sources[i]] += area(result[i]);
+        for (const auto& p: planes) {
+            EXPECT_GE(p.signed_distance(result[i].vertex_a_), -1e-5f);
+            EXPECT_GE(p.signed_distance(result[i].vertex_b_), -1e-5f);
+            EXPECT_GE(p.signed_distance(result[i].vertex_c_), -1e-5f);
+        }
+    }
+    EXPECT_NEAR(total, 3.4f * 2.6f, 1e-4f);
+
+    // Each triangle gives the same area as clipping it on its own.
+    std::vector<vector3> polygon(clipper.max_vertices(3));
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        const vector3 vertices[3]{triangles[i].vertex_a_, triangles[i].vertex_b_, triangles[i].vertex_c_};
+        const size_t num_vertices = clipper.clip(vertices, polygon);
+        EXPECT_NEAR(source_areas[i], area(std::span<const vector3>{polygon}.first(num_vertices)), 1e-5f);
+    }
+}
@@ -0,0 +1,94 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/quaternion_soa.h"
+
+using namespace mkr;
+
+namespace {
+    // 19 quaternions, so that both the 8 wide kernels and the scalar tails are used.
+    std::vector<quaternion> make_quaternions(size_t _size, float _offset) {
+        std::vector<quaternion> quaternions;
+        for (size_t i = 0; i < _size; ++i) {
+            const auto f = static_cast<float>(i) + _offset;
+            quaternions.emplace_back(vector3{std::sin(f), std::cos(f * 0.7f), 0.5f}.normalised(), f * 0.3f);
+        }
+        return quaternions;
+    }
+
+    void expect_near(const quaternion& _a, const quaternion& _b, float _tolerance) {
+        EXPECT_NEAR(_a.w_, _b.w_, _tolerance);
+        EXPECT_NEAR(_a.x_, _b.x_, _tolerance);
+        EXPECT_NEAR(_a.y_, _b.y_, _tolerance);
+        EXPECT_NEAR(_a.z_, _b.z_, _tolerance);
+    }
+}
+
+TEST(quaternion_soa_test, construct) {
+    const std::vector<quaternion> quaternions = make_quaternions(19, 0.0f);
+    quaternion_soa soa{quaternions};
+    EXPECT_EQ(soa.size(), quaternions.size());
+
+    std::vector<quaternion> result(soa.size());
+    soa.to_quaternions(result);
+    for (size_t i = 0; i < quaternions.size(); ++i) {
+        expect_near(result[i], quaternions[i], 0.0f);
+    }
+
+    soa.resize(21);
+    expect_near(soa.get(20), quaternion::identity(), 0.0f);
+    expect_near(quaternion_soa{3}.get(2), quaternion::identity(), 0.0f);
+}
+
+TEST(quaternion_soa_test, multiply) {
+    const std::vector<quaternion> lhs = make_quaternions(19, 0.0f);
+    const std::vector<quaternion> rhs = make_quaternions(19, 5.0f);
+    quaternion_soa a{lhs}, b{rhs}, result;
+
+    quaternion_soa::multiply(a, b, result);
+    std::vector<float> dots(lhs.size());
+    quaternion_soa::dot(a, b, dots);
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        expect_near(result.get(i), lhs[i] * rhs[i], 1e-6f);
+        EXPECT_NEAR(dots[i], lhs[i].dot(rhs[i]), 1e-6f);
+    }
+
+    // The result may alias an operand.
+    quaternion_soa::multiply(a, b, a);
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        expect_near(a.get(i), lhs[i] * rhs[i], 1e-6f);
+    }
+}
+
+TEST(quaternion_soa_test, conjugate_normalise) {
+    const std::vector<quaternion> quaternions = make_quaternions(19, 0.0f);
+    quaternion_soa soa{quaternions};
+    soa.conjugate();
+    for (size_t i = 0; i < quaternions.size(); ++i) {
+        expect_near(soa.get(i), quaternions[i].conjugated(), 0.0f);
+        soa.set(i, quaternions[i] * 3.0f);
+    }
+    soa.set(9, quaternion{0.0f, 0.0f, 0.0f, 0.0f});
+    soa.set(18, quaternion{0.0f, 0.0f, 0.0f, 0.0f});
+
+    soa.normalise();
+    for (size_t i = 0; i < quaternions.size(); ++i) {
+        if (i == 9 || i == 18) {
+            expect_near(soa.get(i), quaternion{0.0f, 0.0f, 0.0f, 0.0f}, 0.0f);
+        } else {
+            expect_near(soa.get(i), quaternions[i], 1e-6f);
+        }
+    }
+}
+
+TEST(quaternion_soa_test, to_rotation_matrix) {
+    const std::vector<quaternion> quaternions = make_quaternions(19, 0.0f);
+    const quaternion_soa soa{quaternions};
+    std::vector<matrix4x4> result(soa.size());
+    soa.to_rotation_matrix(result);
+    for (size_t i = 0; i < quaternions.size(); ++i) {
+        const matrix4x4 expected = quaternions[i].to_rotation_matrix();
+        for (size_t j = 0; j < 16; ++j) {
+            EXPECT_NEAR(result[i][0][j], expected[0][j], 1e-6f);
+        }
+    }
+}
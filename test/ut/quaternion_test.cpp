@@ -117,4 +117,273 @@ TEST(quaternion_test, rotate) {
         EXPECT_TRUE((maths_util::pi - angle) < 0.0001f); // Hardcode a larger epsilon due to floating point error.
         EXPECT_TRUE(vector3::z_axis() == axis);
     }
-}
\ No newline at end of file
+}
+
+TEST(quaternion_test, rotate_point) {
+    {
+        const vector3 point{1.0f, 2.0f, 3.0f};
+        const quaternion q{vector3{1.0f, -2.0f, 0.5f}.normalised(), 73.0f * maths_util::deg2rad};
+        const quaternion p = q * quaternion{0.0f, point} * q.conjugated();
+        const vector3 expected = q.to_rotation_matrix() * point;
+        const vector3 result = quaternion::rotate(point, q);
+        EXPECT_NEAR(result.x_, p.x_, 0.0001f);
+        EXPECT_NEAR(result.y_, p.y_, 0.0001f);
+        EXPECT_NEAR(result.z_, p.z_, 0.0001f);
+        EXPECT_NEAR(result.x_, expected.x_, 0.0001f);
+        EXPECT_NEAR(result.y_, expected.y_, 0.0001f);
+        EXPECT_NEAR(result.z_, expected.z_, 0.0001f);
+    }
+
+    {
+        const vector3 result = quaternion::rotate(vector3::x_axis(), 90.0f * maths_util::deg2rad, vector3::z_axis());
+        EXPECT_TRUE(result == vector3::y_axis());
+    }
+
+    {
+        std::vector<float> x{1.0f, 0.0f, -3.0f, 4.0f, 0.5f, 1.0f, 2.0f, 3.0f, -1.0f};
+        std::vector<float> y{0.0f, 2.0f, 1.0f, -4.0f, 0.5f, 1.0f, 2.0f, 3.0f, -2.0f};
+        std::vector<float> z{0.0f, 0.0f, 7.0f, 4.0f, -0.5f, 1.0f, 2.0f, 3.0f, -3.0f};
+        std::vector<quaternion> rotations;
+        for (size_t i = 0; i < x.size(); ++i) {
+            rotations.emplace_back(vector3{1.0f, static_cast<float>(i), 2.0f}.normalised(), static_cast<float>(i) * 0.4f);
+        }
+
+        std::vector<float> x1 = x, y1 = y, z1 = z;
+        quaternion::rotate(x1, y1, z1, rotations[3]);
+        std::vector<float> xn = x, yn = y, zn = z;
+        quaternion::rotate(xn, yn, zn, rotations);
+        for (size_t i = 0; i < x.size(); ++i) {
+            const vector3 expected1 = quaternion::rotate(vector3{x[i], y[i], z[i]}, rotations[3]);
+            EXPECT_NEAR(expected1.x_, x1[i], 0.0001f);
+            EXPECT_NEAR(expected1.y_, y1[i], 0.0001f);
+            EXPECT_NEAR(expected1.z_, z1[i], 0.0001f);
+            const vector3 expectedn = quaternion::rotate(vector3{x[i], y[i], z[i]}, rotations[i]);
+            EXPECT_NEAR(expectedn.x_, xn[i], 0.0001f);
+            EXPECT_NEAR(expectedn.y_, yn[i], 0.0001f);
+            EXPECT_NEAR(expectedn.z_, zn[i], 0.0001f);
+        }
+    }
+}
+
+TEST(quaternion_test, interpolate) {
+    // Exact shortest path slerp in double precision, to measure the error of the approximations against.
+    auto reference_slerp = [](const quaternion& _start, const quaternion& _end, double _t) {
+        double dot = static_cast<double>(_start.dot(_end));
+        const double sign = dot < 0.0 ? -1.0 : 1.0;
+        dot = std::min(1.0, dot * sign);
+        const double theta = std::acos(dot);
+        const double sin_theta = std::sin(theta);
+        const double a = sin_theta < 1e-9 ? 1.0 - _t : std::sin((1.0 - _t) * theta) / sin_theta;
+        const double b = (sin_theta < 1e-9 ? _t : std::sin(_t * theta) / sin_theta) * sign;
+        return quaternion{static_cast<float>(a * _start.w_ + b * _end.w_),
+                          static_cast<float>(a * _start.x_ + b * _end.x_),
+                          static_cast<float>(a * _start.y_ + b * _end.y_),
+                          static_cast<float>(a * _start.z_ + b * _end.z_)};
+    };
+    auto max_error = [](const quaternion& _a, const quaternion& _b) {
+        return maths_util::max(std::fabs(_a.w_ - _b.w_), std::fabs(_a.x_ - _b.x_), std::fabs(_a.y_ - _b.y_), std::fabs(_a.z_ - _b.z_));
+    };
+
+    std::vector<quaternion> starts;
+    std::vector<quaternion> ends;
+    for (int i = 0; i < 64; ++i) {
+        const float f = static_cast<float>(i);
+        starts.emplace_back(vector3{std::sin(f), std::cos(f * 1.3f), 0.5f}.normalised(), f * 0.37f);
+        ends.emplace_back(vector3{std::cos(f * 0.7f), 1.0f, std::sin(f * 2.1f)}.normalised(), f * -0.91f + 1.0f);
+    }
+
+    float fast_slerp_error = 0.0f;
+    float slerp_error = 0.0f;
+    for (float t = 0.0f; t <= 1.0f; t += 0.125f) {
+        std::vector<quaternion> nlerp_result(starts.size());
+        std::vector<quaternion> fast_slerp_result(starts.size());
+        quaternion::nlerp(starts, ends, t, nlerp_result);
+        quaternion::fast_slerp(starts, ends, t, fast_slerp_result);
+
+        for (size_t i = 0; i < starts.size(); ++i) {
+            const quaternion expected = reference_slerp(starts[i], ends[i], t);
+            fast_slerp_error = maths_util::max(fast_slerp_error, max_error(expected, fast_slerp_result[i]));
+            EXPECT_TRUE(fast_slerp_result[i] == quaternion::fast_slerp(starts[i], ends[i], t));
+
+            // nlerp follows the same path as slerp, but not at the same speed.
+            EXPECT_NEAR(nlerp_result[i].length(), 1.0f, 1e-6f);
+            EXPECT_TRUE(nlerp_result[i] == quaternion::nlerp(starts[i], ends[i], t));
+            EXPECT_GT(std::fabs(nlerp_result[i].dot(expected)), 0.99f);
+
+            // The existing slerp does not take the shortest path, so only compare the rotations it is meant for.
+            if (starts[i].dot(ends[i]) > 0.0f) {
+                slerp_error = maths_util::max(slerp_error, max_error(expected, quaternion::slerp(starts[i], ends[i], t)));
+            }
+        }
+    }
+    EXPECT_LT(fast_slerp_error, 3e-5f);
+    EXPECT_LT(slerp_error, 1e-4f);
+
+    {
+        // Shortest path.
+        const quaternion start{vector3::y_axis(), 10.0f * maths_util::deg2rad};
+        const quaternion end = quaternion{vector3::y_axis(), 350.0f * maths_util::deg2rad} * -1.0f;
+        const quaternion expected{vector3::y_axis(), 0.0f};
+        EXPECT_LT(max_error(quaternion::fast_slerp(start, end, 0.5f), expected), 1e-6f);
+        EXPECT_LT(max_error(quaternion::nlerp(start, end, 0.5f), expected), 2e-6f);
+        EXPECT_TRUE(quaternion::nlerp(start, end, 0.0f) == start);
+        EXPECT_TRUE(quaternion::nlerp(start, end, 2.0f, true) == quaternion::nlerp(start, end, 1.0f));
+    }
+}
+
+TEST(quaternion_test, from_rotation_matrix) {
+    auto same_rotation = [](const quaternion& _a, const quaternion& _b) {
+        return std::fabs(std::fabs(_a.dot(_b)) - 1.0f) < 1e-5f;
+    };
+
+    std::vector<quaternion> rotations{
+            quaternion::identity(),
+            quaternion{vector3::x_axis(), maths_util::pi}, // Trace is -1, the x component is the largest.
+            quaternion{vector3::y_axis(), maths_util::pi},
+            quaternion{vector3::z_axis(), maths_util::pi},
+            quaternion{vector3{1.0f, 1.0f, 0.0f}.normalised(), 179.0f * maths_util::deg2rad},
+            quaternion{vector3{0.2f, -1.0f, 0.7f}.normalised(), 33.0f * maths_util::deg2rad},
+            quaternion{vector3{-3.0f, 1.0f, 2.0f}.normalised(), 250.0f * maths_util::deg2rad},
+    };
+
+    for (const auto& q: rotations) {
+        const matrix4x4 m4 = q.to_rotation_matrix();
+        EXPECT_TRUE(same_rotation(q, quaternion::from_rotation_matrix(m4)));
+
+        matrix3x3 m3;
+        for (size_t c = 0; c < 3; ++c) {
+            for (size_t r = 0; r < 3; ++r) { m3[c][r] = m4[c][r]; }
+        }
+        EXPECT_TRUE(same_rotation(q, quaternion::from_rotation_matrix(m3)));
+    }
+
+    {
+        const matrix4x4 m = matrix_util::rotation_matrix(vector3{10.0f, 20.0f, 30.0f} * maths_util::deg2rad);
+        EXPECT_TRUE(quaternion::from_rotation_matrix(m).to_rotation_matrix() == m);
+    }
+
+    {
+        std::vector<matrix4x4> matrices(rotations.size(), matrix4x4::zero());
+        std::vector<quaternion> result(rotations.size());
+        quaternion::to_rotation_matrix(rotations, matrices);
+        quaternion::from_rotation_matrix(matrices, result);
+        for (size_t i = 0; i < rotations.size(); ++i) {
+            EXPECT_TRUE(matrices[i] == rotations[i].to_rotation_matrix());
+            EXPECT_TRUE(same_rotation(rotations[i], result[i]));
+        }
+    }
+
+    {
+        // More than one block, with each of w, x, y and z being the largest component, and a partly used last block.
+        std::vector<quaternion> many;
+        for (size_t i = 0; i < 150; ++i) {
+            const auto f = static_cast<float>(i);
+            const vector3 axis = vector3{std::sin(f * 1.3f), std::cos(f * 0.7f), std::sin(f * 2.9f + 1.0f)}.normalised();
+            many.emplace_back(axis, f * 0.043f);
+        }
+        std::vector<matrix4x4> matrices(many.size(), matrix4x4::zero());
+        std::vector<quaternion> result(many.size());
+        quaternion::to_rotation_matrix(many, matrices);
+        quaternion::from_rotation_matrix(matrices, result);
+        for (size_t i = 0; i < many.size(); ++i) {
+            EXPECT_TRUE(matrices[i] == many[i].to_rotation_matrix());
+            const quaternion expected = quaternion::from_rotation_matrix(matrices[i]);
+            EXPECT_NEAR(result[i].w_, expected.w_, 1e-6f);
+            EXPECT_NEAR(result[i].x_, expected.x_, 1e-6f);
+            EXPECT_NEAR(result[i].y_, expected.y_, 1e-6f);
+            EXPECT_NEAR(result[i].z_, expected.z_, 1e-6f);
+        }
+    }
+}
+
+TEST(quaternion_test, integrate) {
+    const std::vector<vector3> angular_velocities{{0.0f, 2.0f, 0.0f}, {1.0f, -1.0f, 0.5f}, {0.0f, 0.0f, 0.0f}, {-3.0f, 0.0f, 4.0f}};
+    const quaternion initial{vector3{1.0f, 1.0f, 0.0f}.normalised(), 0.3f};
+    const float dt = 1.0f / 120.0f;
+    const int num_steps = 120;
+
+    std::vector<float> w(angular_velocities.size(), initial.w_), x(angular_velocities.size(), initial.x_);
+    std::vector<float> y(angular_velocities.size(), initial.y_), z(angular_velocities.size(), initial.z_);
+    std::vector<float> ew = w, ex = x, ey = y, ez = z;
+    std::vector<float> avx, avy, avz;
+    for (const auto& v: angular_velocities) {
+        avx.push_back(v.x_);
+        avy.push_back(v.y_);
+        avz.push_back(v.z_);
+    }
+
+    for (int step = 0; step < num_steps; ++step) {
+        quaternion::integrate(w, x, y, z, avx, avy, avz, dt, step % 4 == 3);
+        quaternion::integrate_exponential(ew, ex, ey, ez, avx, avy, avz, dt);
+    }
+
+    for (size_t i = 0; i < angular_velocities.size(); ++i) {
+        // For a constant angular velocity, the exact result is a rotation of |ω| * t around ω.
+        const float speed = angular_velocities[i].length();
+        const float time = dt * static_cast<float>(num_steps);
+        const quaternion delta = (speed > 0.0f) ? quaternion{angular_velocities[i] * (1.0f / speed), speed * time} : quaternion::identity();
+        const quaternion expected = delta * initial;
+
+        const quaternion exponential{ew[i], ex[i], ey[i], ez[i]};
+        EXPECT_NEAR(exponential.dot(expected), 1.0f, 1e-5f);
+        EXPECT_NEAR(exponential.length(), 1.0f, 1e-5f);
+
+        const quaternion first_order{w[i], x[i], y[i], z[i]};
+        EXPECT_NEAR(first_order.normalised().dot(expected), 1.0f, 1e-3f);
+        EXPECT_NEAR(first_order.length(), 1.0f, 1e-3f);
+    }
+
+    // Steps of up to a full turn.
+    for (const float angle: {0.0f, 1e-4f, 1.0f, 3.0f, 5.0f, 2.0f * maths_util::pi}) {
+        std::vector<float> sw{initial.w_}, sx{initial.x_}, sy{initial.y_}, sz{initial.z_};
+        const vector3 axis = vector3{2.0f, -1.0f, 3.0f}.normalised();
+        const std::vector<float> vx{axis.x_ * angle}, vy{axis.y_ * angle}, vz{axis.z_ * angle};
+        quaternion::integrate_exponential(sw, sx, sy, sz, vx, vy, vz, 1.0f);
+        const quaternion expected = quaternion{axis, angle} * initial;
+        EXPECT_NEAR(sw[0], expected.w_, 1e-6f);
+        EXPECT_NEAR(sx[0], expected.x_, 1e-6f);
+        EXPECT_NEAR(sy[0], expected.y_, 1e-6f);
+        EXPECT_NEAR(sz[0], expected.z_, 1e-6f);
+    }
+}
+
+TEST(quaternion_test, euler_angles) {
+    auto expect_near = [](const matrix4x4& _a, const matrix4x4& _b) {
+        for (size_t i = 0; i < matrix4x4::size(); ++i) { EXPECT_NEAR(_a[0][i], _b[0][i], 0.0001f); }
+    };
+
+    const std::vector<vector3> euler_angles{
+            vector3{0.0f, 0.0f, 0.0f},
+            vector3{45.0f, 0.0f, 0.0f} * maths_util::deg2rad,
+            vector3{0.0f, 120.0f, 0.0f} * maths_util::deg2rad,
+            vector3{0.0f, 0.0f, -70.0f} * maths_util::deg2rad,
+            vector3{123.0f, 456.0f, 789.0f} * maths_util::deg2rad,
+            vector3{10.0f, 20.0f, 30.0f} * maths_util::deg2rad,
+            vector3{-170.0f, -80.0f, 175.0f} * maths_util::deg2rad,
+            vector3{30.0f, 90.0f, 0.0f} * maths_util::deg2rad, // Gimbal lock.
+            vector3{30.0f, -90.0f, 0.0f} * maths_util::deg2rad, // Gimbal lock.
+    };
+
+    std::vector<quaternion> rotations(euler_angles.size());
+    std::vector<vector3> result(euler_angles.size());
+    quaternion::from_euler_angles(euler_angles, rotations);
+    quaternion::to_euler_angles(rotations, result);
+
+    for (size_t i = 0; i < euler_angles.size(); ++i) {
+        const matrix4x4 expected = matrix_util::rotation_matrix(euler_angles[i]);
+        EXPECT_TRUE(rotations[i] == quaternion::from_euler_angles(euler_angles[i]));
+        expect_near(rotations[i].to_rotation_matrix(), expected);
+
+        // The euler angles are not unique, but they must give back the same rotation.
+        EXPECT_TRUE(result[i] == rotations[i].to_euler_angles());
+        expect_near(matrix_util::rotation_matrix(result[i]), expected);
+    }
+
+    {
+        const vector3 angles = vector3{10.0f, 20.0f, 30.0f} * maths_util::deg2rad;
+        const vector3 result_angles = quaternion::from_euler_angles(angles).to_euler_angles();
+        EXPECT_NEAR(result_angles.x_, angles.x_, 0.0001f);
+        EXPECT_NEAR(result_angles.y_, angles.y_, 0.0001f);
+        EXPECT_NEAR(result_angles.z_, angles.z_, 0.0001f);
+    }
+}
@@ -0,0 +1,85 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/rotation_track.h"
+
+using namespace mkr;
+
+namespace {
+    std::vector<quaternion> make_keys(size_t _num_keys, const vector3& _axis, float _angle_per_key) {
+        std::vector<quaternion> keys;
+        for (size_t i = 0; i < _num_keys; ++i) {
+            keys.emplace_back(_axis.normalised(), static_cast<float>(i) * _angle_per_key);
+        }
+        return keys;
+    }
+
+    bool same_rotation(const quaternion& _a, const quaternion& _b, float _tolerance) {
+        return std::fabs(std::fabs(_a.dot(_b)) - 1.0f) < _tolerance;
+    }
+}
+
+TEST(rotation_track_test, encode) {
+    // A full turn, so the largest component changes, and the stored keys change hemisphere.
+    const std::vector<quaternion> keys = make_keys(41, vector3{1.0f, 2.0f, 3.0f}, 9.0f * maths_util::deg2rad);
+
+    const rotation_track track48{keys, 30.0f, rotation_encoding::smallest_three_48};
+    const rotation_track track32{keys, 30.0f, rotation_encoding::smallest_three_32};
+    EXPECT_EQ(track48.num_keys(), keys.size());
+    EXPECT_LT(track48.size_in_bytes(), keys.size() * sizeof(quaternion) / 2);
+    EXPECT_LT(track32.size_in_bytes(), track48.size_in_bytes());
+    EXPECT_NEAR(track48.duration(), 40.0f / 30.0f, 0.0001f);
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_TRUE(same_rotation(track48.key(i), keys[i], 1e-6f));
+        EXPECT_TRUE(same_rotation(track32.key(i), keys[i], 1e-5f));
+        EXPECT_NEAR(track48.key(i).length(), 1.0f, 1e-6f);
+    }
+}
+
+TEST(rotation_track_test, sample) {
+    const std::vector<rotation_track> tracks{
+            rotation_track{make_keys(11, vector3::y_axis(), 10.0f * maths_util::deg2rad), 10.0f},
+            rotation_track{make_keys(5, vector3{1.0f, 0.0f, 1.0f}, -30.0f * maths_util::deg2rad), 4.0f},
+            rotation_track{make_keys(1, vector3::x_axis(), 0.0f), 30.0f},
+    };
+
+    for (float time: {-1.0f, 0.0f, 0.25f, 0.33f, 0.5f, 0.95f, 1.0f, 2.0f}) {
+        std::vector<quaternion> pose(tracks.size());
+        rotation_track::sample_pose(tracks, time, pose);
+
+        const float clamped_time = maths_util::clamp(time, 0.0f, 1.0f);
+        const quaternion expected0{vector3::y_axis(), clamped_time * 100.0f * maths_util::deg2rad};
+        const quaternion expected1{vector3{1.0f, 0.0f, 1.0f}.normalised(), clamped_time * -120.0f * maths_util::deg2rad};
+        EXPECT_TRUE(same_rotation(pose[0], expected0, 1e-5f));
+        EXPECT_TRUE(same_rotation(pose[1], expected1, 1e-3f)); // Large steps between keys, so nlerp is less accurate.
+        EXPECT_TRUE(same_rotation(pose[2], quaternion::identity(), 1e-6f));
+
+        for (size_t i = 0; i < tracks.size(); ++i) {
+            EXPECT_TRUE(same_rotation(pose[i], tracks[i].sample(time), 1e-6f));
+        }
+    }
+}
+
+TEST(rotation_track_test, sample_pose_batches) {
+    // More than one batch, with both encodings mixed, and each component being the largest in some keys.
+    std::vector<rotation_track> tracks;
+    for (size_t i = 0; i < 150; ++i) {
+        const auto f = static_cast<float>(i);
+        const vector3 axis{std::sin(f * 1.3f), std::cos(f * 0.7f), std::sin(f * 2.9f + 1.0f)};
+        const rotation_encoding encoding = (i % 3 == 0) ? rotation_encoding::smallest_three_32 : rotation_encoding::smallest_three_48;
+        tracks.emplace_back(make_keys(9, axis, (20.0f + f) * maths_util::deg2rad), 8.0f, encoding);
+    }
+
+    // At the time of a key, the pose is the decoded key.
+    std::vector<quaternion> pose(tracks.size());
+    for (size_t k = 0; k < 9; ++k) {
+        rotation_track::sample_pose(tracks, static_cast<float>(k) / 8.0f, pose);
+        for (size_t i = 0; i < tracks.size(); ++i) {
+            const quaternion expected = tracks[i].key(k).normalised();
+            EXPECT_NEAR(pose[i].w_, expected.w_, 1e-6f);
+            EXPECT_NEAR(pose[i].x_, expected.x_, 1e-6f);
+            EXPECT_NEAR(pose[i].y_, expected.y_, 1e-6f);
+            EXPECT_NEAR(pose[i].z_, expected.z_, 1e-6f);
+        }
+    }
+}
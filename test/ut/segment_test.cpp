@@ -0,0 +1,60 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/segment.h"
+
+using namespace mkr;
+
+namespace {
+    // Brute force search for the closest points.
+    float brute_force_distance_squared(const segment& _a, const segment& _b) {
+        float best = std::numeric_limits<float>::max();
+        for (size_t i = 0; i <= 200; ++i) {
+            const vector3 point = _a.point_at(static_cast<float>(i) / 200.0f);
+            best = maths_util::min(best, (_b.closest_point(point) - point).length_squared());
+        }
+        return best;
+    }
+}
+
+TEST(segment_test, closest_point) {
+    const segment s{vector3{0.0f, 0.0f, 0.0f}, vector3{2.0f, 0.0f, 0.0f}};
+    EXPECT_FLOAT_EQ(s.length(), 2.0f);
+    EXPECT_EQ(s.closest_point(vector3{1.0f, 3.0f, 0.0f}), (vector3{1.0f, 0.0f, 0.0f}));
+    EXPECT_EQ(s.closest_point(vector3{-1.0f, 3.0f, 0.0f}), (vector3{0.0f, 0.0f, 0.0f}));
+    EXPECT_EQ(s.closest_point(vector3{5.0f, 3.0f, 0.0f}), (vector3{2.0f, 0.0f, 0.0f}));
+    EXPECT_EQ(segment{}.closest_point(vector3{1.0f, 1.0f, 1.0f}), vector3::zero());
+}
+
+TEST(segment_test, closest_points) {
+    const segment s{vector3{0.0f, 0.0f, 0.0f}, vector3{2.0f, 0.0f, 0.0f}};
+    const auto crossing = s.closest_points(segment{vector3{1.0f, 1.0f, -1.0f}, vector3{1.0f, 1.0f, 1.0f}});
+    EXPECT_EQ(crossing.first, (vector3{1.0f, 0.0f, 0.0f}));
+    EXPECT_EQ(crossing.second, (vector3{1.0f, 1.0f, 0.0f}));
+
+    // The closest points are at the ends.
+    const auto ends = s.closest_points(segment{vector3{3.0f, 1.0f, 0.0f}, vector3{5.0f, 2.0f, 0.0f}});
+    EXPECT_EQ(ends.first, (vector3{2.0f, 0.0f, 0.0f}));
+    EXPECT_EQ(ends.second, (vector3{3.0f, 1.0f, 0.0f}));
+
+    // Many segments, including parallel and degenerate segments.
+    const segment a{vector3{1.0f, 2.0f, 3.0f}, vector3{2.0f, -1.0f, 4.0f}};
+    std::vector<segment> segments;
+    for (size_t i = 0; i < 70; ++i) {
+        const auto f = static_cast<float>(i);
+        const vector3 start{std::sin(f) * 3.0f, f * 0.1f, std::cos(f * 3.0f) * 3.0f};
+        segments.emplace_back(start, start + vector3{std::cos(f), 1.0f, std::sin(f * 0.5f)} * 2.0f);
+    }
+    segments.emplace_back(vector3{0.0f, 0.0f, 0.0f}, vector3{1.0f, -3.0f, 1.0f});
+    segments.emplace_back(vector3{5.0f, 5.0f, 5.0f}, vector3{5.0f, 5.0f, 5.0f});
+
+    std::vector<float> s_values(segments.size()), t_values(segments.size()), distance_squared(segments.size());
+    a.closest_points(segments, s_values, t_values, distance_squared);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        EXPECT_GE(s_values[i], 0.0f);
+        EXPECT_LE(s_values[i], 1.0f);
+        EXPECT_GE(t_values[i], 0.0f);
+        EXPECT_LE(t_values[i], 1.0f);
+        EXPECT_NEAR(distance_squared[i], (segments[i].point_at(t_values[i]) - a.point_at(s_values[i])).length_squared(), 1e-4f);
+        EXPECT_LE(distance_squared[i], brute_force_distance_squared(a, segments[i]) + 1e-4f);
+    }
+}
@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/spatial_hash_grid.h"
+#include "test_points.h"
+
+using namespace mkr;
+
+namespace {
+    std::vector<std::uint32_t> brute_force(const std::vector<vector3>& _points, const vector3& _centre, float _radius) {
+        std::vector<std::uint32_t> result;
+        for (size_t i = 0; i < _points.size(); ++i) {
+            if ((_points[i] - _centre).length_squared() <= _radius * _radius) { result.push_back(static_cast<std::uint32_t>(i)); }
+        }
+        return result;
+    }
+}
+
+TEST(spatial_hash_grid_test, query) {
+    spatial_hash_grid grid{1.0f};
+    std::vector<std::uint32_t> result;
+    grid.query(vector3::zero(), 1.0f, result);
+    EXPECT_TRUE(result.empty());
+
+    // Rebuild with different point sets, including one large enough to be built in parallel.
+    for (size_t size: {10u, 1000u, 200000u, 500u}) {
+        const std::vector<vector3> points = test_util::make_points(size, vector3{20.0f, 20.0f, 20.0f});
+        grid.build(points);
+        EXPECT_EQ(grid.size(), size);
+
+        // Radii smaller than a cell, and radii covering too many cells to track the searched buckets.
+        for (float radius: {0.5f, 1.0f, 2.5f, 6.0f}) {
+            for (size_t i = 0; i < 5; ++i) {
+                const vector3 centre = points[i * size / 5];
+                result.clear();
+                grid.query(centre, radius, result);
+                std::sort(result.begin(), result.end());
+                EXPECT_EQ(result, brute_force(points, centre, radius));
+            }
+        }
+    }
+
+    // A radius covering more cells than there are buckets, and coordinates too far away to be a cell in an int32.
+    const std::vector<vector3> points = test_util::make_points(500, vector3{20.0f, 20.0f, 20.0f});
+    grid.build(points);
+    result.clear();
+    grid.query(vector3::zero(), 1e30f, result);
+    std::sort(result.begin(), result.end());
+    EXPECT_EQ(result, brute_force(points, vector3::zero(), 1e30f));
+    result.clear();
+    grid.query(vector3{1e20f, -1e20f, 0.0f}, 1.0f, result);
+    EXPECT_TRUE(result.empty());
+
+    spatial_hash_grid small_cells{1e-30f};
+    small_cells.build(points);
+    result.clear();
+    small_cells.query(points[7], 0.5f, result);
+    std::sort(result.begin(), result.end());
+    EXPECT_EQ(result, brute_force(points, points[7], 0.5f));
+}
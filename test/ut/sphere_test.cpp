@@ -0,0 +1,61 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/sphere.h"
+#include "test_points.h"
+
+using namespace mkr;
+
+namespace {
+    bool contains_all(const sphere& _sphere, const std::vector<vector3>& _points) {
+        for (const auto& point: _points) {
+            if (!_sphere.contains(point)) { return false; }
+        }
+        return true;
+    }
+}
+
+TEST(sphere_test, from_points) {
+    const std::vector<vector3> points = test_util::make_points(1000, vector3{3.0f, 2.0f, 5.0f}, vector3{1.0f, -4.0f, 0.0f});
+    const sphere ritter = sphere::from_points_ritter(points);
+    const sphere welzl = sphere::from_points_welzl(points);
+    EXPECT_TRUE(contains_all(ritter, points));
+    EXPECT_TRUE(contains_all(welzl, points));
+    EXPECT_LE(welzl.radius_, ritter.radius_);
+    EXPECT_LE(ritter.radius_, welzl.radius_ * 1.25f);
+
+    // The corners of a cube.
+    std::vector<vector3> cube;
+    for (size_t i = 0; i < 8; ++i) {
+        cube.emplace_back((i & 1) ? 1.0f : -1.0f, (i & 2) ? 3.0f : 1.0f, (i & 4) ? 1.0f : -1.0f);
+    }
+    const sphere cube_sphere = sphere::from_points_welzl(cube);
+    EXPECT_NEAR(cube_sphere.radius_, std::sqrt(3.0f), 1e-4f);
+    EXPECT_NEAR(cube_sphere.centre_.y_, 2.0f, 1e-4f);
+    EXPECT_TRUE(contains_all(cube_sphere, cube));
+
+    // Points on a line and on a plane.
+    const std::vector<vector3> collinear{vector3{0.0f, 0.0f, 0.0f}, vector3{1.0f, 1.0f, 1.0f}, vector3{3.0f, 3.0f, 3.0f}, vector3{2.0f, 2.0f, 2.0f}};
+    EXPECT_NEAR(sphere::from_points_welzl(collinear).radius_, std::sqrt(27.0f) * 0.5f, 1e-4f);
+    const std::vector<vector3> square{vector3{1.0f, 0.0f, 1.0f}, vector3{-1.0f, 0.0f, 1.0f}, vector3{1.0f, 0.0f, -1.0f}, vector3{-1.0f, 0.0f, -1.0f}};
+    EXPECT_NEAR(sphere::from_points_welzl(square).radius_, std::sqrt(2.0f), 1e-4f);
+    EXPECT_NEAR(sphere::from_points_ritter(std::span<const vector3>{square}.first(1)).radius_, 0.0f, 1e-6f);
+}
+
+TEST(sphere_test, intersect) {
+    const sphere s{vector3{1.0f, 2.0f, 3.0f}, 2.0f};
+    EXPECT_TRUE(s.contains(vector3{1.0f, 4.0f, 3.0f}));
+    EXPECT_FALSE(s.contains(vector3{1.0f, 4.1f, 3.0f}));
+    EXPECT_TRUE(s.overlaps(sphere{vector3{4.0f, 2.0f, 3.0f}, 1.0f}));
+    EXPECT_FALSE(s.overlaps(sphere{vector3{4.1f, 2.0f, 3.0f}, 1.0f}));
+
+    EXPECT_TRUE(s.intersects(plane{vector3{0.0f, 1.0f, 0.0f}, vector3{0.0f, 3.5f, 0.0f}}));
+    EXPECT_FALSE(s.intersects(plane{vector3{0.0f, 2.0f, 0.0f}, vector3{0.0f, 4.5f, 0.0f}}));
+    EXPECT_TRUE(s.is_behind(plane{vector3{0.0f, 2.0f, 0.0f}, vector3{0.0f, 4.5f, 0.0f}}));
+    EXPECT_FALSE(s.is_behind(plane{vector3{0.0f, -2.0f, 0.0f}, vector3{0.0f, 4.5f, 0.0f}}));
+
+    const auto range = s.intersect(line{vector3{-5.0f, 2.0f, 3.0f}, vector3{2.0f, 0.0f, 0.0f}});
+    ASSERT_TRUE(range.has_value());
+    EXPECT_NEAR(range->first, 2.0f, 1e-6f);
+    EXPECT_NEAR(range->second, 4.0f, 1e-6f);
+    EXPECT_FALSE(s.intersect(line{vector3{-5.0f, 4.5f, 3.0f}, vector3{1.0f, 0.0f, 0.0f}}).has_value());
+}
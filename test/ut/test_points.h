@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include "maths/vector3.h"
+
+namespace mkr::test_util {
+    /**
+     * Returns a point for an index, with each component in [-1, 1]. The points are scattered by a sine hash, so they
+     * are the same on every run, but show no pattern along any axis.
+     * @param _index The index of the point.
+     * @return The point.
+     */
+    inline vector3 scattered_point(size_t _index) {
+        const auto f = static_cast<float>(_index);
+        return vector3{std::sin(f * 12.9898f), std::sin(f * 78.233f), std::sin(f * 37.719f)};
+    }
+
+    /**
+     * Returns scattered points in a box.
+     * @param _size The number of points.
+     * @param _half_extents The half extents of the box.
+     * @param _centre The centre of the box.
+     * @return The points.
+     */
+    inline std::vector<vector3> make_points(size_t _size, const vector3& _half_extents = vector3{1.0f, 1.0f, 1.0f},
+                                            const vector3& _centre = vector3::zero()) {
+        std::vector<vector3> points;
+        points.reserve(_size);
+        for (size_t i = 0; i < _size; ++i) {
+            const vector3 p = scattered_point(i);
+            points.emplace_back(p.x_ * _half_extents.x_ + _centre.x_, p.y_ * _half_extents.y_ + _centre.y_, p.z_ * _half_extents.z_ + _centre.z_);
+        }
+        return points;
+    }
+}
@@ -0,0 +1,105 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "maths/triangle.h"
+
+using namespace mkr;
+
+namespace {
+    std::vector<triangle> make_triangles() {
+        return {
+                triangle{vector3{0.0f, 0.0f, 5.0f}, vector3{1.0f, 0.0f, 5.0f}, vector3{0.0f, 1.0f, 5.0f}},
+                triangle{vector3{-1.0f, -1.0f, 2.0f}, vector3{1.0f, -1.0f, 2.0f}, vector3{0.0f, 1.0f, 3.0f}},
+                triangle{vector3{0.5f, 0.5f, -2.0f}, vector3{0.0f, 2.0f, -2.0f}, vector3{2.0f, 0.0f, -2.0f}}, // Behind the line.
+                triangle{vector3{5.0f, 5.0f, 1.0f}, vector3{6.0f, 5.0f, 1.0f}, vector3{5.0f, 6.0f, 1.0f}}, // Missed.
+                triangle{vector3{0.0f, 0.0f, 1.0f}, vector3{1.0f, 0.0f, 1.0f}, vector3{2.0f, 0.0f, 1.0f}}, // Degenerate.
+                triangle{vector3{0.0f, -1.0f, 0.0f}, vector3{0.0f, 1.0f, 0.0f}, vector3{0.0f, 0.0f, 10.0f}}, // Parallel.
+                triangle{vector3{-4.0f, -4.0f, 7.0f}, vector3{4.0f, -4.0f, 9.0f}, vector3{0.0f, 4.0f, 8.0f}},
+        };
+    }
+}
+
+TEST(triangle_test, intersect) {
+    const line ray{vector3{0.25f, 0.25f, 0.0f}, vector3{0.0f, 0.0f, 2.0f}};
+    const triangle t = make_triangles()[0];
+    const std::optional<triangle_hit> hit = t.intersect(ray);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_NEAR(hit->distance_, 2.5f, 1e-6f);
+    EXPECT_NEAR(hit->u_, 0.25f, 1e-6f);
+    EXPECT_NEAR(hit->v_, 0.25f, 1e-6f);
+
+    // The hit matches the plane intersection.
+    const vector3 point = t.point_at(hit->u_, hit->v_);
+    const vector3 expected = t.to_plane().intersect_point(ray).value();
+    EXPECT_NEAR(point.x_, expected.x_, 1e-6f);
+    EXPECT_NEAR(point.y_, expected.y_, 1e-6f);
+    EXPECT_NEAR(point.z_, expected.z_, 1e-6f);
+
+    const std::vector<triangle> triangles = make_triangles();
+    EXPECT_FALSE(triangles[2].intersect(ray).has_value());
+    EXPECT_FALSE(triangles[3].intersect(ray).has_value());
+    EXPECT_FALSE(triangles[4].intersect(ray).has_value());
+    EXPECT_FALSE(triangles[5].intersect(ray).has_value());
+}
+
+TEST(triangle_test, triangle_packet) {
+    const line ray{vector3{0.25f, 0.25f, 0.0f}, vector3{0.0f, 0.0f, 1.0f}};
+    const std::vector<triangle> triangles = make_triangles();
+    const triangle_packet<8> packet8{triangles};
+    const triangle_packet<4> packet4{std::span<const triangle>{triangles}.first(4)};
+    const triangle_hits<8> hits8 = packet8.intersect(ray);
+    const triangle_hits<4> hits4 = packet4.intersect(ray);
+
+    // Only the first triangles of each packet match, the 8th triangle of packet8 is padding.
+    EXPECT_EQ(hits8.mask_, 0b01000011u);
+    EXPECT_EQ(hits4.mask_, 0b0011u);
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        const std::optional<triangle_hit> hit = triangles[i].intersect(ray);
+        EXPECT_EQ(hit.has_value(), ((hits8.mask_ >> i) & 1u) != 0);
+        if (hit) {
+            EXPECT_NEAR(hits8.distance_[i], hit->distance_, 1e-5f);
+            EXPECT_NEAR(hits8.u_[i], hit->u_, 1e-5f);
+            EXPECT_NEAR(hits8.v_[i], hit->v_, 1e-5f);
+        }
+    }
+}
+
+TEST(triangle_test, line_packet) {
+    const triangle t{vector3{-1.0f, -1.0f, 2.0f}, vector3{1.0f, -1.0f, 2.0f}, vector3{0.0f, 1.0f, 3.0f}};
+    std::vector<line> lines;
+    for (size_t i = 0; i < 8; ++i) {
+        const float f = static_cast<float>(i) * 0.25f - 1.0f;
+        lines.emplace_back(vector3{f, f * 0.5f, 0.0f}, vector3{0.0f, 0.1f, 1.0f});
+    }
+    const triangle_hits<8> hits = t.intersect(line_packet<8>{lines});
+    EXPECT_NE(hits.mask_, 0u);
+    EXPECT_NE(hits.mask_, 0xFFu);
+    for (size_t i = 0; i < lines.size(); ++i) {
+        const std::optional<triangle_hit> hit = t.intersect(lines[i]);
+        EXPECT_EQ(hit.has_value(), ((hits.mask_ >> i) & 1u) != 0);
+        if (hit) {
+            EXPECT_NEAR(hits.distance_[i], hit->distance_, 1e-5f);
+            EXPECT_NEAR(hits.u_[i], hit->u_, 1e-5f);
+            EXPECT_NEAR(hits.v_[i], hit->v_, 1e-5f);
+        }
+    }
+}
+
+TEST(triangle_test, small_triangle) {
+    // det scales with the size of the triangle, so it must not be compared with a fixed epsilon.
+    const float size = 1e-4f;
+    const triangle t{vector3{0.0f, 0.0f, 1.0f}, vector3{size, 0.0f, 1.0f}, vector3{0.0f, size, 1.0f}};
+    const line ray{vector3{size / 3.0f, size / 3.0f, 0.0f}, vector3{0.0f, 0.0f, 1.0f}};
+    const std::optional<triangle_hit> hit = t.intersect(ray);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_NEAR(hit->distance_, 1.0f, 1e-6f);
+    EXPECT_NEAR(hit->u_, 1.0f / 3.0f, 1e-4f);
+    EXPECT_NEAR(hit->v_, 1.0f / 3.0f, 1e-4f);
+
+    const std::vector<triangle> triangles{t, t, t, t};
+    EXPECT_EQ(triangle_packet<4>{triangles}.intersect(ray).mask_, 0b1111u);
+    EXPECT_EQ(t.intersect(line_packet<4>{std::vector<line>{ray, ray, ray, ray}}).mask_, 0b1111u);
+
+    // A small degenerate triangle is still rejected.
+    const triangle degenerate{vector3{0.0f, 0.0f, 1.0f}, vector3{size, 0.0f, 1.0f}, vector3{2.0f * size, 0.0f, 1.0f}};
+    EXPECT_FALSE(degenerate.intersect(ray).has_value());
+}